@@ -0,0 +1,187 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+
+#include <glib.h>
+
+#include "alert.h"
+
+/* A running command. Outlives the alert if the alert is freed first. */
+struct t_child {
+    SystemloadAlert *alert;
+};
+
+struct _SystemloadAlert {
+    bool      active;
+    gint64    above_since;  /* 0 if the value is below the threshold */
+    gint64    last_run;     /* 0 if the command has never been run */
+    t_child  *child;        /* NULL if no command is running */
+};
+
+
+
+SystemloadAlert *
+systemload_alert_new (void)
+{
+    return g_new0 (SystemloadAlert, 1);
+}
+
+void
+systemload_alert_free (SystemloadAlert *alert)
+{
+    if (alert == NULL)
+        return;
+
+    if (alert->child)
+        alert->child->alert = NULL;
+    g_free (alert);
+}
+
+bool
+systemload_alert_is_active (const SystemloadAlert *alert)
+{
+    return alert->active;
+}
+
+SystemloadAlertTransition
+systemload_alert_evaluate (SystemloadAlert *alert, const SystemloadAlertRule *rule, gulong value, gint64 time)
+{
+    if (rule->threshold == 0)
+    {
+        alert->above_since = 0;
+        if (alert->active)
+        {
+            alert->active = false;
+            return ALERT_CLEARED;
+        }
+        return ALERT_UNCHANGED;
+    }
+
+    if (alert->active)
+    {
+        if (value + rule->hysteresis < rule->threshold)
+        {
+            alert->active = false;
+            alert->above_since = 0;
+            return ALERT_CLEARED;
+        }
+    }
+    else if (value >= rule->threshold)
+    {
+        if (alert->above_since == 0)
+            alert->above_since = time;
+        if (time - alert->above_since >= (gint64) rule->hold * G_USEC_PER_SEC)
+        {
+            alert->active = true;
+            return ALERT_RAISED;
+        }
+    }
+    else
+    {
+        alert->above_since = 0;
+    }
+
+    return ALERT_UNCHANGED;
+}
+
+
+
+static void
+child_exited_cb (GPid pid, gint status, gpointer user_data)
+{
+    auto child = (t_child*) user_data;
+
+    if (child->alert)
+        child->alert->child = NULL;
+    g_spawn_close_pid (pid);
+    g_free (child);
+}
+
+static gchar *
+expand_command (const gchar *command, const gchar *monitor_name, gulong value)
+{
+    GString *s = g_string_sized_new (strlen (command) + 16);
+
+    for (const gchar *c = command; *c; c++)
+    {
+        if (c[0] == '%' && c[1] == 'm')
+            g_string_append (s, monitor_name), c++;
+        else if (c[0] == '%' && c[1] == 'v')
+            g_string_append_printf (s, "%lu", value), c++;
+        else if (c[0] == '%' && c[1] == '%')
+            g_string_append_c (s, '%'), c++;
+        else
+            g_string_append_c (s, *c);
+    }
+
+    return g_string_free (s, FALSE);
+}
+
+void
+systemload_alert_run (SystemloadAlert *alert, const gchar *command, const gchar *monitor_name,
+                      gulong value, guint min_interval, gint64 time)
+{
+    if (command == NULL || *command == '\0')
+        return;
+
+    /* Rate limiting: a flapping value must not be able to start commands in quick succession */
+    if (alert->child != NULL)
+        return;
+    if (alert->last_run != 0 && time - alert->last_run < (gint64) min_interval * G_USEC_PER_SEC)
+        return;
+
+    gchar *expanded = expand_command (command, monitor_name, value);
+    gchar **argv = NULL;
+    GError *error = NULL;
+    GPid pid;
+
+    if (g_shell_parse_argv (expanded, NULL, &argv, &error) &&
+        g_spawn_async (NULL, argv, NULL,
+                       GSpawnFlags (G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD),
+                       NULL, NULL, &pid, &error))
+    {
+        t_child *child = g_new0 (t_child, 1);
+        child->alert = alert;
+        alert->child = child;
+        g_child_watch_add (pid, child_exited_cb, child);
+    }
+    else
+    {
+        g_warning ("Cannot run alert command '%s': %s", expanded, error->message);
+        g_error_free (error);
+    }
+    alert->last_run = time;
+
+    g_strfreev (argv);
+    g_free (expanded);
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_ALERT_H_
+#define _XFCE_SYSTEMLOAD_ALERT_H_
+
+#include <glib.h>
+
+/* Color of the monitors with an active alert */
+#define ALERT_COLOR "#e01b24"
+
+/* Thresholds are in the range of the monitor values (0% ... 100%), durations in seconds */
+struct SystemloadAlertRule {
+    guint  threshold;   /* 0 disables the rule */
+    guint  hold;        /* How long the value must stay at or above the threshold */
+    guint  hysteresis;  /* The alert is cleared when the value drops below threshold - hysteresis */
+};
+
+enum SystemloadAlertTransition {
+    ALERT_UNCHANGED,
+    ALERT_RAISED,
+    ALERT_CLEARED,
+};
+
+/* The state of one rule */
+typedef struct _SystemloadAlert SystemloadAlert;
+
+SystemloadAlert          *systemload_alert_new       (void);
+void                      systemload_alert_free      (SystemloadAlert            *alert);
+bool                      systemload_alert_is_active (const SystemloadAlert      *alert);
+
+/* Evaluates the rule against a new value. time is in microseconds, from g_get_monotonic_time(). */
+SystemloadAlertTransition systemload_alert_evaluate  (SystemloadAlert            *alert,
+                                                      const SystemloadAlertRule  *rule,
+                                                      gulong                      value,
+                                                      gint64                      time);
+
+/*
+ * Runs the command asynchronously, with "%m" replaced by the name of the monitor and "%v" by the value.
+ * Nothing is run if the previous command of this alert is still running, or if it was started less
+ * than min_interval seconds ago.
+ */
+void                      systemload_alert_run       (SystemloadAlert            *alert,
+                                                      const gchar                *command,
+                                                      const gchar                *monitor_name,
+                                                      gulong                      value,
+                                                      guint                       min_interval,
+                                                      gint64                      time);
+
+#endif /* _XFCE_SYSTEMLOAD_ALERT_H_ */
@@ -38,54 +38,287 @@
 #include <string.h>
 #include "cpu.h"
 
+#if defined(__linux__) || defined(__FreeBSD_kernel__)
+#include "procfile.h"
+#elif defined(__sun__)
+#include <kstat.h>
+#endif
+
+struct SystemloadCpuSampler {
+    SystemloadProcScope *scope;
+    guint64   oldticks[N_CPU_STATES], oldidle;
+    guint8   *core_load;
+    guint64 (*core_ticks)[2];  /* Used and total ticks of the previous reading */
+    guint     n_cores, max_cores;
+#if defined(__linux__) || defined(__FreeBSD_kernel__)
+    SystemloadProcFile *proc_stat;
+    guint64   old_activity[3];  /* ctxt, intr and processes of the previous reading */
+    gint64    activity_time;    /* Of the previous reading, 0 before the first one */
+#elif defined(__sun__)
+    kstat_ctl_t *kc;
+#endif
+};
+
+SystemloadCpuSampler *
+systemload_cpu_sampler_new (SystemloadProcScope *scope)
+{
+    SystemloadCpuSampler *sampler = g_new0 (SystemloadCpuSampler, 1);
+    sampler->scope = scope;
+    return sampler;
+}
+
+void
+systemload_cpu_sampler_free (SystemloadCpuSampler *sampler)
+{
+    if (!sampler)
+        return;
+#if defined(__linux__) || defined(__FreeBSD_kernel__)
+    if (sampler->proc_stat)
+        systemload_procfile_close (sampler->proc_stat);
+#elif defined(__sun__)
+    if (sampler->kc)
+        kstat_close (sampler->kc);
+#endif
+    g_free (sampler->core_load);
+    g_free (sampler->core_ticks);
+    g_free (sampler);
+}
+
+/*
+ * Computes the shares of the states from the cumulative tick counters of the platform.
+ * idle is the tick counter of the idle state, which is not part of SystemloadCpuState.
+ */
+static gulong
+cpu_load_from_ticks(SystemloadCpuSampler *sampler, const guint64 ticks[N_CPU_STATES], guint64 idle, SystemloadCpuLoad *load)
+{
+    guint64 *oldticks = sampler->oldticks;
+    guint64 diff[N_CPU_STATES];
+    guint64 total, used = 0;
+
+    for (gsize i = 0; i < N_CPU_STATES; i++)
+    {
+        diff[i] = (ticks[i] >= oldticks[i]) ? ticks[i] - oldticks[i] : 0;
+        if (i != CPU_STATE_IOWAIT)
+            used += diff[i];
+        oldticks[i] = ticks[i];
+    }
+    total = used + diff[CPU_STATE_IOWAIT] + ((idle >= sampler->oldidle) ? idle - sampler->oldidle : 0);
+    sampler->oldidle = idle;
+
+    if (load)
+    {
+        for (gsize i = 0; i < N_CPU_STATES; i++)
+            load->state[i] = (total != 0) ? (100 * (double) diff[i]) / (double) total : 0;
+    }
+
+    if (total != 0)
+        return (100 * (double) used) / (double) total;
+    else
+        return 0;
+}
+
 #if defined(__linux__) || defined(__FreeBSD_kernel__)
 
 #include <glib/gi18n.h>
 #include <stdint.h>
+#include "procparse.h"
 
 #define PROC_STAT "/proc/stat"
 
-/* user, nice, system, interrupt(BSD specific), idle */
-struct cpu_load_struct {
-    gulong load[5];
-};
+/*
+ * Columns of the cpu lines of /proc/stat. The kernel already accounts guest
+ * and guest_nice time in user and nice, so the trailing guest fields are not read.
+ */
+enum { STAT_USER, STAT_NICE, STAT_SYSTEM, STAT_IDLE, STAT_IOWAIT, STAT_IRQ, STAT_SOFTIRQ, STAT_STEAL, N_STAT_FIELDS };
 
-static gulong oldtotal, oldused;
+/* Converts the columns of a cpu line into SystemloadCpuState ticks, zeroing the columns older kernels lack */
+static void
+stat_fields_to_ticks(guint64 fields[N_STAT_FIELDS], guint n_fields, guint64 ticks[N_CPU_STATES])
+{
+    for (guint i = n_fields; i < N_STAT_FIELDS; i++)
+        fields[i] = 0;
+
+    ticks[CPU_STATE_USER] = fields[STAT_USER] + fields[STAT_NICE];
+    ticks[CPU_STATE_SYSTEM] = fields[STAT_SYSTEM];
+    ticks[CPU_STATE_IRQ] = fields[STAT_IRQ] + fields[STAT_SOFTIRQ];
+    ticks[CPU_STATE_IOWAIT] = fields[STAT_IOWAIT];
+    ticks[CPU_STATE_STEAL] = fields[STAT_STEAL];
+}
 
-gulong read_cpuload()
+gulong read_cpuload(SystemloadCpuSampler *sampler, SystemloadCpuLoad *load)
 {
-    FILE *fd = fopen(PROC_STAT, "r");
-    if (!fd) {
+    if (!sampler->proc_stat)
+        sampler->proc_stat = systemload_procfile_open_in_scope(sampler->scope, PROC_STAT);
+    const gchar *buf = sampler->proc_stat ? systemload_procfile_read(sampler->proc_stat, NULL) : NULL;
+    if (!buf) {
         g_warning("%s", _("File /proc/stat not found!"));
         return 0;
     }
 
-    /* Don't count steal time. It is neither busy nor free tiime. */
-    unsigned long long int user, unice, usystem, idle, iowait, irq, softirq, guest;
-    int nb_read = fscanf (fd, "%*s %llu %llu %llu %llu %llu %llu %llu %*u %llu",
-                          &user, &unice, &usystem, &idle, &iowait, &irq, &softirq, &guest);
-    fclose(fd);
-    if (nb_read <= 4) iowait = 0;
-    if (nb_read <= 5) irq = 0;
-    if (nb_read <= 6) softirq = 0;
-    if (nb_read <= 7) guest = 0;
-
-    gulong used = user + unice + usystem + irq + softirq + guest;
-    gulong total = used + idle + iowait;
-
-    gulong cpu_used;
-    if ((total - oldtotal) != 0)
+    /* The aggregated line comes first, and its "cpu" label has no number */
+    guint64 fields[N_STAT_FIELDS];
+    guint n_fields = strncmp(buf, "cpu ", 4) == 0 ? systemload_parse_uints(buf, fields, N_STAT_FIELDS, NULL) : 0;
+    if (n_fields <= STAT_IDLE) {
+        g_warning("Cannot parse %s", PROC_STAT);
+        return 0;
+    }
+
+    guint64 ticks[N_CPU_STATES];
+    stat_fields_to_ticks(fields, n_fields, ticks);
+
+    return cpu_load_from_ticks(sampler, ticks, fields[STAT_IDLE], load);
+}
+
+guint read_cpuload_cores(SystemloadCpuSampler *sampler, const guint8 **loads)
+{
+    *loads = sampler->core_load;
+
+    if (!sampler->proc_stat)
+        sampler->proc_stat = systemload_procfile_open_in_scope(sampler->scope, PROC_STAT);
+    const gchar *buf = sampler->proc_stat ? systemload_procfile_read(sampler->proc_stat, NULL) : NULL;
+    if (!buf)
+        return 0;
+
+    /* Offline cores are not listed */
+    if (sampler->n_cores)
+        memset(sampler->core_load, 0, sampler->n_cores);
+    sampler->n_cores = 0;
+
+    /* The per-core lines follow the aggregated "cpu" line */
+    const gchar *line = systemload_find_eol(buf);
+    if (*line == '\n')
+        line++;
+    while (strncmp(line, "cpu", 3) == 0 && g_ascii_isdigit(line[3]))
     {
-        cpu_used = (100 * (double)(used - oldused)) / (double)(total - oldtotal);
+        /* The number of the "cpuN" label is parsed as the first value */
+        guint64 values[1 + N_STAT_FIELDS];
+        guint n_values = systemload_parse_uints(line, values, G_N_ELEMENTS(values), &line);
+        if (n_values <= 1 + STAT_IDLE || values[0] >= G_MAXUINT)
+            continue;
+
+        guint cpu = values[0];
+        guint64 *fields = values + 1;
+        guint64 ticks[N_CPU_STATES];
+        stat_fields_to_ticks(fields, n_values - 1, ticks);
+
+        if (cpu >= sampler->max_cores)
+        {
+            guint old_max = sampler->max_cores;
+            guint new_max = MAX(cpu + 1, 2 * old_max);
+            sampler->core_load = g_renew(guint8, sampler->core_load, new_max);
+            sampler->core_ticks = (guint64 (*)[2]) g_realloc(sampler->core_ticks, new_max * sizeof(*sampler->core_ticks));
+            memset(sampler->core_load + old_max, 0, new_max - old_max);
+            memset(sampler->core_ticks + old_max, 0, (new_max - old_max) * sizeof(*sampler->core_ticks));
+            sampler->max_cores = new_max;
+            *loads = sampler->core_load;
+        }
+
+        guint8 *core_load = sampler->core_load;
+        guint64 (*core_ticks)[2] = sampler->core_ticks;
+
+        guint64 used = ticks[CPU_STATE_USER] + ticks[CPU_STATE_SYSTEM] + ticks[CPU_STATE_IRQ] + ticks[CPU_STATE_STEAL];
+        guint64 total = used + ticks[CPU_STATE_IOWAIT] + fields[STAT_IDLE];
+        guint64 diff_used = (used >= core_ticks[cpu][0]) ? used - core_ticks[cpu][0] : 0;
+        guint64 diff_total = (total >= core_ticks[cpu][1]) ? total - core_ticks[cpu][1] : 0;
+        core_load[cpu] = (diff_total != 0) ? MIN(100 * diff_used / diff_total, 100) : 0;
+        core_ticks[cpu][0] = used;
+        core_ticks[cpu][1] = total;
+
+        sampler->n_cores = MAX(sampler->n_cores, cpu + 1);
     }
-    else
+
+    return sampler->n_cores;
+}
+
+/* Returns the value of a "<key> <value>" line, or -1 if the line has another key */
+static gint64
+parse_stat_value(const gchar *line, const gchar *key, gsize key_len)
+{
+    guint64 value;
+    if (strncmp(line, key, key_len) != 0 || line[key_len] != ' ')
+        return -1;
+    /* The intr line continues with the count of every interrupt, only the total is read */
+    return systemload_parse_uints(line + key_len, &value, 1, NULL) == 1 ? (gint64) value : -1;
+}
+
+gint read_cpu_activity(SystemloadCpuSampler *sampler, SystemloadCpuActivity *activity)
+{
+    memset(activity, 0, sizeof(*activity));
+
+    if (!sampler->proc_stat)
+        sampler->proc_stat = systemload_procfile_open_in_scope(sampler->scope, PROC_STAT);
+    const gchar *buf = sampler->proc_stat ? systemload_procfile_read(sampler->proc_stat, NULL) : NULL;
+    if (!buf)
+        return -1;
+
+    enum { ACTIVITY_CTXT, ACTIVITY_INTR, ACTIVITY_PROCESSES };
+    guint64 counters[3] = { 0 };
+    guint n_found = 0;
+    gint64 value;
+
+    for (const gchar *line = buf; *line && n_found < 5; )
+    {
+        switch (line[0])
+        {
+            case 'c':
+                if ((value = parse_stat_value(line, "ctxt", 4)) >= 0)
+                {
+                    counters[ACTIVITY_CTXT] = value;
+                    n_found++;
+                }
+                break;
+            case 'i':
+                if ((value = parse_stat_value(line, "intr", 4)) >= 0)
+                {
+                    counters[ACTIVITY_INTR] = value;
+                    n_found++;
+                }
+                break;
+            case 'p':
+                if ((value = parse_stat_value(line, "processes", 9)) >= 0)
+                {
+                    counters[ACTIVITY_PROCESSES] = value;
+                    n_found++;
+                }
+                else if ((value = parse_stat_value(line, "procs_running", 13)) >= 0)
+                {
+                    activity->running = value;
+                    n_found++;
+                }
+                else if ((value = parse_stat_value(line, "procs_blocked", 13)) >= 0)
+                {
+                    activity->blocked = value;
+                    n_found++;
+                }
+                break;
+        }
+        line = systemload_find_eol(line);
+        if (*line == '\n')
+            line++;
+    }
+
+    /* A counter which is missing would be taken as 0, and its next rate as the whole count */
+    if (n_found < 5 || systemload_procfile_is_truncated(sampler->proc_stat))
+    {
+        memset(activity, 0, sizeof(*activity));
+        return -1;
+    }
+
+    const gint64 time = systemload_procfile_scope_get_time(sampler->scope);
+    if (sampler->activity_time != 0 && time > sampler->activity_time)
     {
-        cpu_used = 0;
+        const gdouble seconds = (time - sampler->activity_time) / 1e6;
+        gdouble rate[3];
+        for (guint i = 0; i < G_N_ELEMENTS(counters); i++)
+            rate[i] = (counters[i] >= sampler->old_activity[i]) ? (counters[i] - sampler->old_activity[i]) / seconds : 0;
+        activity->context_switches = rate[ACTIVITY_CTXT];
+        activity->interrupts = rate[ACTIVITY_INTR];
+        activity->forks = rate[ACTIVITY_PROCESSES];
     }
-    oldused = used;
-    oldtotal = total;
+    memcpy(sampler->old_activity, counters, sizeof(counters));
+    sampler->activity_time = time;
 
-    return cpu_used;
+    return 0;
 }
 
 #elif defined(__FreeBSD__) || defined(__DragonFly__)
@@ -98,16 +331,8 @@ gulong read_cpuload()
 #include <fcntl.h>
 #include <nlist.h>
 
-/* user, nice, system, interrupt(BSD specific), idle */
-struct cpu_load_struct {
-    gulong load[5];
-};
-
-static gulong oldtotal, oldused;
-
-gulong read_cpuload()
+gulong read_cpuload(SystemloadCpuSampler *sampler, SystemloadCpuLoad *load)
 {
-    gulong cpu_used, used, total;
     long cp_time[CPUSTATES];
     size_t len = sizeof(cp_time);
 
@@ -116,21 +341,12 @@ gulong read_cpuload()
         return 0;
     }
 
-    used = cp_time[CP_USER] + cp_time[CP_NICE] + cp_time[CP_SYS] + cp_time[CP_INTR];
-    total = used + cp_time[CP_IDLE];
+    guint64 ticks[N_CPU_STATES] = { 0 };
+    ticks[CPU_STATE_USER] = cp_time[CP_USER] + cp_time[CP_NICE];
+    ticks[CPU_STATE_SYSTEM] = cp_time[CP_SYS];
+    ticks[CPU_STATE_IRQ] = cp_time[CP_INTR];
 
-    if ((total - oldtotal) != 0)
-    {
-        cpu_used = (100 * (double)(used - oldused)) / (double)(total - oldtotal);
-    }
-    else
-    {
-        cpu_used = 0;
-    }
-    oldused = used;
-    oldtotal = total;
-
-    return cpu_used;
+    return cpu_load_from_ticks(sampler, ticks, cp_time[CP_IDLE], load);
 }
 
 #elif defined(__NetBSD__)
@@ -150,16 +366,8 @@ gulong read_cpuload()
 #include <fcntl.h>
 #include <nlist.h>
 
-/* user, nice, system, interrupt(BSD specific), idle */
-struct cpu_load_struct {
-    gulong load[5];
-};
-
-static gulong oldtotal, oldused;
-
-gulong read_cpuload()
+gulong read_cpuload(SystemloadCpuSampler *sampler, SystemloadCpuLoad *load)
 {
-    gulong cpu_used, used, total;
     static int mib[] = { CTL_KERN, KERN_CP_TIME };
     u_int64_t cp_time[CPUSTATES];
     size_t len = sizeof(cp_time);
@@ -169,21 +377,12 @@ gulong read_cpuload()
         return 0;
     }
 
-    used = cp_time[CP_USER] + cp_time[CP_NICE] + cp_time[CP_SYS] + cp_time[CP_INTR];
-    total = used + cp_time[CP_IDLE];
-
-    if ((total - oldtotal) != 0)
-    {
-        cpu_used = (100 * (double)(used - oldused)) / (double)(total - oldtotal);
-    }
-    else
-    {
-        cpu_used = 0;
-    }
-    oldused = used;
-    oldtotal = total;
+    guint64 ticks[N_CPU_STATES] = { 0 };
+    ticks[CPU_STATE_USER] = cp_time[CP_USER] + cp_time[CP_NICE];
+    ticks[CPU_STATE_SYSTEM] = cp_time[CP_SYS];
+    ticks[CPU_STATE_IRQ] = cp_time[CP_INTR];
 
-    return cpu_used;
+    return cpu_load_from_ticks(sampler, ticks, cp_time[CP_IDLE], load);
 }
 
 #elif defined(__OpenBSD__)
@@ -203,16 +402,8 @@ gulong read_cpuload()
 #include <fcntl.h>
 #include <nlist.h>
 
-/* user, nice, system, interrupt(BSD specific), idle */
-struct cpu_load_struct {
-    gulong load[5];
-};
-
-static gulong oldtotal, oldused;
-
-gulong read_cpuload()
+gulong read_cpuload(SystemloadCpuSampler *sampler, SystemloadCpuLoad *load)
 {
-    gulong cpu_used, used, total;
     static int mib[] = { CTL_KERN, KERN_CPTIME };
     long cp_time[CPUSTATES];
     size_t len = sizeof(cp_time);
@@ -222,78 +413,65 @@ gulong read_cpuload()
             return 0;
     }
 
-    used = cp_time[CP_USER] + cp_time[CP_NICE] + cp_time[CP_SYS] + cp_time[CP_INTR];
-    total = used + cp_time[CP_IDLE];
+    guint64 ticks[N_CPU_STATES] = { 0 };
+    ticks[CPU_STATE_USER] = cp_time[CP_USER] + cp_time[CP_NICE];
+    ticks[CPU_STATE_SYSTEM] = cp_time[CP_SYS];
+    ticks[CPU_STATE_IRQ] = cp_time[CP_INTR];
 
-    if ((total - oldtotal) != 0)
-    {
-        cpu_used = (100 * (double)(used - oldused)) / (double)(total - oldtotal);
-    }
-    else
-    {
-        cpu_used = 0;
-    }
-    oldused = used;
-    oldtotal = total;
-
-    return cpu_used;
+    return cpu_load_from_ticks(sampler, ticks, cp_time[CP_IDLE], load);
 }
 #elif defined(__sun__)
 
-#include <kstat.h>
-
-static kstat_ctl_t *kc;
-static gulong oldtotal, oldused;
-
-void init_stats()
+gulong read_cpuload(SystemloadCpuSampler *sampler, SystemloadCpuLoad *load)
 {
-    kc = kstat_open();
-}
-
-gulong read_cpuload()
-{
-    gulong cpu_used, used, total;
+    guint64 user, kernel, idle;
     kstat_t *ksp;
     kstat_named_t *knp;
 
-    if (!kc)
-    {
-       init_stats();
-    }
+    if (!sampler->kc)
+        sampler->kc = kstat_open();
+    kstat_ctl_t *kc = sampler->kc;
     kstat_chain_update(kc);
-    used = 0;
-    total = 0;
+    user = 0;
+    kernel = 0;
+    idle = 0;
     for (ksp = kc->kc_chain; ksp != NULL; ksp = ksp->ks_next)
     {
         if (!strcmp(ksp->ks_module, "cpu") && !strcmp(ksp->ks_name, "sys"))
        {
            kstat_read(kc, ksp, NULL);
            knp = kstat_data_lookup(ksp, "cpu_ticks_user");
-           used += knp->value.ui64;
-           total += knp->value.ui64;
+           user += knp->value.ui64;
            knp = kstat_data_lookup(ksp, "cpu_ticks_kernel");
-           used += knp->value.ui64;
-           total += knp->value.ui64;
+           kernel += knp->value.ui64;
            knp = kstat_data_lookup(ksp, "cpu_ticks_idle");
-           total += knp->value.ui64;
+           idle += knp->value.ui64;
        }
     }
 
-    printf("CPU: %lu %lu %lu %lu\n", used, oldused, total, oldtotal);
+    guint64 ticks[N_CPU_STATES] = { 0 };
+    ticks[CPU_STATE_USER] = user;
+    ticks[CPU_STATE_SYSTEM] = kernel;
 
-    if ((total - oldtotal) != 0)
-    {
-        cpu_used = (100 * (double)(used - oldused)) / (double)(total - oldtotal);
-    }
-    else
-    {
-        cpu_used = 0;
-    }
-    oldused = used;
-    oldtotal = total;
-    return cpu_used;
+    return cpu_load_from_ticks(sampler, ticks, idle, load);
 }
 
 #else
 #error "Your platform is not yet supported"
 #endif
+
+#if !(defined(__linux__) || defined(__FreeBSD_kernel__))
+
+guint read_cpuload_cores(SystemloadCpuSampler *sampler, const guint8 **loads)
+{
+    *loads = NULL;
+    return 0;
+}
+
+gint read_cpu_activity(SystemloadCpuSampler *sampler, SystemloadCpuActivity *activity)
+{
+    memset(activity, 0, sizeof(*activity));
+    return -1;
+}
+
+#endif
@@ -31,6 +31,62 @@
 
 #include <glib.h>
 
-gulong read_cpuload();
+#include "procfile.h"
+
+/* The states which are shown in the stacked CPU bar */
+enum SystemloadCpuState {
+    CPU_STATE_USER,     /* user + nice, this includes the time spent running guests */
+    CPU_STATE_SYSTEM,
+    CPU_STATE_IRQ,      /* irq + softirq */
+    CPU_STATE_IOWAIT,
+    CPU_STATE_STEAL,
+    N_CPU_STATES,
+};
+
+/* Share of each state since the previous reading, in percent */
+struct SystemloadCpuLoad {
+    gdouble  state[N_CPU_STATES];
+};
+
+/* Scheduler activity of the whole system, Linux only */
+struct SystemloadCpuActivity {
+    gdouble  context_switches;  /* Per second since the previous reading, 0 for the first one */
+    gdouble  interrupts;        /* Per second */
+    gdouble  forks;             /* Per second */
+    guint    running;           /* Runnable tasks, this includes the reader itself */
+    guint    blocked;           /* Tasks waiting for I/O */
+};
+
+/*
+ * The counters of the previous reading and the buffers of one consumer of the CPU readers.
+ * The loads are deltas since the previous call with the same sampler, so consumers which
+ * sample at different rates, or from different threads, each need their own sampler.
+ * The files are read in the given scope, NULL for the regular update. See procfile.h
+ */
+struct SystemloadCpuSampler;
+
+SystemloadCpuSampler *systemload_cpu_sampler_new  (SystemloadProcScope *scope);
+void                  systemload_cpu_sampler_free (SystemloadCpuSampler *sampler);
+
+/*
+ * Returns the percentage of time the CPUs were busy or stolen by the hypervisor,
+ * that is everything except idle and iowait. load can be NULL.
+ */
+gulong read_cpuload(SystemloadCpuSampler *sampler, SystemloadCpuLoad *load);
+
+/*
+ * Reads the load of every core in percent, indexed by the number of the core.
+ * Returns the number of cores, or 0 if this is not supported on the platform.
+ * The array is owned by the sampler and stays valid until the next call.
+ */
+guint read_cpuload_cores(SystemloadCpuSampler *sampler, const guint8 **loads);
+
+/*
+ * Reads the context switch, interrupt and fork counters and the run queue from the lines which
+ * follow the cpu lines of /proc/stat, so together with read_cpuload() the file is read only once.
+ * Returns -1 if this is not supported on the platform, or the file cannot be read or lacks one
+ * of the lines, then the counters of the previous reading are kept for the next one.
+ */
+gint read_cpu_activity(SystemloadCpuSampler *sampler, SystemloadCpuActivity *activity);
 
 #endif /* _XFCE_SYSTEMLOAD_CPU_H_ */
@@ -0,0 +1,449 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include <glib.h>
+#include <glib-unix.h>
+
+#include "exporter.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+/* Scrapers which keep their end of the connection open are limited to this number */
+#define MAX_CLIENTS 8
+
+#define METRIC_PREFIX "xfce_systemload_"
+
+struct _SystemloadExporter {
+    gchar    *config_path;  /* As passed to systemload_exporter_new() */
+    gchar    *path;         /* Resolved path of the socket */
+    gint      fd;
+    guint     watch_id;
+    GSList   *clients;
+
+    GString  *body;         /* Reused between updates */
+    GString  *response;     /* HTTP header + body, reused between updates */
+    GBytes   *contents;     /* The response of the latest update, sent as-is to each client */
+};
+
+struct t_client {
+    SystemloadExporter *exporter;
+    gint               fd;
+    guint              watch_id;
+    GBytes             *contents;  /* The response being sent, NULL once it was sent */
+    gsize              sent;
+};
+
+
+
+static void
+client_close (t_client *client)
+{
+    SystemloadExporter *exporter = client->exporter;
+
+    close (client->fd);
+    exporter->clients = g_slist_remove (exporter->clients, client);
+    if (client->contents)
+        g_bytes_unref (client->contents);
+    g_free (client);
+}
+
+/* Sends as much of the response as the socket takes, returns false if the client is gone */
+static bool
+client_send (t_client *client)
+{
+    gsize length;
+    auto data = (const gchar*) g_bytes_get_data (client->contents, &length);
+
+    while (client->sent < length)
+    {
+        ssize_t n = send (client->fd, data + client->sent, length - client->sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n > 0)
+            client->sent += n;
+        else if (n < 0 && errno == EINTR)
+            continue;
+        else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return true;
+        else
+            return false;
+    }
+
+    g_bytes_unref (client->contents);
+    client->contents = NULL;
+    shutdown (client->fd, SHUT_WR);
+    return true;
+}
+
+static gboolean
+client_cb (gint fd, GIOCondition condition, gpointer user_data)
+{
+    auto client = (t_client*) user_data;
+    gchar buf[512];
+    ssize_t n;
+
+    /*
+     * The response has already been sent. Discard the request and wait for the client
+     * to close the connection: closing a socket with unread data in it would make
+     * the client see a connection reset instead of the response.
+     */
+    while ((n = recv (fd, buf, sizeof (buf), MSG_DONTWAIT)) > 0);
+
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) || (condition & (G_IO_HUP | G_IO_ERR)))
+    {
+        client_close (client);
+        return G_SOURCE_REMOVE;
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+/* The rest of a response which did not fit into the socket buffer */
+static gboolean
+client_send_cb (gint fd, GIOCondition condition, gpointer user_data)
+{
+    auto client = (t_client*) user_data;
+
+    if ((condition & (G_IO_HUP | G_IO_ERR)) || !client_send (client))
+    {
+        client_close (client);
+        return G_SOURCE_REMOVE;
+    }
+    if (client->contents)
+        return G_SOURCE_CONTINUE;
+
+    client->watch_id = g_unix_fd_add (fd, GIOCondition (G_IO_IN | G_IO_HUP | G_IO_ERR), client_cb, client);
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean
+accept_cb (gint fd, GIOCondition condition, gpointer user_data)
+{
+    auto exporter = (SystemloadExporter*) user_data;
+    gint client_fd;
+
+    while ((client_fd = accept (fd, NULL, NULL)) >= 0)
+    {
+        fcntl (client_fd, F_SETFD, FD_CLOEXEC);
+
+        /* Over the limit, there is no room to finish a response which does not fit into the socket buffer */
+        if (g_slist_length (exporter->clients) >= MAX_CLIENTS || !g_unix_set_fd_nonblocking (client_fd, TRUE, NULL))
+        {
+            close (client_fd);
+            continue;
+        }
+
+        t_client *client = g_new0 (t_client, 1);
+        client->exporter = exporter;
+        client->fd = client_fd;
+        client->contents = g_bytes_ref (exporter->contents);
+        exporter->clients = g_slist_prepend (exporter->clients, client);
+
+        if (!client_send (client))
+            client_close (client);
+        else if (client->contents)
+            client->watch_id = g_unix_fd_add (client_fd, GIOCondition (G_IO_OUT | G_IO_HUP | G_IO_ERR), client_send_cb, client);
+        else
+            client->watch_id = g_unix_fd_add (client_fd, GIOCondition (G_IO_IN | G_IO_HUP | G_IO_ERR), client_cb, client);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+
+
+SystemloadExporter *
+systemload_exporter_new (const gchar *path)
+{
+    g_return_val_if_fail (path != NULL && *path != '\0', NULL);
+
+    gchar *resolved;
+    if (g_path_is_absolute (path))
+        resolved = g_strdup (path);
+    else
+        resolved = g_build_filename (g_get_user_runtime_dir (), path, NULL);
+
+    struct sockaddr_un addr;
+    memset (&addr, 0, sizeof (addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen (resolved) >= sizeof (addr.sun_path))
+    {
+        g_warning ("Metrics socket path '%s' is too long", resolved);
+        g_free (resolved);
+        return NULL;
+    }
+    strcpy (addr.sun_path, resolved);
+
+    gint fd = socket (AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        g_warning ("Cannot create metrics socket: %s", g_strerror (errno));
+        g_free (resolved);
+        return NULL;
+    }
+    fcntl (fd, F_SETFD, FD_CLOEXEC);
+
+    /*
+     * Remove a stale socket left behind by a previous instance, but never anything else,
+     * and never the socket of an instance which is still running
+     */
+    struct stat st;
+    if (lstat (resolved, &st) == 0 && S_ISSOCK (st.st_mode))
+    {
+        gint probe = socket (AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (probe >= 0 && connect (probe, (struct sockaddr*) &addr, sizeof (addr)) != 0 && errno == ECONNREFUSED)
+            unlink (resolved);
+        if (probe >= 0)
+            close (probe);
+    }
+
+    if (bind (fd, (struct sockaddr*) &addr, sizeof (addr)) != 0 ||
+        chmod (resolved, S_IRUSR | S_IWUSR) != 0 ||
+        listen (fd, MAX_CLIENTS) != 0 ||
+        !g_unix_set_fd_nonblocking (fd, TRUE, NULL))
+    {
+        g_warning ("Cannot listen on metrics socket '%s': %s", resolved, g_strerror (errno));
+        close (fd);
+        g_free (resolved);
+        return NULL;
+    }
+
+    SystemloadExporter *exporter = g_new0 (SystemloadExporter, 1);
+    exporter->config_path = g_strdup (path);
+    exporter->path = resolved;
+    exporter->fd = fd;
+    exporter->body = g_string_sized_new (2048);
+    exporter->response = g_string_sized_new (2048);
+    exporter->watch_id = g_unix_fd_add (fd, G_IO_IN, accept_cb, exporter);
+
+    systemload_exporter_update (exporter, NULL);
+
+    return exporter;
+}
+
+void
+systemload_exporter_free (SystemloadExporter *exporter)
+{
+    if (exporter == NULL)
+        return;
+
+    while (exporter->clients)
+    {
+        auto client = (t_client*) exporter->clients->data;
+        g_source_remove (client->watch_id);
+        client_close (client);
+    }
+
+    g_source_remove (exporter->watch_id);
+    close (exporter->fd);
+    unlink (exporter->path);
+
+    g_string_free (exporter->body, TRUE);
+    g_string_free (exporter->response, TRUE);
+    g_bytes_unref (exporter->contents);
+    g_free (exporter->config_path);
+    g_free (exporter->path);
+    g_free (exporter);
+}
+
+const gchar *
+systemload_exporter_get_path (const SystemloadExporter *exporter)
+{
+    g_return_val_if_fail (exporter != NULL, NULL);
+
+    return exporter->config_path;
+}
+
+
+
+static void
+append_metric (GString *s, const gchar *name, const gchar *help, gdouble value)
+{
+    gchar buf[G_ASCII_DTOSTR_BUF_SIZE];
+
+    /* g_ascii_dtostr() is locale-independent, as required by the format */
+    g_string_append_printf (s, "# TYPE " METRIC_PREFIX "%s gauge\n", name);
+    g_string_append_printf (s, "# HELP " METRIC_PREFIX "%s %s\n", name, help);
+    g_string_append_printf (s, METRIC_PREFIX "%s %s\n", name, g_ascii_dtostr (buf, sizeof (buf), value));
+}
+
+void
+systemload_exporter_update (SystemloadExporter *exporter, const SystemloadSnapshot *snapshot)
+{
+    g_return_if_fail (exporter != NULL);
+
+    GString *body = exporter->body;
+    g_string_truncate (body, 0);
+
+    if (snapshot != NULL)
+    {
+        if (snapshot->enabled[CPU_MONITOR])
+            append_metric (body, "cpu_usage_ratio", "CPU usage.",
+                           snapshot->value[CPU_MONITOR] / 100.0);
+        if (snapshot->enabled[MEM_MONITOR])
+        {
+            append_metric (body, "memory_total_bytes", "Total memory.",
+                           snapshot->mem_total * 1024.0);
+            append_metric (body, "memory_used_bytes", "Memory in use.",
+                           snapshot->mem_used * 1024.0);
+        }
+        if (snapshot->enabled[SWAP_MONITOR])
+        {
+            append_metric (body, "swap_total_bytes", "Total swap space.",
+                           snapshot->swap_total * 1024.0);
+            append_metric (body, "swap_used_bytes", "Swap space in use.",
+                           snapshot->swap_used * 1024.0);
+            if (snapshot->swap_ram_total)
+                append_metric (body, "swap_compressed_used_bytes", "Swap space in use on zram devices.",
+                               snapshot->swap_ram_used * 1024.0);
+        }
+        if (snapshot->enabled[NET_MONITOR])
+            append_metric (body, "network_bits_per_second", "Network traffic, received and transmitted.",
+                           snapshot->net_bits);
+        if (snapshot->enabled[FS_MONITOR])
+            append_metric (body, "filesystem_usage_ratio", "Usage of the fullest monitored filesystem.",
+                           snapshot->value[FS_MONITOR] / 100.0);
+        if (snapshot->enabled[PAGING_MONITOR] && snapshot->vmstat_valid)
+        {
+            const SystemloadVmstat *vm = &snapshot->vmstat;
+            append_metric (body, "swap_in_bytes_per_second", "Pages read from swap.",
+                           vm->rate[VMSTAT_PSWPIN] * vm->page_size);
+            append_metric (body, "swap_out_bytes_per_second", "Pages written to swap.",
+                           vm->rate[VMSTAT_PSWPOUT] * vm->page_size);
+            append_metric (body, "major_faults_per_second", "Page faults which required I/O.",
+                           vm->rate[VMSTAT_PGMAJFAULT]);
+            append_metric (body, "reclaim_scanned_pages_per_second", "Pages scanned by kswapd and direct reclaim.",
+                           vm->rate[VMSTAT_PGSCAN_KSWAPD] + vm->rate[VMSTAT_PGSCAN_DIRECT]);
+            append_metric (body, "reclaim_stolen_pages_per_second", "Pages reclaimed by kswapd and direct reclaim.",
+                           vm->rate[VMSTAT_PGSTEAL_KSWAPD] + vm->rate[VMSTAT_PGSTEAL_DIRECT]);
+            append_metric (body, "oom_kills", "Processes killed by the OOM killer since boot.",
+                           vm->oom_kills);
+        }
+        if (snapshot->enabled[SCHED_MONITOR] && snapshot->activity_valid)
+        {
+            append_metric (body, "context_switches_per_second", "Context switches of all CPUs.",
+                           snapshot->activity.context_switches);
+            append_metric (body, "interrupts_per_second", "Interrupts of all CPUs.",
+                           snapshot->activity.interrupts);
+            append_metric (body, "forks_per_second", "Processes and threads created.",
+                           snapshot->activity.forks);
+            append_metric (body, "procs_running", "Runnable tasks.",
+                           snapshot->activity.running);
+            append_metric (body, "procs_blocked", "Tasks waiting for I/O.",
+                           snapshot->activity.blocked);
+        }
+        if (snapshot->enabled[IRQ_MONITOR] && snapshot->irq_valid)
+        {
+            append_metric (body, "irq_events_per_second", "Interrupts and softirqs of all CPUs.",
+                           snapshot->irq.rate);
+            append_metric (body, "irq_concentration_ratio", "How much of the interrupts and softirqs the busiest CPU handles, 0 if spread evenly.",
+                           snapshot->irq.concentration / 100.0);
+        }
+        if (snapshot->enabled[TCP_MONITOR] && snapshot->tcp_valid)
+        {
+            static const gchar *const STATE_METRICS[] = {
+                "tcp_established", "tcp_syn_sent", "tcp_syn_recv", "tcp_fin_wait",
+                "tcp_time_wait", "tcp_close_wait", "tcp_listen",
+            };
+            G_STATIC_ASSERT (G_N_ELEMENTS (STATE_METRICS) == N_TCP_STATES);
+            const SystemloadTcpStat *tcp = &snapshot->tcp;
+
+            append_metric (body, "tcp_out_segments_per_second", "TCP segments sent.",
+                           tcp->out_segments);
+            append_metric (body, "tcp_retransmits_per_second", "TCP segments retransmitted.",
+                           tcp->retransmits);
+            append_metric (body, "tcp_listen_overflows_per_second", "Connections dropped because an accept queue was full.",
+                           tcp->listen_overflows);
+            append_metric (body, "tcp_timeouts_per_second", "TCP retransmission timeouts.",
+                           tcp->timeouts);
+            append_metric (body, "tcp_memory_bytes", "Memory of the TCP socket buffers.",
+                           tcp->memory);
+            if (tcp->states_valid)
+                for (guint i = 0; i < N_TCP_STATES; i++)
+                    append_metric (body, STATE_METRICS[i], "TCP connections in the state.",
+                                   tcp->states[i]);
+        }
+        if (snapshot->enabled[ZRAM_MONITOR] && snapshot->compressed_valid)
+        {
+            const SystemloadCompressedMemory *compressed = &snapshot->compressed;
+            append_metric (body, "compressed_memory_stored_bytes", "Data in zram and zswap, before compression.",
+                           compressed->zram_stored + compressed->zswap_stored);
+            append_metric (body, "compressed_memory_used_bytes", "RAM used by zram and zswap.",
+                           compressed->zram_used + compressed->zswap_used);
+        }
+        if (snapshot->enabled[LATENCY_MONITOR] && snapshot->schedstat_valid)
+        {
+            append_metric (body, "run_queue_wait_seconds", "Average time a task waited on a run queue before a timeslice.",
+                           snapshot->schedstat.wait / 1e6);
+            append_metric (body, "run_queue_wait_ratio", "Time waited on run queues by all the tasks, per second.",
+                           snapshot->schedstat.wait_rate / 1e3);
+        }
+        if (snapshot->uptime_enabled)
+            append_metric (body, "uptime_seconds", "Time since boot.",
+                           snapshot->uptime);
+        if (snapshot->self_enabled)
+        {
+            append_metric (body, "self_cpu_ratio", "CPU time used by the plugin, relative to one CPU.",
+                           snapshot->self.cpu / 100.0);
+            append_metric (body, "self_wakeups_per_second", "Voluntary context switches of the plugin.",
+                           snapshot->self.wakeups);
+            append_metric (body, "self_resident_bytes", "Resident memory of the plugin.",
+                           snapshot->self.rss * 1024.0);
+            if (snapshot->self.heap)
+                append_metric (body, "self_heap_bytes", "Memory allocated by the plugin with malloc().",
+                               snapshot->self.heap * 1024.0);
+        }
+    }
+    g_string_append (body, "# EOF\n");
+
+    g_string_printf (exporter->response,
+                     "HTTP/1.0 200 OK\r\n"
+                     "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                     "Content-Length: %" G_GSIZE_FORMAT "\r\n"
+                     "Connection: close\r\n"
+                     "\r\n",
+                     body->len);
+    g_string_append_len (exporter->response, body->str, body->len);
+
+    /* Clients which are still being sent the previous response keep their reference to it */
+    if (exporter->contents)
+        g_bytes_unref (exporter->contents);
+    exporter->contents = g_bytes_new (exporter->response->str, exporter->response->len);
+}
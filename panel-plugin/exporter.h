@@ -0,0 +1,54 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_EXPORTER_H_
+#define _XFCE_SYSTEMLOAD_EXPORTER_H_
+
+#include <glib.h>
+
+#include "snapshot.h"
+
+/*
+ * Serves the latest snapshot in OpenMetrics text format on a Unix domain socket.
+ *
+ * The response is rendered once per update, so a scrape usually costs one accept() and one send().
+ * The rest of a response which does not fit into the socket buffer is sent when the socket is writable.
+ * It is a complete HTTP/1.0 response, so the socket can be scraped with, for example:
+ *
+ *   curl --unix-socket $XDG_RUNTIME_DIR/systemload.sock http://localhost/metrics
+ */
+typedef struct _SystemloadExporter SystemloadExporter;
+
+/* A relative path is resolved against the user's runtime directory. Returns NULL on failure. */
+SystemloadExporter *systemload_exporter_new      (const gchar              *path);
+void                systemload_exporter_free     (SystemloadExporter       *exporter);
+const gchar        *systemload_exporter_get_path (const SystemloadExporter *exporter);
+void                systemload_exporter_update   (SystemloadExporter       *exporter,
+                                                  const SystemloadSnapshot *snapshot);
+
+#endif /* _XFCE_SYSTEMLOAD_EXPORTER_H_ */
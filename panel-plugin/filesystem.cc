@@ -0,0 +1,327 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/statvfs.h>
+
+#include <glib.h>
+#include <glib-unix.h>
+
+#include "filesystem.h"
+
+#define PROC_MOUNTINFO "/proc/self/mountinfo"
+
+/* An entry of the mount table */
+struct t_mount {
+    gchar *mount_point;
+    gchar *device;  /* "major:minor" */
+    bool   local;   /* Backed by a block device, and not a read-only image which is always full */
+};
+
+struct SystemloadFilesystems {
+    gchar      **mount_points;  /* Configured mount points, empty for all local filesystems */
+    GPtrArray   *mounts;        /* t_mount, NULL if the mount table is unavailable */
+    GPtrArray   *filesystems;   /* SystemloadFilesystem */
+    bool         changed;       /* The mount table or the configured mount points have changed */
+    gint         fd;
+    guint        watch_id;
+};
+
+/* Read-only filesystem images report no free space */
+static const gchar *const IMAGE_TYPES[] = {
+    "squashfs",
+    "iso9660",
+    "udf",
+    "erofs",
+    "cramfs",
+};
+
+static void
+mount_free (gpointer data)
+{
+    auto mount = (t_mount*) data;
+    g_free (mount->mount_point);
+    g_free (mount->device);
+    g_free (mount);
+}
+
+static void
+filesystem_free (gpointer data)
+{
+    auto filesystem = (SystemloadFilesystem*) data;
+    g_free (filesystem->mount_point);
+    g_free (filesystem);
+}
+
+/*
+ * Parses the mount table. A line looks like
+ * "36 35 98:0 /mnt1 /mnt/parent rw,noatime master:1 - ext3 /dev/root rw,errors=continue",
+ * where the number of optional fields before "-" varies, and spaces in paths are escaped as "\040".
+ */
+static GPtrArray *
+read_mounts (void)
+{
+    gchar *contents;
+    if (!g_file_get_contents (PROC_MOUNTINFO, &contents, NULL, NULL))
+        return NULL;
+
+    GPtrArray *mounts = g_ptr_array_new_with_free_func (mount_free);
+    gchar **lines = g_strsplit (contents, "\n", -1);
+    g_free (contents);
+
+    for (gchar **line = lines; *line; line++)
+    {
+        gchar **fields = g_strsplit (*line, " ", -1);
+        guint n = g_strv_length (fields), separator = 6;
+        while (separator < n && strcmp (fields[separator], "-") != 0)
+            separator++;
+
+        if (separator + 2 < n)
+        {
+            const gchar *type = fields[separator + 1];
+            const gchar *source = fields[separator + 2];
+            t_mount *mount = g_new0 (t_mount, 1);
+
+            mount->mount_point = g_strcompress (fields[4]);
+            mount->device = g_strdup (fields[2]);
+            mount->local = g_str_has_prefix (source, "/dev/") || strcmp (type, "zfs") == 0;
+            for (gsize i = 0; i < G_N_ELEMENTS (IMAGE_TYPES); i++)
+                if (strcmp (type, IMAGE_TYPES[i]) == 0)
+                    mount->local = false;
+
+            g_ptr_array_add (mounts, mount);
+        }
+        g_strfreev (fields);
+    }
+
+    g_strfreev (lines);
+    return mounts;
+}
+
+static const t_mount *
+find_mount (const SystemloadFilesystems *filesystems, const gchar *mount_point)
+{
+    /* The last mount on a mount point hides the earlier ones */
+    for (guint i = filesystems->mounts->len; i-- > 0; )
+    {
+        auto mount = (const t_mount*) g_ptr_array_index (filesystems->mounts, i);
+        if (strcmp (mount->mount_point, mount_point) == 0)
+            return mount;
+    }
+    return NULL;
+}
+
+static void
+add_filesystem (SystemloadFilesystems *filesystems, const gchar *mount_point, bool mounted)
+{
+    SystemloadFilesystem *filesystem = g_new0 (SystemloadFilesystem, 1);
+    filesystem->mount_point = g_strdup (mount_point);
+    filesystem->mounted = mounted;
+    g_ptr_array_add (filesystems->filesystems, filesystem);
+}
+
+/* Rebuilds the list of monitored filesystems from the mount table and the configured mount points */
+static void
+select_filesystems (SystemloadFilesystems *filesystems)
+{
+    g_ptr_array_set_size (filesystems->filesystems, 0);
+
+    if (filesystems->mount_points[0] != NULL)
+    {
+        for (gchar **mount_point = filesystems->mount_points; *mount_point; mount_point++)
+        {
+            /* Without a mount table, trust the configuration */
+            bool mounted = !filesystems->mounts || find_mount (filesystems, *mount_point) != NULL;
+            add_filesystem (filesystems, *mount_point, mounted);
+        }
+    }
+    else if (filesystems->mounts)
+    {
+        /* Bind mounts share the device of the original mount, which comes first */
+        GHashTable *devices = g_hash_table_new (g_str_hash, g_str_equal);
+        for (guint i = 0; i < filesystems->mounts->len; i++)
+        {
+            auto mount = (const t_mount*) g_ptr_array_index (filesystems->mounts, i);
+            if (mount->local && g_hash_table_add (devices, mount->device))
+                add_filesystem (filesystems, mount->mount_point, true);
+        }
+        g_hash_table_destroy (devices);
+    }
+}
+
+static bool
+strv_equal (gchar **a, gchar **b)
+{
+    while (*a && *b && strcmp (*a, *b) == 0)
+        a++, b++;
+    return *a == NULL && *b == NULL;
+}
+
+static gboolean
+mounts_changed_cb (gint fd, GIOCondition condition, gpointer user_data)
+{
+    auto filesystems = (SystemloadFilesystems*) user_data;
+
+    /* The kernel clears the condition when the file is polled, there is nothing to read */
+    filesystems->changed = true;
+    return G_SOURCE_CONTINUE;
+}
+
+SystemloadFilesystems *
+systemload_filesystems_new (void)
+{
+    SystemloadFilesystems *filesystems = g_new0 (SystemloadFilesystems, 1);
+
+    filesystems->mount_points = g_new0 (gchar*, 1);
+    filesystems->filesystems = g_ptr_array_new_with_free_func (filesystem_free);
+    filesystems->changed = true;
+    filesystems->fd = -1;
+
+#ifdef __linux__
+    /* poll() reports POLLPRI and POLLERR on the mount table when a filesystem is mounted or unmounted */
+    filesystems->fd = open (PROC_MOUNTINFO, O_RDONLY | O_CLOEXEC);
+    if (filesystems->fd >= 0)
+        filesystems->watch_id = g_unix_fd_add (filesystems->fd, GIOCondition (G_IO_PRI | G_IO_ERR),
+                                               mounts_changed_cb, filesystems);
+#endif
+
+    return filesystems;
+}
+
+void
+systemload_filesystems_free (SystemloadFilesystems *filesystems)
+{
+    if (filesystems == NULL)
+        return;
+
+    if (filesystems->watch_id)
+        g_source_remove (filesystems->watch_id);
+    if (filesystems->fd >= 0)
+        close (filesystems->fd);
+
+    g_strfreev (filesystems->mount_points);
+    if (filesystems->mounts)
+        g_ptr_array_unref (filesystems->mounts);
+    g_ptr_array_unref (filesystems->filesystems);
+    g_free (filesystems);
+}
+
+void
+systemload_filesystems_set_mount_points (SystemloadFilesystems *filesystems, const gchar *mount_points)
+{
+    gchar **split = g_strsplit (mount_points ? mount_points : "", ";", -1);
+    GPtrArray *list = g_ptr_array_new ();
+
+    for (gchar **s = split; *s; s++)
+    {
+        gchar *mount_point = g_strstrip (*s);
+        if (*mount_point)
+            g_ptr_array_add (list, g_strdup (mount_point));
+    }
+    g_ptr_array_add (list, NULL);
+    g_strfreev (split);
+
+    auto new_mount_points = (gchar**) g_ptr_array_free (list, FALSE);
+    if (strv_equal (new_mount_points, filesystems->mount_points))
+    {
+        g_strfreev (new_mount_points);
+        return;
+    }
+
+    g_strfreev (filesystems->mount_points);
+    filesystems->mount_points = new_mount_points;
+    filesystems->changed = true;
+}
+
+void
+systemload_filesystems_update (SystemloadFilesystems *filesystems)
+{
+    if (filesystems->changed)
+    {
+        filesystems->changed = false;
+        if (filesystems->fd >= 0)
+        {
+            if (filesystems->mounts)
+                g_ptr_array_unref (filesystems->mounts);
+            filesystems->mounts = read_mounts ();
+        }
+        select_filesystems (filesystems);
+    }
+
+    for (guint i = 0; i < filesystems->filesystems->len; i++)
+    {
+        auto filesystem = (SystemloadFilesystem*) g_ptr_array_index (filesystems->filesystems, i);
+        struct statvfs buf;
+
+        filesystem->total = filesystem->used = filesystem->available = 0;
+        if (!filesystem->mounted || statvfs (filesystem->mount_point, &buf) != 0)
+            continue;
+
+        filesystem->total = (guint64) buf.f_blocks * buf.f_frsize;
+        filesystem->used = (guint64) (buf.f_blocks - MIN (buf.f_bfree, buf.f_blocks)) * buf.f_frsize;
+        filesystem->available = (guint64) buf.f_bavail * buf.f_frsize;
+    }
+}
+
+guint
+systemload_filesystems_get_n (const SystemloadFilesystems *filesystems)
+{
+    return filesystems->filesystems->len;
+}
+
+const SystemloadFilesystem *
+systemload_filesystems_get (const SystemloadFilesystems *filesystems, guint i)
+{
+    g_return_val_if_fail (i < filesystems->filesystems->len, NULL);
+
+    return (const SystemloadFilesystem*) g_ptr_array_index (filesystems->filesystems, i);
+}
+
+gulong
+systemload_filesystems_get_usage (const SystemloadFilesystems *filesystems)
+{
+    gulong usage = 0;
+
+    for (guint i = 0; i < filesystems->filesystems->len; i++)
+    {
+        auto filesystem = (const SystemloadFilesystem*) g_ptr_array_index (filesystems->filesystems, i);
+
+        /* Like df, relative to the space available to unprivileged users */
+        const guint64 usable = filesystem->used + filesystem->available;
+        if (usable != 0)
+            usage = MAX (usage, (gulong) ((100 * filesystem->used + usable - 1) / usable));
+    }
+
+    return MIN (usage, 100);
+}
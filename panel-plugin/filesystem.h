@@ -0,0 +1,69 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_FILESYSTEM_H_
+#define _XFCE_SYSTEMLOAD_FILESYSTEM_H_
+
+#include <glib.h>
+
+/* Space of a mounted filesystem, as of the last update */
+struct SystemloadFilesystem {
+    gchar   *mount_point;
+    bool     mounted;    /* false if a configured mount point has nothing mounted on it */
+    guint64  total;      /* Bytes */
+    guint64  used;       /* Bytes */
+    guint64  available;  /* Bytes which unprivileged users can still write */
+};
+
+struct SystemloadFilesystems;
+
+/*
+ * Creates the filesystem monitor. On Linux, /proc/self/mountinfo is watched from
+ * the main loop and the mount table is parsed again only when it changes.
+ */
+SystemloadFilesystems      *systemload_filesystems_new              (void);
+void                        systemload_filesystems_free             (SystemloadFilesystems *filesystems);
+
+/*
+ * Sets the mount points to monitor, separated by semicolons. If empty, all local
+ * filesystems backed by a block device are monitored, which requires the mount table of Linux.
+ */
+void                        systemload_filesystems_set_mount_points (SystemloadFilesystems *filesystems,
+                                                                     const gchar           *mount_points);
+
+/* Runs statvfs() on the monitored filesystems. This is meant to be called much less often than the other readers. */
+void                        systemload_filesystems_update           (SystemloadFilesystems *filesystems);
+
+guint                       systemload_filesystems_get_n            (const SystemloadFilesystems *filesystems);
+const SystemloadFilesystem *systemload_filesystems_get              (const SystemloadFilesystems *filesystems,
+                                                                     guint                        i);
+
+/* Usage of the fullest monitored filesystem, as of the last update. Range: 0% ... 100% */
+gulong                      systemload_filesystems_get_usage        (const SystemloadFilesystems *filesystems);
+
+#endif /* _XFCE_SYSTEMLOAD_FILESYSTEM_H_ */
@@ -0,0 +1,312 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+
+#include <gtk/gtk.h>
+
+#include "alert.h"
+#include "heatmap.h"
+
+#define CELL_SIZE 3       /* Pixels */
+#define CELL_SPACING 1
+#define GROUP_SPACING 3
+#define N_LEVELS 16       /* Number of distinct colors */
+#define LEVEL_INVALID 0xff
+
+struct _SystemloadHeatmap {
+    GtkWidget        *widget;
+    GtkOrientation    orientation;
+    GdkRGBA           color;
+
+    guint             n_cells;
+    gint             *group;
+    gint             *x, *y;    /* Position of each cell */
+    guint8           *level;    /* Quantized load of each cell, as painted into the surface */
+
+    gint              thickness;  /* Size across the panel the layout was computed for */
+    cairo_surface_t  *surface;
+    gint              surface_width, surface_height;
+};
+
+static void
+invalidate_cells (SystemloadHeatmap *heatmap)
+{
+    if (heatmap->n_cells)
+        memset (heatmap->level, LEVEL_INVALID, heatmap->n_cells);
+}
+
+static gint
+compare_cells (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    auto group = (const gint*) user_data;
+    guint i = *(const guint*) a, j = *(const guint*) b;
+
+    if (group[i] != group[j])
+        return (group[i] < group[j]) ? -1 : 1;
+    return (i < j) ? -1 : (i > j);
+}
+
+/* Positions the cells for the given thickness and requests the resulting length */
+static void
+layout (SystemloadHeatmap *heatmap, gint thickness)
+{
+    const gint step = CELL_SIZE + CELL_SPACING;
+    const gint rows = MAX (1, (thickness + CELL_SPACING) / step);
+    gint col = 0, row = 0, offset = 0;
+
+    guint *order = g_new (guint, MAX (heatmap->n_cells, 1));
+    for (guint i = 0; i < heatmap->n_cells; i++)
+        order[i] = i;
+    g_qsort_with_data (order, heatmap->n_cells, sizeof (*order), compare_cells, heatmap->group);
+
+    for (guint k = 0; k < heatmap->n_cells; k++)
+    {
+        guint i = order[k];
+        if (k > 0 && heatmap->group[i] != heatmap->group[order[k - 1]])
+        {
+            if (row != 0)
+                col++;
+            row = 0;
+            offset += GROUP_SPACING;
+        }
+
+        gint along = offset + col * step, across = row * step;
+        if (heatmap->orientation == GTK_ORIENTATION_HORIZONTAL)
+            heatmap->x[i] = along, heatmap->y[i] = across;
+        else
+            heatmap->x[i] = across, heatmap->y[i] = along;
+
+        if (++row == rows)
+        {
+            row = 0;
+            col++;
+        }
+    }
+    g_free (order);
+
+    gint length = MAX (offset + (col + (row != 0)) * step - CELL_SPACING, CELL_SIZE);
+    if (heatmap->orientation == GTK_ORIENTATION_HORIZONTAL)
+        gtk_widget_set_size_request (heatmap->widget, length, -1);
+    else
+        gtk_widget_set_size_request (heatmap->widget, -1, length);
+
+    /* The cells painted at their old positions must not stay in the surface, ensure_surface() recreates it */
+    if (heatmap->surface)
+    {
+        cairo_surface_destroy (heatmap->surface);
+        heatmap->surface = NULL;
+    }
+
+    heatmap->thickness = thickness;
+    invalidate_cells (heatmap);
+    gtk_widget_queue_draw (heatmap->widget);
+}
+
+static void
+relayout (SystemloadHeatmap *heatmap)
+{
+    GtkAllocation alloc;
+    gtk_widget_get_allocation (heatmap->widget, &alloc);
+    layout (heatmap, (heatmap->orientation == GTK_ORIENTATION_HORIZONTAL) ? alloc.height : alloc.width);
+}
+
+static void
+paint_cell (SystemloadHeatmap *heatmap, cairo_t *cr, guint i, guint8 level)
+{
+    GdkRGBA color = heatmap->color;
+    color.alpha *= 0.15 + 0.85 * level / (N_LEVELS - 1);
+
+    cairo_rectangle (cr, heatmap->x[i], heatmap->y[i], CELL_SIZE, CELL_SIZE);
+    gdk_cairo_set_source_rgba (cr, &color);
+    cairo_fill (cr);
+}
+
+static void
+size_allocate_cb (GtkWidget *widget, GdkRectangle *alloc, SystemloadHeatmap *heatmap)
+{
+    gint thickness = (heatmap->orientation == GTK_ORIENTATION_HORIZONTAL) ? alloc->height : alloc->width;
+    if (thickness != heatmap->thickness)
+        layout (heatmap, thickness);
+}
+
+static gboolean
+draw_cb (GtkWidget *widget, cairo_t *cr, SystemloadHeatmap *heatmap)
+{
+    if (gtk_style_context_has_class (gtk_widget_get_style_context (widget), "alert"))
+    {
+        GdkRGBA color;
+        gdk_rgba_parse (&color, ALERT_COLOR);
+        color.alpha = 0.4;
+        gdk_cairo_set_source_rgba (cr, &color);
+        cairo_paint (cr);
+    }
+
+    if (heatmap->surface)
+    {
+        cairo_set_source_surface (cr, heatmap->surface, 0, 0);
+        cairo_paint (cr);
+    }
+
+    return FALSE;
+}
+
+static void
+destroy_cb (GtkWidget *widget, SystemloadHeatmap *heatmap)
+{
+    if (heatmap->surface)
+        cairo_surface_destroy (heatmap->surface);
+    g_free (heatmap->group);
+    g_free (heatmap->x);
+    g_free (heatmap->y);
+    g_free (heatmap->level);
+    g_free (heatmap);
+}
+
+/* (Re)creates the surface if the size of the widget changed. Returns false if the widget is not realized. */
+static bool
+ensure_surface (SystemloadHeatmap *heatmap)
+{
+    GdkWindow *window = gtk_widget_get_window (heatmap->widget);
+    if (window == NULL)
+        return false;
+
+    const gint width = gtk_widget_get_allocated_width (heatmap->widget);
+    const gint height = gtk_widget_get_allocated_height (heatmap->widget);
+    if (heatmap->surface && heatmap->surface_width == width && heatmap->surface_height == height)
+        return true;
+
+    if (heatmap->surface)
+        cairo_surface_destroy (heatmap->surface);
+    heatmap->surface = gdk_window_create_similar_image_surface (window, CAIRO_FORMAT_ARGB32, width, height,
+                                                                gtk_widget_get_scale_factor (heatmap->widget));
+    heatmap->surface_width = width;
+    heatmap->surface_height = height;
+    invalidate_cells (heatmap);
+    gtk_widget_queue_draw (heatmap->widget);
+    return true;
+}
+
+
+
+SystemloadHeatmap *
+systemload_heatmap_new (void)
+{
+    SystemloadHeatmap *heatmap = g_new0 (SystemloadHeatmap, 1);
+
+    heatmap->widget = gtk_drawing_area_new ();
+    heatmap->orientation = GTK_ORIENTATION_HORIZONTAL;
+    heatmap->color.alpha = 1;
+    heatmap->thickness = -1;
+
+    g_signal_connect (G_OBJECT (heatmap->widget), "size-allocate", G_CALLBACK (size_allocate_cb), heatmap);
+    g_signal_connect (G_OBJECT (heatmap->widget), "draw", G_CALLBACK (draw_cb), heatmap);
+    g_signal_connect (G_OBJECT (heatmap->widget), "destroy", G_CALLBACK (destroy_cb), heatmap);
+
+    return heatmap;
+}
+
+GtkWidget *
+systemload_heatmap_get_widget (SystemloadHeatmap *heatmap)
+{
+    return heatmap->widget;
+}
+
+guint
+systemload_heatmap_get_n_cells (const SystemloadHeatmap *heatmap)
+{
+    return heatmap->n_cells;
+}
+
+void
+systemload_heatmap_set_orientation (SystemloadHeatmap *heatmap, GtkOrientation orientation)
+{
+    if (heatmap->orientation != orientation)
+    {
+        heatmap->orientation = orientation;
+        heatmap->thickness = -1;
+        relayout (heatmap);
+    }
+}
+
+void
+systemload_heatmap_set_color (SystemloadHeatmap *heatmap, const GdkRGBA *color)
+{
+    if (!gdk_rgba_equal (&heatmap->color, color))
+    {
+        heatmap->color = *color;
+        invalidate_cells (heatmap);
+    }
+}
+
+void
+systemload_heatmap_set_cells (SystemloadHeatmap *heatmap, guint n_cells, const gint *group)
+{
+    heatmap->n_cells = n_cells;
+    heatmap->group = g_renew (gint, heatmap->group, MAX (n_cells, 1));
+    heatmap->x = g_renew (gint, heatmap->x, MAX (n_cells, 1));
+    heatmap->y = g_renew (gint, heatmap->y, MAX (n_cells, 1));
+    heatmap->level = g_renew (guint8, heatmap->level, MAX (n_cells, 1));
+
+    for (guint i = 0; i < n_cells; i++)
+        heatmap->group[i] = group ? group[i] : 0;
+
+    relayout (heatmap);
+}
+
+void
+systemload_heatmap_update (SystemloadHeatmap *heatmap, const guint8 *loads)
+{
+    cairo_t *cr = NULL;
+
+    if (!ensure_surface (heatmap))
+        return;
+
+    for (guint i = 0; i < heatmap->n_cells; i++)
+    {
+        guint8 level = (MIN (loads[i], 100) * (N_LEVELS - 1) + 50) / 100;
+        if (level == heatmap->level[i])
+            continue;
+
+        if (cr == NULL)
+        {
+            cr = cairo_create (heatmap->surface);
+            cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+        }
+        paint_cell (heatmap, cr, i, level);
+        heatmap->level[i] = level;
+        gtk_widget_queue_draw_area (heatmap->widget, heatmap->x[i], heatmap->y[i], CELL_SIZE, CELL_SIZE);
+    }
+
+    if (cr)
+        cairo_destroy (cr);
+}
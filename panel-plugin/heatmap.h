@@ -0,0 +1,65 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_HEATMAP_H_
+#define _XFCE_SYSTEMLOAD_HEATMAP_H_
+
+#include <gtk/gtk.h>
+
+/*
+ * A grid with one cell per CPU core, colored by load.
+ *
+ * The cells are drawn into a cached image surface. An update only repaints the cells
+ * whose quantized color changed, and only those areas of the widget are invalidated.
+ * The heatmap is freed together with its widget.
+ */
+typedef struct _SystemloadHeatmap SystemloadHeatmap;
+
+SystemloadHeatmap *systemload_heatmap_new             (void);
+GtkWidget         *systemload_heatmap_get_widget      (SystemloadHeatmap *heatmap);
+guint              systemload_heatmap_get_n_cells     (const SystemloadHeatmap *heatmap);
+
+/* The orientation of the panel: in horizontal panels, the cells fill columns from the top */
+void               systemload_heatmap_set_orientation (SystemloadHeatmap *heatmap,
+                                                       GtkOrientation     orientation);
+void               systemload_heatmap_set_color       (SystemloadHeatmap *heatmap,
+                                                       const GdkRGBA     *color);
+
+/*
+ * Sets the number of cells. Cells with the same group are placed next to each other,
+ * and groups are separated by a gap. group can be NULL.
+ */
+void               systemload_heatmap_set_cells       (SystemloadHeatmap *heatmap,
+                                                       guint              n_cells,
+                                                       const gint        *group);
+
+/* loads[i] is the load of cell i in percent */
+void               systemload_heatmap_update          (SystemloadHeatmap *heatmap,
+                                                       const guint8      *loads);
+
+#endif /* _XFCE_SYSTEMLOAD_HEATMAP_H_ */
@@ -0,0 +1,260 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "history.h"
+
+#define HISTORY_MAGIC        "XSLHIST"
+#define HISTORY_VERSION      1
+#define HISTORY_CAPACITY     8192
+#define HISTORY_MAX_MONITORS 16
+
+/* Bit in t_history_record::enabled for the uptime */
+#define HISTORY_UPTIME_BIT   15
+
+struct t_history_header {
+    gchar    magic[8];
+    guint32  version;
+    guint32  record_size;
+    guint32  capacity;
+    guint32  reserved;
+    guint64  count;          /* Number of records appended so far; this is the write cursor */
+};
+
+/* All fields have a fixed width, the file is only read on the machine which wrote it */
+struct t_history_record {
+    guint64  seq;            /* Index of the record + 1, stored last; 0 or a stale value marks a torn record */
+    gint64   time;
+    guint64  mem_total, mem_used, swap_total, swap_used;
+    guint64  net_bits;
+    guint32  uptime;
+    guint16  enabled;        /* Bit i: monitor i was enabled */
+    guint8   value[HISTORY_MAX_MONITORS];
+    guint8   padding[2];
+};
+
+G_STATIC_ASSERT (sizeof (t_history_header) == 32);
+G_STATIC_ASSERT (sizeof (t_history_record) == 80);
+G_STATIC_ASSERT (N_MONITORS <= HISTORY_MAX_MONITORS && N_MONITORS <= HISTORY_UPTIME_BIT);
+
+#define HISTORY_FILE_SIZE (sizeof (t_history_header) + HISTORY_CAPACITY * sizeof (t_history_record))
+
+struct _SystemloadHistory {
+    gpointer           map;
+    t_history_header  *header;
+    t_history_record  *records;
+};
+
+
+
+static gchar *
+history_dir ()
+{
+#if GLIB_CHECK_VERSION (2, 72, 0)
+    return g_build_filename (g_get_user_state_dir (), "xfce4", "systemload", NULL);
+#else
+    const gchar *state_home = g_getenv ("XDG_STATE_HOME");
+    if (state_home && g_path_is_absolute (state_home))
+        return g_build_filename (state_home, "xfce4", "systemload", NULL);
+    else
+        return g_build_filename (g_get_home_dir (), ".local", "state", "xfce4", "systemload", NULL);
+#endif
+}
+
+static bool
+header_valid (const t_history_header *header)
+{
+    return memcmp (header->magic, HISTORY_MAGIC, sizeof (HISTORY_MAGIC)) == 0 &&
+           header->version == HISTORY_VERSION &&
+           header->record_size == sizeof (t_history_record) &&
+           header->capacity == HISTORY_CAPACITY;
+}
+
+SystemloadHistory *
+systemload_history_open (const gchar *name)
+{
+    g_return_val_if_fail (name != NULL, NULL);
+
+    gchar *dir = history_dir ();
+    gchar *filename = g_strconcat (name, ".history", NULL);
+    gchar *path = g_build_filename (dir, filename, NULL);
+    g_free (filename);
+
+    gint fd = -1;
+    if (g_mkdir_with_parents (dir, 0700) == 0)
+        fd = g_open (path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    g_free (dir);
+    if (fd < 0)
+    {
+        g_warning ("Cannot open history file '%s': %s", path, g_strerror (errno));
+        g_free (path);
+        return NULL;
+    }
+
+    /*
+     * Reserve the blocks of the file up front. Storing into a hole of a sparse file
+     * would raise SIGBUS if the filesystem runs out of space.
+     */
+    struct stat st;
+    bool fresh = (fstat (fd, &st) != 0 || (gsize) st.st_size != HISTORY_FILE_SIZE);
+#ifdef HAVE_POSIX_FALLOCATE
+    if (fresh && (ftruncate (fd, 0) != 0 || posix_fallocate (fd, 0, HISTORY_FILE_SIZE) != 0))
+#else
+    if (fresh && (ftruncate (fd, 0) != 0 || ftruncate (fd, HISTORY_FILE_SIZE) != 0))
+#endif
+    {
+        g_warning ("Cannot allocate history file '%s'", path);
+        close (fd);
+        g_free (path);
+        return NULL;
+    }
+
+    gpointer map = mmap (NULL, HISTORY_FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close (fd);
+    if (map == MAP_FAILED)
+    {
+        g_warning ("Cannot map history file '%s': %s", path, g_strerror (errno));
+        g_free (path);
+        return NULL;
+    }
+    g_free (path);
+
+    SystemloadHistory *history = g_new0 (SystemloadHistory, 1);
+    history->map = map;
+    history->header = (t_history_header*) map;
+    history->records = (t_history_record*) (history->header + 1);
+
+    if (fresh || !header_valid (history->header))
+    {
+        memset (map, 0, HISTORY_FILE_SIZE);
+        memcpy (history->header->magic, HISTORY_MAGIC, sizeof (HISTORY_MAGIC));
+        history->header->version = HISTORY_VERSION;
+        history->header->record_size = sizeof (t_history_record);
+        history->header->capacity = HISTORY_CAPACITY;
+    }
+
+    return history;
+}
+
+void
+systemload_history_close (SystemloadHistory *history)
+{
+    if (history == NULL)
+        return;
+
+    munmap (history->map, HISTORY_FILE_SIZE);
+    g_free (history);
+}
+
+void
+systemload_history_append (SystemloadHistory *history, const SystemloadSnapshot *snapshot)
+{
+    g_return_if_fail (history != NULL);
+
+    const guint64 count = history->header->count;
+    t_history_record *r = &history->records[count % HISTORY_CAPACITY];
+
+    /*
+     * Invalidate the slot before overwriting it, and publish it by storing the sequence number
+     * and then the cursor. The barrier keeps the compiler from reordering the stores.
+     */
+    r->seq = 0;
+    __atomic_signal_fence (__ATOMIC_SEQ_CST);
+
+    r->time = snapshot->time;
+    r->mem_total = snapshot->mem_total;
+    r->mem_used = snapshot->mem_used;
+    r->swap_total = snapshot->swap_total;
+    r->swap_used = snapshot->swap_used;
+    r->net_bits = snapshot->net_bits;
+    r->uptime = snapshot->uptime;
+    r->enabled = snapshot->uptime_enabled ? (1 << HISTORY_UPTIME_BIT) : 0;
+    for (gsize i = 0; i < N_MONITORS; i++)
+    {
+        r->enabled |= snapshot->enabled[i] ? (1 << i) : 0;
+        r->value[i] = MIN (snapshot->value[i], 100);
+    }
+
+    __atomic_signal_fence (__ATOMIC_SEQ_CST);
+    r->seq = count + 1;
+    __atomic_signal_fence (__ATOMIC_SEQ_CST);
+    history->header->count = count + 1;
+}
+
+guint
+systemload_history_get_length (const SystemloadHistory *history)
+{
+    g_return_val_if_fail (history != NULL, 0);
+
+    return MIN (history->header->count, HISTORY_CAPACITY);
+}
+
+bool
+systemload_history_get (const SystemloadHistory *history, guint age, SystemloadSnapshot *snapshot)
+{
+    g_return_val_if_fail (history != NULL, false);
+
+    const guint64 count = history->header->count;
+    if (age >= MIN (count, HISTORY_CAPACITY))
+        return false;
+
+    const guint64 index = count - 1 - age;
+    const t_history_record *r = &history->records[index % HISTORY_CAPACITY];
+    if (r->seq != index + 1)
+        return false;
+
+    memset (snapshot, 0, sizeof (*snapshot));
+    snapshot->time = r->time;
+    snapshot->mem_total = r->mem_total;
+    snapshot->mem_used = r->mem_used;
+    snapshot->swap_total = r->swap_total;
+    snapshot->swap_used = r->swap_used;
+    snapshot->net_bits = r->net_bits;
+    snapshot->uptime = r->uptime;
+    snapshot->uptime_enabled = (r->enabled & (1 << HISTORY_UPTIME_BIT)) != 0;
+    for (gsize i = 0; i < N_MONITORS; i++)
+    {
+        snapshot->enabled[i] = (r->enabled & (1 << i)) != 0;
+        snapshot->value[i] = r->value[i];
+    }
+
+    return true;
+}
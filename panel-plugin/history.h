@@ -0,0 +1,59 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_HISTORY_H_
+#define _XFCE_SYSTEMLOAD_HISTORY_H_
+
+#include <glib.h>
+
+#include "snapshot.h"
+
+/*
+ * A fixed-size ring buffer of snapshots, kept in a memory-mapped file in the user's
+ * state directory so that it survives restarts of the panel.
+ *
+ * Appending a snapshot only stores into the mapping. If the process dies in the middle
+ * of an append, at most the record being written is lost.
+ */
+typedef struct _SystemloadHistory SystemloadHistory;
+
+/* Returns NULL if the history file cannot be created or mapped */
+SystemloadHistory *systemload_history_open       (const gchar              *name);
+void               systemload_history_close      (SystemloadHistory        *history);
+void               systemload_history_append     (SystemloadHistory        *history,
+                                                  const SystemloadSnapshot *snapshot);
+
+/* The number of records which can be retrieved */
+guint              systemload_history_get_length (const SystemloadHistory  *history);
+
+/* Age 0 is the most recent record. Returns false if the record is missing or torn. */
+bool               systemload_history_get        (const SystemloadHistory  *history,
+                                                  guint                     age,
+                                                  SystemloadSnapshot       *snapshot);
+
+#endif /* _XFCE_SYSTEMLOAD_HISTORY_H_ */
@@ -0,0 +1,375 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include "irqstat.h"
+#include "procfile.h"
+#include "procparse.h"
+#include "toplist.h"
+
+#define PROC_INTERRUPTS "/proc/interrupts"
+#define PROC_SOFTIRQS   "/proc/softirqs"
+
+/*
+ * One of the files: a header with a "CPUn" column per online CPU, then a row per source
+ * with a "label:", a count per column, and in /proc/interrupts a description.
+ * The counts are kept row-major in single arrays, so a row is parsed into consecutive memory
+ * and the work per tick grows linearly with the number of columns.
+ */
+struct t_irq_table {
+    SystemloadProcFile *file;
+    gchar    *header;    /* The header line of the layout below, NULL before the first reading */
+    guint     n_cols;
+    guint    *col_cpu;   /* CPU of every column */
+    guint     n_rows;
+    GPtrArray *labels;   /* Label of every row, without the colon */
+    GPtrArray *names;
+    bool     *per_cpu;   /* The row had a count for every column in the last reading, "ERR" and "MIS" have one total */
+    guint64  *counts;    /* n_rows × n_cols, of the previous reading */
+    guint64  *delta;     /* n_rows × n_cols, since the previous reading */
+    guint64  *row;       /* n_cols, the row being parsed */
+    bool      primed;    /* counts holds a reading of this layout */
+};
+
+struct SystemloadIrqSampler {
+    t_irq_table interrupts, softirqs;
+    guint64  *cpu_delta;  /* Sum of both tables by CPU number */
+    guint     max_cpus;
+    gint64    time;       /* Of the previous reading, 0 before the first one */
+};
+
+SystemloadIrqSampler *
+systemload_irq_sampler_new (void)
+{
+    return g_new0 (SystemloadIrqSampler, 1);
+}
+
+static void
+table_clear (t_irq_table *table)
+{
+    g_clear_pointer (&table->header, g_free);
+    g_clear_pointer (&table->labels, g_ptr_array_unref);
+    g_clear_pointer (&table->names, g_ptr_array_unref);
+    g_clear_pointer (&table->col_cpu, g_free);
+    g_clear_pointer (&table->per_cpu, g_free);
+    g_clear_pointer (&table->counts, g_free);
+    g_clear_pointer (&table->delta, g_free);
+    g_clear_pointer (&table->row, g_free);
+    table->n_cols = table->n_rows = 0;
+    table->primed = false;
+}
+
+void
+systemload_irq_sampler_free (SystemloadIrqSampler *sampler)
+{
+    if (!sampler)
+        return;
+    table_clear (&sampler->interrupts);
+    table_clear (&sampler->softirqs);
+    if (sampler->interrupts.file)
+        systemload_procfile_close (sampler->interrupts.file);
+    if (sampler->softirqs.file)
+        systemload_procfile_close (sampler->softirqs.file);
+    g_free (sampler->cpu_delta);
+    g_free (sampler);
+}
+
+/* Returns the length of the label of a row, which starts at s after the indentation, or 0 */
+static gsize
+label_length (const gchar *s, const gchar *eol)
+{
+    const gchar *colon = (const gchar*) memchr (s, ':', eol - s);
+    return colon ? colon - s : 0;
+}
+
+static const gchar *
+skip_spaces (const gchar *s)
+{
+    while (*s == ' ')
+        s++;
+    return s;
+}
+
+/* The name shown for a row: the label, and for numbered interrupt lines the device, which ends the line */
+static gchar *
+row_name (const gchar *label, gsize label_len, const gchar *eol)
+{
+    if (!g_ascii_isdigit (*label))
+        return g_strndup (label, label_len);
+
+    const gchar *device = eol;
+    while (device > label + label_len && device[-1] == ' ')
+        device--;
+    const gchar *end = device;
+    while (device > label + label_len && device[-1] != ' ')
+        device--;
+    if (device == end || g_ascii_isdigit (*device))
+        return g_strndup (label, label_len);
+    return g_strdup_printf ("%.*s %.*s", (gint) label_len, label, (gint) (end - device), device);
+}
+
+static void
+table_build (t_irq_table *table, const gchar *buf)
+{
+    table_clear (table);
+
+    const gchar *eol = systemload_find_eol (buf);
+    table->header = g_strndup (buf, eol - buf);
+
+    /* The numbers of the "CPUn" labels are the only digits in the header */
+    GArray *cpus = g_array_new (FALSE, FALSE, sizeof (guint));
+    for (const gchar *s = buf; (s = strstr (s, "CPU")) != NULL && s < eol; s += 3)
+    {
+        guint cpu = strtoul (s + 3, NULL, 10);
+        g_array_append_val (cpus, cpu);
+    }
+    table->n_cols = cpus->len;
+    table->col_cpu = (guint*) g_array_free (cpus, FALSE);
+
+    table->labels = g_ptr_array_new_with_free_func (g_free);
+    table->names = g_ptr_array_new_with_free_func (g_free);
+    for (const gchar *line = (*eol == '\n') ? eol + 1 : eol; *line; )
+    {
+        const gchar *label = skip_spaces (line);
+        eol = systemload_find_eol (label);
+        const gsize len = label_length (label, eol);
+        if (len != 0)
+        {
+            g_ptr_array_add (table->labels, g_strndup (label, len));
+            g_ptr_array_add (table->names, row_name (label, len, eol));
+        }
+        line = (*eol == '\n') ? eol + 1 : eol;
+    }
+    table->n_rows = table->labels->len;
+    table->per_cpu = g_new0 (bool, table->n_rows);
+
+    table->counts = g_new0 (guint64, (gsize) table->n_rows * table->n_cols);
+    table->delta = g_new0 (guint64, (gsize) table->n_rows * table->n_cols);
+    table->row = g_new0 (guint64, MAX (table->n_cols, 1));
+}
+
+/*
+ * Parses the rows into table->delta, returns false if they do not match the layout.
+ * When the file was truncated, the rows which are missing at its end have no delta,
+ * and rows beyond the layout are ignored: which rows fit varies with the width of the counts.
+ */
+static bool
+table_parse (t_irq_table *table, const gchar *buf, bool truncated)
+{
+    const guint n_cols = table->n_cols;
+    const gchar *line = systemload_find_eol (buf);
+    guint r = 0;
+
+    for (line = (*line == '\n') ? line + 1 : line; *line; )
+    {
+        const gchar *label = skip_spaces (line);
+        const gchar *eol = systemload_find_eol (label);
+        if (label_length (label, eol) == 0)
+        {
+            line = (*eol == '\n') ? eol + 1 : eol;
+            continue;
+        }
+
+        /* A driver registered or released an interrupt line */
+        if (r == table->n_rows)
+        {
+            if (truncated)
+                break;
+            return false;
+        }
+        const gchar *expected = (const gchar*) g_ptr_array_index (table->labels, r);
+        const gsize len = strlen (expected);
+        if (strncmp (label, expected, len) != 0 || label[len] != ':')
+            return false;
+
+        guint n = systemload_parse_uints_wide (label + len + 1, table->row, n_cols, &line);
+        guint64 *counts = table->counts + (gsize) r * n_cols;
+        guint64 *delta = table->delta + (gsize) r * n_cols;
+        const bool primed = table->primed && table->per_cpu[r];
+        table->per_cpu[r] = n == n_cols;
+        if (table->per_cpu[r])
+        {
+            for (guint c = 0; c < n_cols; c++)
+            {
+                delta[c] = (primed && table->row[c] >= counts[c]) ? table->row[c] - counts[c] : 0;
+                counts[c] = table->row[c];
+            }
+        }
+        else
+            memset (delta, 0, n_cols * sizeof (*delta));
+        r++;
+    }
+
+    if (r < table->n_rows && !truncated)
+        return false;
+
+    /* Counts which reappear later are compared with the next reading only */
+    for (; r < table->n_rows; r++)
+    {
+        table->per_cpu[r] = false;
+        memset (table->delta + (gsize) r * n_cols, 0, n_cols * sizeof (*table->delta));
+    }
+    return true;
+}
+
+/*
+ * Parses the counts into table->delta. Returns false if the file cannot be read, then the
+ * table is skipped. Leaves the deltas 0 if its layout changed or it was not read before.
+ */
+static bool
+table_read (t_irq_table *table, const gchar *path)
+{
+    if (!table->file && (table->file = systemload_procfile_open (path)) == NULL)
+        return false;
+    const gchar *buf = systemload_procfile_read (table->file, NULL);
+    if (!buf)
+    {
+        /* The deltas are those of the previous reading, and the counts are too old for the next one */
+        table->primed = false;
+        return false;
+    }
+    const bool truncated = systemload_procfile_is_truncated (table->file);
+
+    const gchar *eol = systemload_find_eol (buf);
+    if (!table->header || strncmp (buf, table->header, eol - buf) != 0 || table->header[eol - buf] != '\0')
+        table_build (table, buf);
+
+    if (!table_parse (table, buf, truncated))
+    {
+        table_build (table, buf);
+        table_parse (table, buf, truncated);
+    }
+    table->primed = true;
+    return true;
+}
+
+gint
+read_irqstat (SystemloadIrqSampler *sampler, SystemloadIrqStat *stat)
+{
+    memset (stat, 0, sizeof (*stat));
+
+    bool interrupts = table_read (&sampler->interrupts, PROC_INTERRUPTS);
+    bool softirqs = table_read (&sampler->softirqs, PROC_SOFTIRQS);
+    if (!interrupts && !softirqs)
+        return -1;
+
+    const gint64 time = systemload_procfile_get_time ();
+    const gdouble seconds = (sampler->time != 0 && time > sampler->time) ? (time - sampler->time) / 1e6 : 0;
+    sampler->time = time;
+    if (seconds == 0)
+        return 0;
+
+    if (sampler->cpu_delta)
+        memset (sampler->cpu_delta, 0, sampler->max_cpus * sizeof (*sampler->cpu_delta));
+
+    guint n_online = 0;
+    guint64 total = 0;
+    const t_irq_table *tables[] = { &sampler->interrupts, &sampler->softirqs };
+    for (const t_irq_table *table : tables)
+    {
+        if (!table->primed)
+            continue;
+        n_online = MAX (n_online, table->n_cols);
+
+        for (guint c = 0; c < table->n_cols; c++)
+        {
+            if (table->col_cpu[c] >= sampler->max_cpus)
+            {
+                guint old_max = sampler->max_cpus;
+                sampler->max_cpus = MAX (table->col_cpu[c] + 1, 2 * old_max);
+                sampler->cpu_delta = g_renew (guint64, sampler->cpu_delta, sampler->max_cpus);
+                memset (sampler->cpu_delta + old_max, 0, (sampler->max_cpus - old_max) * sizeof (*sampler->cpu_delta));
+            }
+        }
+
+        for (guint r = 0; r < table->n_rows; r++)
+        {
+            if (!table->per_cpu[r])
+                continue;
+
+            const guint64 *delta = table->delta + (gsize) r * table->n_cols;
+            guint64 sum = 0, top = 0;
+            guint top_col = 0;
+            for (guint c = 0; c < table->n_cols; c++)
+            {
+                sum += delta[c];
+                sampler->cpu_delta[table->col_cpu[c]] += delta[c];
+                if (delta[c] > top)
+                {
+                    top = delta[c];
+                    top_col = c;
+                }
+            }
+            total += sum;
+            if (sum == 0)
+                continue;
+
+            guint i;
+            SYSTEMLOAD_TOP_INSERT_POSITION (stat->sources, stat->n_sources, IRQ_TOP_N, rate, sum / seconds, i);
+            if (i < IRQ_TOP_N)
+            {
+                SystemloadIrqSource *source = &stat->sources[i];
+                g_strlcpy (source->name, (const gchar*) g_ptr_array_index (table->names, r), sizeof (source->name));
+                source->rate = sum / seconds;
+                source->top_cpu = table->col_cpu[top_col];
+                source->top_share = 100.0 * top / sum;
+            }
+        }
+    }
+
+    guint64 top = 0;
+    for (guint cpu = 0; cpu < sampler->max_cpus; cpu++)
+    {
+        if (sampler->cpu_delta[cpu] == 0)
+            continue;
+        top = MAX (top, sampler->cpu_delta[cpu]);
+        guint i;
+        SYSTEMLOAD_TOP_INSERT_POSITION (stat->cpus, stat->n_cpus, IRQ_TOP_N, rate, sampler->cpu_delta[cpu] / seconds, i);
+        if (i < IRQ_TOP_N)
+        {
+            stat->cpus[i].cpu = cpu;
+            stat->cpus[i].rate = sampler->cpu_delta[cpu] / seconds;
+        }
+    }
+
+    stat->rate = total / seconds;
+    /* The share of the busiest CPU, scaled from 1/n (even) ... 1 (one CPU) to 0 ... 100% */
+    if (total != 0 && n_online > 1)
+        stat->concentration = MIN (lround (100 * ((gdouble) top / total * n_online - 1) / (n_online - 1)), 100);
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_IRQSTAT_H_
+#define _XFCE_SYSTEMLOAD_IRQSTAT_H_
+
+#include <glib.h>
+
+/* Number of sources and CPUs listed in SystemloadIrqStat */
+#define IRQ_TOP_N 5
+
+/* An interrupt line of /proc/interrupts or a softirq of /proc/softirqs */
+struct SystemloadIrqSource {
+    gchar    name[32];   /* "NET_RX", or the number and the device of an interrupt line, like "24 eth0" */
+    gdouble  rate;       /* Per second, over all the CPUs */
+    guint    top_cpu;    /* The CPU which handled most of them */
+    gdouble  top_share;  /* Percent handled by top_cpu */
+};
+
+struct SystemloadIrqCpu {
+    guint    cpu;
+    gdouble  rate;       /* Interrupts and softirqs per second */
+};
+
+/* Rates since the previous reading, all 0 for the first one */
+struct SystemloadIrqStat {
+    gdouble  rate;           /* Interrupts and softirqs per second, over all the CPUs */
+    guint    concentration;  /* 0% if spread evenly over the online CPUs, 100% if all on one CPU */
+    guint    n_sources;      /* The busiest sources, by rate */
+    SystemloadIrqSource sources[IRQ_TOP_N];
+    guint    n_cpus;         /* The busiest CPUs, by rate */
+    SystemloadIrqCpu cpus[IRQ_TOP_N];
+};
+
+/* The layout and the previous counters of /proc/interrupts and /proc/softirqs */
+struct SystemloadIrqSampler;
+
+SystemloadIrqSampler *systemload_irq_sampler_new  (void);
+void                  systemload_irq_sampler_free (SystemloadIrqSampler *sampler);
+
+/*
+ * The rows and the CPU columns of both files are looked up when their header or labels change,
+ * a reading then only parses the numbers. Returns -1 if neither file can be read, which is
+ * always the case on platforms other than Linux.
+ */
+gint read_irqstat (SystemloadIrqSampler *sampler, SystemloadIrqStat *stat);
+
+#endif /* _XFCE_SYSTEMLOAD_IRQSTAT_H_ */
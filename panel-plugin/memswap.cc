@@ -45,45 +45,23 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "procfile.h"
 
-#define MEMINFOBUFSIZE (2 * 1024)
-static char MemInfoBuf[MEMINFOBUFSIZE];
+struct SystemloadMemSampler {
+    SystemloadProcScope *scope;
+    SystemloadProcFile *proc_meminfo;
+    SystemloadProcFile *proc_swaps;
+};
 
-static unsigned long MTotal = 0;
-static unsigned long MFree = 0;
-static unsigned long MBuffers = 0;
-static unsigned long MCached = 0;
-static unsigned long MAvail = 0;
-static unsigned long MUsed = 0;
-static unsigned long STotal = 0;
-static unsigned long SFree = 0;
-static unsigned long SUsed = 0;
-
-gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
+gint read_memswap(SystemloadMemSampler *sampler, gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
 {
-    char *b_MTotal, *b_MFree, *b_MBuffers, *b_MCached, *b_MAvail, *b_STotal, *b_SFree;
+    const char *b_MTotal, *b_MFree, *b_MBuffers, *b_MCached, *b_MAvail, *b_STotal, *b_SFree;
+    unsigned long MTotal = 0, MFree = 0, MBuffers = 0, MCached = 0, MAvail = 0, MUsed = 0;
+    unsigned long STotal = 0, SFree = 0, SUsed = 0;
 
-    const char *filepath = "/proc/meminfo";
-    int fd;
-    if ((fd = open(filepath, O_RDONLY)) < 0)
-    {
-        g_warning ("Cannot open '%s'", filepath);
-        return -1;
-    }
-    ssize_t n = read(fd, MemInfoBuf, MEMINFOBUFSIZE - 1);
-    close(fd);
-    if (n < 0)
-    {
-        g_warning ("Cannot read '%s'", filepath);
-        return -1;
-    }
-    if (n == MEMINFOBUFSIZE - 1)
-    {
-        g_warning ("Internal buffer too small to read '%s'", filepath);
+    const char *MemInfoBuf = read_meminfo(sampler);
+    if (!MemInfoBuf)
         return -1;
-    }
-
-    MemInfoBuf[n] = '\0';
 
     b_MTotal = strstr(MemInfoBuf, "MemTotal");
     if (!b_MTotal || !sscanf(b_MTotal + strlen("MemTotal"), ": %lu", &MTotal))
@@ -185,23 +163,26 @@ static int getsysctl (char *name, void *ptr, size_t len)
     return 0;
 }
 
-static kvm_t *kd = NULL;
+struct SystemloadMemSampler {
+    kvm_t *kd;
+    int kd_init;  /* kvm_open() was attempted */
+};
 
-static int swapmode(int *retavail, int *retfree)
+static int swapmode(SystemloadMemSampler *sampler, int *retavail, int *retfree)
 {
     int n;
     int pagesize = getpagesize();
     struct kvm_swap swapary[1];
-    static int kd_init = TRUE;
 
-    if(kd_init) {
-        kd_init = FALSE;
-        if ((kd = kvm_open("/dev/null", "/dev/null", "/dev/null", 
-                           O_RDONLY, "kvm_open")) == NULL) {
+    if(!sampler->kd_init) {
+        sampler->kd_init = TRUE;
+        if ((sampler->kd = kvm_open("/dev/null", "/dev/null", "/dev/null", 
+                                    O_RDONLY, "kvm_open")) == NULL) {
             g_warning("Cannot read kvm.");
             return -1;
         }
     }
+    kvm_t *kd = sampler->kd;
     if(kd == NULL) {
         return -1;
     }
@@ -223,7 +204,7 @@ static int swapmode(int *retavail, int *retfree)
     return(n);
 }
 
-gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
+gint read_memswap(SystemloadMemSampler *sampler, gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
 {
     int total_pages;
     int free_pages;
@@ -249,7 +230,7 @@ gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST,
     *MU = CONVERT(total_pages-free_pages-inactive_pages);
     *mem = *MU * 100 / *MT;
 
-    if((*swap = swapmode(&swap_avail, &swap_free)) >= 0) {
+    if((*swap = swapmode(sampler, &swap_avail, &swap_free)) >= 0) {
         *ST = swap_avail;
         *SU = (swap_avail - swap_free);
     }
@@ -293,15 +274,15 @@ gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST,
 #include <vm/vm_param.h>
 #endif
 
-static size_t MTotal = 0;
-static size_t MFree = 0;
-static size_t MUsed = 0;
-static size_t STotal = 0;
-static size_t SFree = 0;
-static size_t SUsed = 0;
+/* Nothing is kept between the readings */
+struct SystemloadMemSampler {
+    gint unused;
+};
 
-gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
+gint read_memswap(SystemloadMemSampler *sampler, gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
 {
+    size_t MTotal = 0, MFree = 0, MUsed = 0;
+    size_t STotal = 0, SFree = 0, SUsed = 0;
     int pagesize;
     size_t len;
 
@@ -405,15 +386,15 @@ gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST,
 #include <unistd.h>
 #include <uvm/uvm_param.h>
 
-static size_t MTotal = 0;
-static size_t MFree = 0;
-static size_t MUsed = 0;
-static size_t STotal = 0;
-static size_t SFree = 0;
-static size_t SUsed = 0;
+/* Nothing is kept between the readings */
+struct SystemloadMemSampler {
+    gint unused;
+};
 
-gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
+gint read_memswap(SystemloadMemSampler *sampler, gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
 {
+    size_t MTotal = 0, MFree = 0, MUsed = 0;
+    size_t STotal = 0, SFree = 0, SUsed = 0;
     long pagesize;
     size_t len;
 
@@ -471,22 +452,15 @@ gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST,
 #include <sys/stat.h>
 #include <sys/swap.h>
 #include <kstat.h>
-kstat_ctl_t *kc;
 
-static size_t MTotal = 0;
-static size_t MFree = 0;
-static size_t MUsed = 0;
-static size_t STotal = 0;
-static size_t SFree = 0;
-static size_t SUsed = 0;
-
-void mem_init_stats()
-{
-	kc = kstat_open();
-}
+struct SystemloadMemSampler {
+    kstat_ctl_t *kc;
+};
 
-gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
+gint read_memswap(SystemloadMemSampler *sampler, gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
 {
+    size_t MTotal = 0, MUsed = 0;
+    size_t STotal = 0, SUsed = 0;
     long pagesize;
     struct anoninfo swapinfo;
     kstat_t *ksp;
@@ -495,10 +469,9 @@ gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST,
     pagesize = (long)(sysconf(_SC_PAGESIZE));
 
     /* FIXME use real numbers, not fake data */
-    if (!kc)
-    {
-        mem_init_stats();
-    }
+    if (!sampler->kc)
+        sampler->kc = kstat_open();
+    kstat_ctl_t *kc = sampler->kc;
 
     if (ksp = kstat_lookup(kc, "unix", 0, "system_pages"))
     {
@@ -531,3 +504,139 @@ gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST,
 #else
 #error "Your platform is not yet supported"
 #endif
+
+SystemloadMemSampler *
+systemload_mem_sampler_new (SystemloadProcScope *scope)
+{
+    SystemloadMemSampler *sampler = g_new0 (SystemloadMemSampler, 1);
+#if defined(__linux__) || defined(__FreeBSD_kernel__)
+    sampler->scope = scope;
+#endif
+    return sampler;
+}
+
+void
+systemload_mem_sampler_free (SystemloadMemSampler *sampler)
+{
+    if (!sampler)
+        return;
+#if defined(__linux__) || defined(__FreeBSD_kernel__)
+    if (sampler->proc_meminfo)
+        systemload_procfile_close (sampler->proc_meminfo);
+    if (sampler->proc_swaps)
+        systemload_procfile_close (sampler->proc_swaps);
+#elif defined(__FreeBSD__) || defined(__DragonFly__)
+    if (sampler->kd)
+        kvm_close (sampler->kd);
+#elif defined(__sun__)
+    if (sampler->kc)
+        kstat_close (sampler->kc);
+#endif
+    g_free (sampler);
+}
+
+const gchar *
+read_meminfo (SystemloadMemSampler *sampler)
+{
+#if defined(__linux__) || defined(__FreeBSD_kernel__)
+    const char *filepath = "/proc/meminfo";
+    if (!sampler->proc_meminfo && (sampler->proc_meminfo = systemload_procfile_open_in_scope(sampler->scope, filepath)) == NULL)
+    {
+        g_warning ("Cannot open '%s'", filepath);
+        return NULL;
+    }
+    const char *buf = systemload_procfile_read(sampler->proc_meminfo, NULL);
+    if (!buf)
+        g_warning ("Cannot read '%s'", filepath);
+    return buf;
+#else
+    return NULL;
+#endif
+}
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <sys/sysinfo.h>
+
+gint read_memswap_syscall(SystemloadMemSampler *sampler, gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
+{
+    struct sysinfo info;
+
+    if (sysinfo(&info) != 0)
+    {
+        g_warning ("sysinfo() failed: %s", g_strerror (errno));
+        return -1;
+    }
+
+    /* sysinfo() does not know about the page cache, so the memory usage is an upper bound */
+    const guint64 unit = info.mem_unit ? info.mem_unit : 1;
+    const guint64 mem_total = info.totalram * unit;
+    const guint64 mem_free = (info.freeram + info.bufferram) * unit;
+    const guint64 swap_total = info.totalswap * unit;
+    const guint64 swap_free = info.freeswap * unit;
+
+    if (mem_total == 0)
+        return -1;
+
+    *MT = mem_total >> 10;
+    *MU = (mem_total - MIN(mem_free, mem_total)) >> 10;
+    *ST = swap_total >> 10;
+    *SU = (swap_total - MIN(swap_free, swap_total)) >> 10;
+
+    *mem = *MU * 100 / *MT;
+    *swap = *ST ? *SU * 100 / *ST : 0;
+
+    return 0;
+}
+
+#include "procparse.h"
+
+gint read_swap_devices(SystemloadMemSampler *sampler, gulong *ram_total, gulong *ram_used)
+{
+    *ram_total = 0;
+    *ram_used = 0;
+
+    if (!sampler->proc_swaps && (sampler->proc_swaps = systemload_procfile_open_in_scope(sampler->scope, "/proc/swaps")) == NULL)
+        return -1;
+    const char *line = systemload_procfile_read(sampler->proc_swaps, NULL);
+    if (!line)
+        return -1;
+
+    /* "Filename Type Size Used Priority" after a header line, the sizes are in KiB */
+    line = systemload_find_eol(line);
+    while (*line == '\n')
+    {
+        line++;
+        if (strncmp(line, "/dev/zram", 9) == 0)
+        {
+            /* Skip the filename, the number of the device would be parsed as a value */
+            guint64 fields[2];
+            const char *type = strchr(line, ' ');
+            if (type && systemload_parse_uints(type, fields, 2, NULL) == 2)
+            {
+                *ram_total += fields[0];
+                *ram_used += fields[1];
+            }
+        }
+        line = systemload_find_eol(line);
+    }
+
+    return 0;
+}
+
+#else
+
+gint read_memswap_syscall(SystemloadMemSampler *sampler, gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU)
+{
+    return read_memswap(sampler, mem, swap, MT, MU, ST, SU);
+}
+
+gint read_swap_devices(SystemloadMemSampler *sampler, gulong *ram_total, gulong *ram_used)
+{
+    *ram_total = 0;
+    *ram_used = 0;
+    return -1;
+}
+
+#endif
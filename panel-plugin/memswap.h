@@ -31,6 +31,37 @@
 
 #include <glib.h>
 
-gint read_memswap(gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU);
+#include "procfile.h"
+
+/*
+ * The files and handles used by one consumer of the memory readers.
+ * Readers which run concurrently, for example from a worker thread, each need their own sampler.
+ * The files are read in the given scope, NULL for the regular update. See procfile.h
+ */
+struct SystemloadMemSampler;
+
+SystemloadMemSampler *systemload_mem_sampler_new  (SystemloadProcScope *scope);
+void                  systemload_mem_sampler_free (SystemloadMemSampler *sampler);
+
+gint read_memswap(SystemloadMemSampler *sampler, gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU);
+
+/*
+ * Uses sysinfo() on Linux instead of parsing /proc/meminfo. The memory usage includes the page cache.
+ * On other platforms, this is the same as read_memswap().
+ */
+gint read_memswap_syscall(SystemloadMemSampler *sampler, gulong *mem, gulong *swap, gulong *MT, gulong *MU, gulong *ST, gulong *SU);
+
+/*
+ * Returns the contents of /proc/meminfo, which are read once per tick for all the readers
+ * of the sampler, or NULL. Always NULL on platforms other than Linux.
+ */
+const gchar *read_meminfo(SystemloadMemSampler *sampler);
+
+/*
+ * Reads the size and usage of the swap devices in /proc/swaps which keep their pages compressed
+ * in RAM, which are the zram devices, in KiB. The rest of the swap space is disk-backed.
+ * Returns -1 if this is not supported on the platform.
+ */
+gint read_swap_devices(SystemloadMemSampler *sampler, gulong *ram_total, gulong *ram_used);
 
 #endif /* _XFCE_SYSTEMLOAD_MEMSWAP_H_ */
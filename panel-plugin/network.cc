@@ -32,6 +32,314 @@
 #include <stdio.h>
 #include <string.h>
 #include "network.h"
+#include "procfile.h"
+#include "procparse.h"
+
+/* Re-evaluate the interfaces at least this often, in case a link notification is missed */
+#define NETIF_REFRESH_INTERVAL (60 * G_USEC_PER_SEC)
+
+struct SystemloadNetSampler {
+    SystemloadProcScope *scope;
+    guint64     bytes;  /* Total of the previous reading */
+    gint64      time;
+    gchar      *filter_include, *filter_exclude;
+    GPtrArray  *include_patterns, *exclude_patterns;  /* GPatternSpec */
+    GHashTable *netif_counted;  /* Interface name -> decision, see netif_is_counted() */
+    gint64      netif_time;
+    bool        netif_filter_changed;
+    SystemloadProcFile *proc_net_dev;
+#ifdef __linux__
+    gint        netlink_fd;
+    bool        netlink_failed;
+    GHashTable *links;  /* Interface index -> t_link */
+#endif
+#ifdef HAVE_LIBGTOP
+    gchar     **netlist_interfaces;
+#endif
+};
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+/* What decides whether an interface is counted, other link attributes change all the time */
+struct t_link {
+    gint  master;  /* Interface index of the master, 0 if none */
+    gchar name[IFNAMSIZ];
+};
+
+/* Asks for all the links, the replies arrive on the notification socket */
+static void
+netlink_request_links (gint fd)
+{
+    struct {
+        struct nlmsghdr  header;
+        struct ifinfomsg info;
+    } request;
+
+    memset (&request, 0, sizeof (request));
+    request.header.nlmsg_len = NLMSG_LENGTH (sizeof (request.info));
+    request.header.nlmsg_type = RTM_GETLINK;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.info.ifi_family = AF_UNSPEC;
+    send (fd, &request, request.header.nlmsg_len, MSG_DONTWAIT);
+}
+
+/* Updates the table of links from an RTM_NEWLINK or RTM_DELLINK message, returns whether the link was added, removed or changed */
+static bool
+netlink_update_link (SystemloadNetSampler *sampler, const struct nlmsghdr *header)
+{
+    auto info = (const struct ifinfomsg*) NLMSG_DATA (header);
+    const gpointer key = GINT_TO_POINTER (info->ifi_index);
+
+    if (header->nlmsg_type == RTM_DELLINK)
+        return g_hash_table_remove (sampler->links, key);
+
+    struct t_link link;
+    memset (&link, 0, sizeof (link));
+    gint length = IFLA_PAYLOAD (header);
+    for (auto attr = IFLA_RTA (info); RTA_OK (attr, length); attr = RTA_NEXT (attr, length))
+    {
+        if (attr->rta_type == IFLA_MASTER && RTA_PAYLOAD (attr) >= sizeof (guint32))
+            memcpy (&link.master, RTA_DATA (attr), sizeof (guint32));
+        else if (attr->rta_type == IFLA_IFNAME)
+            memcpy (link.name, RTA_DATA (attr), MIN (RTA_PAYLOAD (attr), sizeof (link.name) - 1));
+    }
+
+    auto known = (struct t_link*) g_hash_table_lookup (sampler->links, key);
+    if (known && known->master == link.master && strcmp (known->name, link.name) == 0)
+        return false;
+
+    if (!known)
+    {
+        known = g_new (struct t_link, 1);
+        g_hash_table_insert (sampler->links, key, known);
+    }
+    *known = link;
+    return true;
+}
+
+/*
+ * Returns whether a link was added, removed or renamed, or got another master, since the last call.
+ * Notifications about anything else, such as the state of a link or a wireless event, are ignored.
+ */
+static bool
+netlink_links_changed (SystemloadNetSampler *sampler)
+{
+    char buf[32*1024];
+    bool changed = false;
+
+    if (sampler->netlink_fd < 0)
+    {
+        if (sampler->netlink_failed)
+            return false;
+
+        sampler->netlink_fd = socket (AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+        if (sampler->netlink_fd >= 0)
+        {
+            struct sockaddr_nl addr;
+            memset (&addr, 0, sizeof (addr));
+            addr.nl_family = AF_NETLINK;
+            addr.nl_groups = RTMGRP_LINK;
+            if (bind (sampler->netlink_fd, (struct sockaddr*) &addr, sizeof (addr)) != 0)
+            {
+                close (sampler->netlink_fd);
+                sampler->netlink_fd = -1;
+            }
+        }
+        if (sampler->netlink_fd < 0)
+        {
+            /* Rely on the periodic refresh */
+            sampler->netlink_failed = true;
+            return false;
+        }
+        netlink_request_links (sampler->netlink_fd);
+    }
+
+    for (;;)
+    {
+        ssize_t n = recv (sampler->netlink_fd, buf, sizeof (buf), MSG_DONTWAIT);
+        if (n > 0)
+        {
+            gint length = n;
+            for (auto header = (const struct nlmsghdr*) buf; NLMSG_OK (header, length); header = NLMSG_NEXT (header, length))
+                if ((header->nlmsg_type == RTM_NEWLINK || header->nlmsg_type == RTM_DELLINK) &&
+                    header->nlmsg_len >= NLMSG_LENGTH (sizeof (struct ifinfomsg)))
+                    changed = netlink_update_link (sampler, header) || changed;
+        }
+        else if (n < 0 && errno == EINTR)
+            continue;
+        else if (n < 0 && errno == ENOBUFS)
+        {
+            /* Notifications were dropped, assume that something changed and catch up with the links */
+            changed = true;
+            netlink_request_links (sampler->netlink_fd);
+        }
+        else
+            break;
+    }
+
+    return changed;
+}
+
+#define SYSFS_NET "/sys/class/net"
+
+/*
+ * Returns whether the traffic of the interface comes from hardware: either the interface
+ * has a device, or it is the master of a hardware-backed interface (bond, team or bridge).
+ * VLANs, veth pairs, tunnels, and bridges of virtual interfaces only carry traffic
+ * which is counted on another interface as well.
+ */
+static bool
+netif_is_hardware (const gchar *name, guint depth)
+{
+    gchar *path = g_strdup_printf (SYSFS_NET "/%s/device", name);
+    bool hardware = g_file_test (path, G_FILE_TEST_EXISTS);
+    g_free (path);
+    if (hardware || depth >= 8)
+        return hardware;
+
+    /* Lower interfaces are linked as "lower_<name>" */
+    path = g_strdup_printf (SYSFS_NET "/%s", name);
+    GDir *dir = g_dir_open (path, 0, NULL);
+    g_free (path);
+    if (!dir)
+        return false;
+
+    const gchar *entry;
+    while (!hardware && (entry = g_dir_read_name (dir)) != NULL)
+    {
+        if (!g_str_has_prefix (entry, "lower_"))
+            continue;
+        const gchar *lower = entry + 6;
+
+        /* Stacked interfaces such as VLANs have a lower interface, but are not its master */
+        path = g_strdup_printf (SYSFS_NET "/%s/master", lower);
+        gchar *master = g_file_read_link (path, NULL);
+        g_free (path);
+        if (master)
+        {
+            gchar *master_name = g_path_get_basename (master);
+            if (strcmp (master_name, name) == 0)
+                hardware = netif_is_hardware (lower, depth + 1);
+            g_free (master_name);
+            g_free (master);
+        }
+    }
+    g_dir_close (dir);
+
+    return hardware;
+}
+
+/* Counts the topmost interface of every stack which is backed by hardware, and nothing else */
+static bool
+netif_counted_by_default (const gchar *name)
+{
+    /* The traffic of slaves is counted on their master */
+    gchar *path = g_strdup_printf (SYSFS_NET "/%s/master", name);
+    bool slave = g_file_test (path, G_FILE_TEST_EXISTS);
+    g_free (path);
+
+    return !slave && netif_is_hardware (name, 0);
+}
+
+#else
+
+static bool
+netlink_links_changed (SystemloadNetSampler *sampler)
+{
+    return false;
+}
+
+static bool
+netif_counted_by_default (const gchar *name)
+{
+    return !g_str_has_prefix (name, "lo");
+}
+
+#endif
+
+static GPtrArray *
+compile_patterns (const gchar *text)
+{
+    GPtrArray *patterns = g_ptr_array_new_with_free_func ((GDestroyNotify) g_pattern_spec_free);
+    gchar **globs = g_strsplit_set (text ? text : "", ",; \t", -1);
+
+    for (gchar **glob = globs; *glob; glob++)
+        if (**glob)
+            g_ptr_array_add (patterns, g_pattern_spec_new (*glob));
+
+    g_strfreev (globs);
+    return patterns;
+}
+
+static bool
+match_patterns (const GPtrArray *patterns, const gchar *name)
+{
+    for (guint i = 0; patterns && i < patterns->len; i++)
+    {
+        auto pattern = (GPatternSpec*) g_ptr_array_index (patterns, i);
+#if GLIB_CHECK_VERSION (2, 70, 0)
+        if (g_pattern_spec_match_string (pattern, name))
+#else
+        if (g_pattern_match_string (pattern, name))
+#endif
+            return true;
+    }
+    return false;
+}
+
+void
+set_netload_filter (SystemloadNetSampler *sampler, const gchar *include, const gchar *exclude)
+{
+    if (sampler->include_patterns &&
+        g_strcmp0 (include, sampler->filter_include) == 0 && g_strcmp0 (exclude, sampler->filter_exclude) == 0)
+        return;
+
+    g_free (sampler->filter_include);
+    g_free (sampler->filter_exclude);
+    sampler->filter_include = g_strdup (include);
+    sampler->filter_exclude = g_strdup (exclude);
+
+    if (sampler->include_patterns)
+        g_ptr_array_unref (sampler->include_patterns);
+    if (sampler->exclude_patterns)
+        g_ptr_array_unref (sampler->exclude_patterns);
+    sampler->include_patterns = compile_patterns (include);
+    sampler->exclude_patterns = compile_patterns (exclude);
+
+    g_hash_table_remove_all (sampler->netif_counted);
+    sampler->netif_filter_changed = true;
+}
+
+/*
+ * An interface matching the include list is always counted, otherwise one matching the
+ * exclude list never is. The remaining interfaces are decided by netif_counted_by_default().
+ * The decisions are cached until the filter or the links change.
+ */
+static bool
+netif_is_counted (SystemloadNetSampler *sampler, const gchar *name)
+{
+    gpointer decision = g_hash_table_lookup (sampler->netif_counted, name);
+    if (decision)
+        return GPOINTER_TO_INT (decision) == 1;
+
+    bool counted;
+    if (match_patterns (sampler->include_patterns, name))
+        counted = true;
+    else if (match_patterns (sampler->exclude_patterns, name))
+        counted = false;
+    else
+        counted = netif_counted_by_default (name);
+
+    g_hash_table_insert (sampler->netif_counted, g_strdup (name), GINT_TO_POINTER (counted ? 1 : 2));
+    return counted;
+}
 
 #ifdef HAVE_LIBGTOP
 
@@ -39,16 +347,23 @@
 #include <glibtop/netload.h>
 
 static gint
-read_netload_libgtop (gulong *bytes)
+read_netload_libgtop (SystemloadNetSampler *sampler, guint64 *bytes, bool links_changed)
 {
-    glibtop_netlist netlist;
-    char **interfaces = glibtop_get_netlist (&netlist);
-    if (!interfaces)
+    if (links_changed || !sampler->netlist_interfaces)
+    {
+        glibtop_netlist netlist;
+        g_strfreev (sampler->netlist_interfaces);
+        sampler->netlist_interfaces = glibtop_get_netlist (&netlist);
+    }
+    if (!sampler->netlist_interfaces)
         return -1;
 
     *bytes = 0;
-    for (char **i = interfaces; *i != NULL; i++)
+    for (char **i = sampler->netlist_interfaces; *i != NULL; i++)
     {
+        if (!netif_is_counted (sampler, *i))
+            continue;
+
         glibtop_netload netload;
         glibtop_get_netload (&netload, *i);
         *bytes += netload.bytes_total;
@@ -60,83 +375,136 @@ read_netload_libgtop (gulong *bytes)
 #else
 
 static gint
-read_netload_libgtop (gulong *bytes)
+read_netload_libgtop (SystemloadNetSampler *sampler, guint64 *bytes, bool links_changed)
 {
     return -1;
 }
 
 #endif
 
-static const char *const PROC_NET_NETSTAT = "/proc/net/netstat";
+static const char *const PROC_NET_DEV = "/proc/net/dev";
 
 static gint
-read_netload_proc (gulong *bytes)
+read_netload_proc (SystemloadNetSampler *sampler, guint64 *bytes)
 {
-    char buf[4*1024];
-    unsigned long long dummy, in_octets, out_octets;
+    if (!sampler->proc_net_dev && (sampler->proc_net_dev = systemload_procfile_open_in_scope (sampler->scope, PROC_NET_DEV)) == NULL)
+        return -1;
 
-    {
-        FILE *fd = fopen (PROC_NET_NETSTAT, "r");
-        if (!fd)
-            return -1;
+    gsize size;
+    const char *s = systemload_procfile_read (sampler->proc_net_dev, &size);
+    if (!s || size == 0)
+        return -1;
 
-        size_t size = fread (buf, sizeof (*buf), G_N_ELEMENTS (buf) - 1, fd);
-        if (size == 0)
-        {
-            fclose(fd);
-            return -1;
-        }
-        buf[size] = '\0';
+    /* The interfaces which did not fit would drop out of the total */
+    if (systemload_procfile_is_truncated (sampler->proc_net_dev))
+        return -1;
 
-        if (fclose (fd) != 0)
+    /* Skip the 2 header lines */
+    for (gint i = 0; i < 2; i++)
+    {
+        s = strchr (s, '\n');
+        if (!s)
             return -1;
+        s++;
     }
 
-    const char *s = buf;
+    /* "  eth0: <8 receive counters> <8 transmit counters>", the bytes come first */
+    *bytes = 0;
+    while (*s)
+    {
+        while (*s == ' ')
+            s++;
+        const char *colon = strchr (s, ':');
+        if (!colon || colon - s >= 64)
+            return -1;
 
-    /* Skip first 3 lines */
-    s = strchr(s, '\n'); if (!s) return -1;
-    s++;
-    s = strchr(s, '\n'); if (!s) return -1;
-    s++;
-    s = strchr(s, '\n'); if (!s) return -1;
-    s++;
+        gchar name[64];
+        memcpy (name, s, colon - s);
+        name[colon - s] = '\0';
 
-    if (sscanf (s, "IpExt: %llu %llu %llu %llu %llu %llu %llu %llu",
-                &dummy, &dummy, &dummy, &dummy, &dummy, &dummy,
-                &in_octets, &out_octets) != 8)
-        return -1;
+        guint64 fields[9];
+        if (systemload_parse_uints (colon + 1, fields, G_N_ELEMENTS (fields), &s) == G_N_ELEMENTS (fields) &&
+            netif_is_counted (sampler, name))
+            *bytes += fields[0] + fields[8];
+    }
 
-    *bytes = in_octets + out_octets;
     return 0;
 }
 
+SystemloadNetSampler *
+systemload_net_sampler_new (SystemloadProcScope *scope)
+{
+    SystemloadNetSampler *sampler = g_new0 (SystemloadNetSampler, 1);
+    sampler->scope = scope;
+    sampler->include_patterns = compile_patterns (NULL);
+    sampler->exclude_patterns = compile_patterns (NULL);
+    sampler->netif_counted = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+#ifdef __linux__
+    sampler->netlink_fd = -1;
+    sampler->links = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+#endif
+    return sampler;
+}
+
+void
+systemload_net_sampler_free (SystemloadNetSampler *sampler)
+{
+    if (!sampler)
+        return;
+    g_free (sampler->filter_include);
+    g_free (sampler->filter_exclude);
+    g_ptr_array_unref (sampler->include_patterns);
+    g_ptr_array_unref (sampler->exclude_patterns);
+    g_hash_table_destroy (sampler->netif_counted);
+    if (sampler->proc_net_dev)
+        systemload_procfile_close (sampler->proc_net_dev);
+#ifdef __linux__
+    if (sampler->netlink_fd >= 0)
+        close (sampler->netlink_fd);
+    g_hash_table_destroy (sampler->links);
+#endif
+#ifdef HAVE_LIBGTOP
+    g_strfreev (sampler->netlist_interfaces);
+#endif
+    g_free (sampler);
+}
+
 gint
-read_netload (gulong *net, gulong *NTotal)
+read_netload (SystemloadNetSampler *sampler, gulong *net, gulong *NTotal)
 {
-    static guint64 bytes[2];
-    static gint64 time[2];
+    guint64 bytes;
+    gint64 time;
 
     *net = 0;
     *NTotal = 0;
 
-    time[1] = g_get_monotonic_time ();
+    time = systemload_procfile_scope_get_time (sampler->scope);
 
-    if (read_netload_proc (&bytes[1]) != 0)
-        if (read_netload_libgtop (&bytes[1]) != 0)
+    /* When the set of counted interfaces changes, the total jumps and the next difference is meaningless */
+    const bool links_changed = netlink_links_changed (sampler);
+    const bool reset = links_changed || sampler->netif_filter_changed;
+    const bool refresh = links_changed || time - sampler->netif_time >= NETIF_REFRESH_INTERVAL;
+    sampler->netif_filter_changed = false;
+    if (refresh)
+    {
+        g_hash_table_remove_all (sampler->netif_counted);
+        sampler->netif_time = time;
+    }
+
+    if (read_netload_proc (sampler, &bytes) != 0)
+        if (read_netload_libgtop (sampler, &bytes, refresh) != 0)
             return -1;
 
-    if (time[0] != 0 && G_LIKELY (time[1] > time[0]) && G_LIKELY (bytes[1] >= bytes[0]))
+    if (sampler->time != 0 && !reset && G_LIKELY (time > sampler->time) && G_LIKELY (bytes >= sampler->bytes))
     {
-        guint64 diff_bits = 8 * (bytes[1] - bytes[0]);
-        gdouble diff_time = (time[1] - time[0]) / 1e6;
+        guint64 diff_bits = 8 * (bytes - sampler->bytes);
+        gdouble diff_time = (time - sampler->time) / 1e6;
         *net = MIN (100 * diff_bits / diff_time / MAX_BANDWIDTH_BITS, 100);
         *NTotal = diff_bits / diff_time;
     }
 
-    bytes[0] = bytes[1];
-    time[0] = time[1];
+    sampler->bytes = bytes;
+    sampler->time = time;
 
     return 0;
 }
-
@@ -30,9 +30,28 @@
 
 #include <glib.h>
 
+#include "procfile.h"
+
 /* 100 Mbit/s */
 #define MAX_BANDWIDTH_BITS (100*1000*1000)
 
-gint read_netload (gulong *net, gulong *NTotal);
+/*
+ * The previous reading, the interface filter and the open files of one consumer of read_netload().
+ * Every sampler listens to its own netlink socket, so each consumer notices every link change.
+ * The files are read in the given scope, NULL for the regular update. See procfile.h
+ */
+struct SystemloadNetSampler;
+
+SystemloadNetSampler *systemload_net_sampler_new  (SystemloadProcScope *scope);
+void                  systemload_net_sampler_free (SystemloadNetSampler *sampler);
+
+gint read_netload (SystemloadNetSampler *sampler, gulong *net, gulong *NTotal);
+
+/*
+ * Sets the glob patterns of the interfaces which are always counted and of those which are not,
+ * separated by commas, semicolons or spaces. The patterns are compiled only when they change.
+ * Interfaces matching neither list are counted if they are backed by hardware and are not a slave.
+ */
+void set_netload_filter (SystemloadNetSampler *sampler, const gchar *include, const gchar *exclude);
 
 #endif /* _XFCE_SYSTEMLOAD_NETWORK_H_ */
@@ -0,0 +1,242 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+
+#include "numa.h"
+#include "procfile.h"
+#include "procparse.h"
+#include "topology.h"
+
+#define SYSFS_NODE "/sys/devices/system/node"
+
+struct SystemloadNuma {
+    GArray                *nodes;       /* SystemloadNumaNode, sorted by id */
+    SystemloadProcFile   **meminfo;     /* Per node */
+    SystemloadCpuTopology *topology;
+    gint                  *node_index;  /* Index into nodes for every CPU of the topology, -1 if none */
+};
+
+static gint
+compare_nodes (gconstpointer a, gconstpointer b)
+{
+    const auto node_a = (const SystemloadNumaNode*) a;
+    const auto node_b = (const SystemloadNumaNode*) b;
+    return (node_a->id > node_b->id) - (node_a->id < node_b->id);
+}
+
+SystemloadNuma *
+systemload_numa_new (void)
+{
+    SystemloadNuma *numa = g_new0 (SystemloadNuma, 1);
+    numa->nodes = g_array_new (FALSE, TRUE, sizeof (SystemloadNumaNode));
+
+#ifdef __linux__
+    GDir *dir = g_dir_open (SYSFS_NODE, 0, NULL);
+    if (dir)
+    {
+        const gchar *name;
+        while ((name = g_dir_read_name (dir)) != NULL)
+        {
+            guint64 id;
+            if (g_str_has_prefix (name, "node") &&
+                g_ascii_string_to_unsigned (name + 4, 10, 0, G_MAXINT, &id, NULL))
+            {
+                SystemloadNumaNode node = {};
+                node.id = id;
+                g_array_append_val (numa->nodes, node);
+            }
+        }
+        g_dir_close (dir);
+    }
+#endif
+
+    /* A single node carries no more information than the machine-wide figures */
+    if (numa->nodes->len < 2)
+    {
+        g_array_set_size (numa->nodes, 0);
+        return numa;
+    }
+    g_array_sort (numa->nodes, compare_nodes);
+
+    numa->meminfo = g_new0 (SystemloadProcFile*, numa->nodes->len);
+    for (guint i = 0; i < numa->nodes->len; i++)
+    {
+        gchar *path = g_strdup_printf (SYSFS_NODE "/node%u/meminfo",
+                                       g_array_index (numa->nodes, SystemloadNumaNode, i).id);
+        numa->meminfo[i] = systemload_procfile_open (path);
+        g_free (path);
+    }
+
+    /* Cores which are offline now may come online later, so cover all configured ones */
+    glong n_cpus = sysconf (_SC_NPROCESSORS_CONF);
+    numa->topology = systemload_cpu_topology_read (MAX (n_cpus, 1));
+    numa->node_index = g_new (gint, numa->topology->n_cpus);
+    for (guint cpu = 0; cpu < numa->topology->n_cpus; cpu++)
+    {
+        numa->node_index[cpu] = -1;
+        for (guint i = 0; i < numa->nodes->len; i++)
+        {
+            SystemloadNumaNode *node = &g_array_index (numa->nodes, SystemloadNumaNode, i);
+            if (numa->topology->node[cpu] == (gint) node->id)
+            {
+                numa->node_index[cpu] = i;
+                node->n_cpus++;
+                break;
+            }
+        }
+    }
+
+    return numa;
+}
+
+void
+systemload_numa_free (SystemloadNuma *numa)
+{
+    if (numa == NULL)
+        return;
+
+    for (guint i = 0; numa->meminfo && i < numa->nodes->len; i++)
+        systemload_procfile_close (numa->meminfo[i]);
+    g_free (numa->meminfo);
+    g_free (numa->node_index);
+    systemload_cpu_topology_free (numa->topology);
+    g_array_free (numa->nodes, TRUE);
+    g_free (numa);
+}
+
+guint
+systemload_numa_get_n_nodes (const SystemloadNuma *numa)
+{
+    return numa->nodes->len;
+}
+
+const SystemloadNumaNode *
+systemload_numa_get_node (const SystemloadNuma *numa, guint node)
+{
+    g_return_val_if_fail (node < numa->nodes->len, NULL);
+
+    return &g_array_index (numa->nodes, SystemloadNumaNode, node);
+}
+
+/*
+ * Parses the lines of a node meminfo file, "Node 0 MemTotal:  65722168 kB".
+ * Node files have no MemAvailable, so the reclaimable page cache and slab are subtracted from the used memory.
+ */
+static void
+parse_node_meminfo (const gchar *buf, SystemloadNumaNode *node)
+{
+    guint64 total = 0, free = 0, file = 0, shmem = 0, reclaimable = 0;
+
+    for (const gchar *line = buf; *line; )
+    {
+        const gchar *key = strchr (line, ':');
+        const gchar *eol = systemload_find_eol (line);
+        if (!key || key > eol)
+        {
+            line = (*eol == '\n') ? eol + 1 : eol;
+            continue;
+        }
+
+        /* Back up from the colon to the start of the key */
+        const gchar *start = key;
+        while (start > line && start[-1] != ' ')
+            start--;
+        const gsize len = key - start;
+
+        guint64 value;
+        if (systemload_parse_uints (key, &value, 1, &line) != 1)
+            continue;
+
+        if (len == 8 && memcmp (start, "MemTotal", len) == 0)
+            total = value;
+        else if (len == 7 && memcmp (start, "MemFree", len) == 0)
+            free = value;
+        else if (len == 9 && memcmp (start, "FilePages", len) == 0)
+            file = value;
+        else if (len == 5 && memcmp (start, "Shmem", len) == 0)
+            shmem = value;
+        else if (len == 12 && memcmp (start, "SReclaimable", len) == 0)
+            reclaimable = value;
+    }
+
+    /* Shared memory is accounted as page cache, but cannot be reclaimed */
+    const guint64 available = free + (file >= shmem ? file - shmem : 0) + reclaimable;
+    node->mem_total = total;
+    node->mem_used = (total >= available) ? total - available : 0;
+}
+
+void
+systemload_numa_update_memory (SystemloadNuma *numa)
+{
+    for (guint i = 0; i < numa->nodes->len; i++)
+    {
+        SystemloadNumaNode *node = &g_array_index (numa->nodes, SystemloadNumaNode, i);
+        const gchar *buf = numa->meminfo[i] ? systemload_procfile_read (numa->meminfo[i], NULL) : NULL;
+
+        if (buf)
+            parse_node_meminfo (buf, node);
+        else
+            node->mem_total = node->mem_used = 0;
+    }
+}
+
+void
+systemload_numa_update_cpu (SystemloadNuma *numa, const guint8 *loads, guint n_cores)
+{
+    const guint n_nodes = numa->nodes->len;
+    if (n_nodes == 0)
+        return;
+
+    guint *sum = g_newa (guint, n_nodes);
+    guint *count = g_newa (guint, n_nodes);
+    memset (sum, 0, n_nodes * sizeof (*sum));
+    memset (count, 0, n_nodes * sizeof (*count));
+
+    /* Offline cores count as idle */
+    n_cores = MIN (n_cores, numa->topology->n_cpus);
+    for (guint cpu = 0; cpu < n_cores; cpu++)
+    {
+        const gint i = numa->node_index[cpu];
+        if (i >= 0)
+        {
+            sum[i] += loads[cpu];
+            count[i]++;
+        }
+    }
+
+    for (guint i = 0; i < n_nodes; i++)
+        g_array_index (numa->nodes, SystemloadNumaNode, i).cpu_load = count[i] ? sum[i] / count[i] : 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_NUMA_H_
+#define _XFCE_SYSTEMLOAD_NUMA_H_
+
+#include <glib.h>
+
+/* Memory and CPU load of a NUMA node, as of the last update */
+struct SystemloadNumaNode {
+    guint   id;                   /* Number of the node in sysfs */
+    guint   n_cpus;               /* CPUs belonging to the node, 0 for memory-only nodes */
+    gulong  mem_total, mem_used;  /* KiB, the page cache is not counted as used */
+    guint8  cpu_load;             /* Average load of the CPUs of the node: 0% ... 100% */
+};
+
+struct SystemloadNuma;
+
+/*
+ * Resolves the NUMA nodes and the CPUs belonging to them. This is done once,
+ * the nodes of a running system are assumed not to change.
+ * On platforms other than Linux, and on machines without NUMA, there are no nodes.
+ */
+SystemloadNuma           *systemload_numa_new         (void);
+void                      systemload_numa_free        (SystemloadNuma *numa);
+
+guint                     systemload_numa_get_n_nodes (const SystemloadNuma *numa);
+const SystemloadNumaNode *systemload_numa_get_node    (const SystemloadNuma *numa,
+                                                       guint                 node);
+
+/* Reads the memory of every node through persistent file descriptors */
+void                      systemload_numa_update_memory (SystemloadNuma *numa);
+
+/* Averages the per-core loads, as returned by read_cpuload_cores(), over the CPUs of every node */
+void                      systemload_numa_update_cpu    (SystemloadNuma *numa,
+                                                         const guint8   *loads,
+                                                         guint           n_cores);
+
+#endif /* _XFCE_SYSTEMLOAD_NUMA_H_ */
@@ -0,0 +1,234 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+#include <time.h>
+
+#include <glib.h>
+
+#include "cpu.h"
+#include "memswap.h"
+#include "network.h"
+#include "peak.h"
+#include "procfile.h"
+
+/* Time span over which the CPU time spent sampling is compared with the budget, in µs */
+#define BUDGET_WINDOW (2 * G_USEC_PER_SEC)
+
+struct SystemloadPeakSampler {
+    SystemloadProcScope  *scope;  /* The files are read in ticks of their own */
+    SystemloadCpuSampler *cpu;
+    SystemloadMemSampler *mem;
+    SystemloadNetSampler *net;
+    bool     primed[N_MONITORS];  /* The delta readers have a previous reading */
+    gulong   peak[N_MONITORS];
+    guint    n_readings;
+
+    guint    base_interval, max_interval, interval;  /* ms */
+    guint    budget;                                 /* Percent of one CPU */
+    gint64   window_start;                           /* Monotonic time, µs */
+    gint64   window_cost;                            /* CPU time, ns */
+};
+
+/* CPU time of the calling thread in ns, or the monotonic time if that is not available */
+static gint64
+thread_cpu_time (void)
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    struct timespec ts;
+    if (clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return (gint64) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+    return g_get_monotonic_time () * 1000;
+}
+
+SystemloadPeakSampler *
+systemload_peak_sampler_new (void)
+{
+    SystemloadPeakSampler *sampler = g_new0 (SystemloadPeakSampler, 1);
+    sampler->scope = systemload_procfile_scope_new ();
+    sampler->cpu = systemload_cpu_sampler_new (sampler->scope);
+    sampler->mem = systemload_mem_sampler_new (sampler->scope);
+    sampler->net = systemload_net_sampler_new (sampler->scope);
+    sampler->base_interval = sampler->max_interval = sampler->interval = MAX_PEAK_INTERVAL;
+    sampler->budget = 1;
+    return sampler;
+}
+
+void
+systemload_peak_sampler_free (SystemloadPeakSampler *sampler)
+{
+    if (!sampler)
+        return;
+    systemload_cpu_sampler_free (sampler->cpu);
+    systemload_mem_sampler_free (sampler->mem);
+    systemload_net_sampler_free (sampler->net);
+    systemload_procfile_scope_free (sampler->scope);
+    g_free (sampler);
+}
+
+void
+systemload_peak_sampler_set_policy (SystemloadPeakSampler *sampler, guint interval, guint max_interval, guint budget)
+{
+    max_interval = MAX (max_interval, interval);
+    if (sampler->base_interval == interval && sampler->max_interval == max_interval && sampler->budget == budget)
+        return;
+
+    sampler->base_interval = interval;
+    sampler->max_interval = max_interval;
+    sampler->interval = interval;
+    sampler->budget = budget;
+    sampler->window_start = 0;
+}
+
+void
+systemload_peak_sampler_set_network_filter (SystemloadPeakSampler *sampler, const gchar *include, const gchar *exclude)
+{
+    set_netload_filter (sampler->net, include, exclude);
+}
+
+bool
+systemload_peak_sampler_supports (SystemloadMonitor monitor)
+{
+    /* A capture only holds the readings of the regular update */
+    if (systemload_procfile_is_replaying ())
+        return false;
+
+    switch (monitor)
+    {
+        case CPU_MONITOR:
+        case MEM_MONITOR:
+        case SWAP_MONITOR:
+        case NET_MONITOR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void
+add_reading (SystemloadPeakSampler *sampler, SystemloadMonitor monitor, gulong value)
+{
+    /* The first reading of a delta reader covers the time since its previous use */
+    if (!sampler->primed[monitor])
+    {
+        sampler->primed[monitor] = true;
+        return;
+    }
+    sampler->peak[monitor] = MAX (sampler->peak[monitor], value);
+}
+
+/* Backs off while the sampling costs more than the budget, and recovers once it costs much less */
+static void
+enforce_budget (SystemloadPeakSampler *sampler, gint64 cost)
+{
+    const gint64 now = g_get_monotonic_time ();
+
+    if (sampler->window_start == 0)
+    {
+        sampler->window_start = now;
+        sampler->window_cost = 0;
+    }
+    sampler->window_cost += cost;
+
+    const gint64 elapsed = now - sampler->window_start;
+    if (elapsed < BUDGET_WINDOW)
+        return;
+
+    /* window_cost is in ns and elapsed in µs, so this is the share of one CPU in percent */
+    const gdouble share = sampler->window_cost / (10.0 * elapsed);
+    if (share > sampler->budget && sampler->interval < sampler->max_interval)
+    {
+        sampler->interval = MIN (2 * sampler->interval, sampler->max_interval);
+        g_debug ("Peak sampling uses %.2f%% of a CPU, backing off to %u ms", share, sampler->interval);
+    }
+    else if (4 * share < sampler->budget && sampler->interval > sampler->base_interval)
+    {
+        sampler->interval = MAX (sampler->interval / 2, sampler->base_interval);
+    }
+
+    sampler->window_start = now;
+    sampler->window_cost = 0;
+}
+
+guint
+systemload_peak_sampler_sample (SystemloadPeakSampler *sampler, const bool enabled[N_MONITORS])
+{
+    const gint64 start = thread_cpu_time ();
+
+    /* Not batched with the files of the regular update, which would then be read at this rate */
+    systemload_procfile_scope_begin_tick (sampler->scope);
+
+    if (enabled[CPU_MONITOR])
+        add_reading (sampler, CPU_MONITOR, read_cpuload (sampler->cpu, NULL));
+    else
+        sampler->primed[CPU_MONITOR] = false;
+
+    if (enabled[MEM_MONITOR] || enabled[SWAP_MONITOR])
+    {
+        gulong mem, swap, mem_total, mem_used, swap_total, swap_used;
+        if (read_memswap (sampler->mem, &mem, &swap, &mem_total, &mem_used, &swap_total, &swap_used) == 0)
+        {
+            /* These are not deltas, no priming needed */
+            if (enabled[MEM_MONITOR])
+                sampler->peak[MEM_MONITOR] = MAX (sampler->peak[MEM_MONITOR], mem);
+            if (enabled[SWAP_MONITOR])
+                sampler->peak[SWAP_MONITOR] = MAX (sampler->peak[SWAP_MONITOR], swap);
+        }
+    }
+
+    if (enabled[NET_MONITOR])
+    {
+        gulong net, bits;
+        if (read_netload (sampler->net, &net, &bits) == 0)
+            add_reading (sampler, NET_MONITOR, net);
+    }
+    else
+        sampler->primed[NET_MONITOR] = false;
+
+    sampler->n_readings++;
+
+    enforce_budget (sampler, thread_cpu_time () - start);
+    return sampler->interval;
+}
+
+bool
+systemload_peak_sampler_take (SystemloadPeakSampler *sampler, gulong peak[N_MONITORS])
+{
+    if (sampler->n_readings == 0)
+        return false;
+
+    memcpy (peak, sampler->peak, sizeof (sampler->peak));
+    memset (sampler->peak, 0, sizeof (sampler->peak));
+    sampler->n_readings = 0;
+    return true;
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_PEAK_H_
+#define _XFCE_SYSTEMLOAD_PEAK_H_
+
+#include <glib.h>
+
+#include "settings.h"
+
+/*
+ * Samples the CPU, memory, swap and network monitors between the updates of the panel,
+ * at an interval below MIN_TIMEOUT, and keeps the maximum of every monitor. Bursts shorter
+ * than the update interval are thus not averaged away. The readers have sampler contexts
+ * of their own, the deltas of the regular updates are not disturbed.
+ *
+ * The CPU time spent sampling is limited to a share of one CPU: while it is exceeded,
+ * the interval is doubled, and it is halved again once less than a quarter is used.
+ */
+struct SystemloadPeakSampler;
+
+SystemloadPeakSampler *systemload_peak_sampler_new                (void);
+void                   systemload_peak_sampler_free               (SystemloadPeakSampler *sampler);
+
+/* interval and max_interval are in ms, budget is in percent of one CPU */
+void                   systemload_peak_sampler_set_policy         (SystemloadPeakSampler *sampler,
+                                                                   guint                  interval,
+                                                                   guint                  max_interval,
+                                                                   guint                  budget);
+void                   systemload_peak_sampler_set_network_filter (SystemloadPeakSampler *sampler,
+                                                                   const gchar           *include,
+                                                                   const gchar           *exclude);
+
+/* Whether the monitor can be sampled at a high resolution */
+bool                   systemload_peak_sampler_supports           (SystemloadMonitor      monitor);
+
+/*
+ * Reads the enabled monitors once. This does not allocate memory, except when the network
+ * interfaces are re-evaluated. Returns the interval until the next reading in ms.
+ */
+guint                  systemload_peak_sampler_sample             (SystemloadPeakSampler *sampler,
+                                                                   const bool             enabled[N_MONITORS]);
+
+/* Moves the maxima since the previous call into peak[], returns false if nothing was read since */
+bool                   systemload_peak_sampler_take               (SystemloadPeakSampler *sampler,
+                                                                   gulong                 peak[N_MONITORS]);
+
+#endif /* _XFCE_SYSTEMLOAD_PEAK_H_ */
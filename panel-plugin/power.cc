@@ -0,0 +1,272 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gio/gio.h>
+
+#ifdef HAVE_UPOWER_GLIB
+#include <upower.h>
+#endif
+
+#include "power.h"
+
+/* The legacy name is still provided by power-profiles-daemon 0.20+, and is the only one of older versions */
+#define POWER_PROFILES_NAME       "net.hadess.PowerProfiles"
+#define POWER_PROFILES_PATH       "/net/hadess/PowerProfiles"
+#define POWER_PROFILES_INTERFACE  "net.hadess.PowerProfiles"
+
+struct SystemloadPower {
+#ifdef HAVE_UPOWER_GLIB
+    UpClient            *upower;
+#if UP_CHECK_VERSION(0, 99, 0)
+    UpDevice            *display_device;  /* Composite battery, carries the warning level */
+#endif
+#endif
+    GDBusProxy          *profiles;
+    GCancellable        *cancellable;
+
+    SystemloadPowerState state;
+    bool                 lid_closed;
+    bool                 power_saver;
+
+    void                 (*callback)(gpointer user_data);
+    gpointer             user_data;
+};
+
+/* Returns whether the state has changed */
+static bool
+power_read (SystemloadPower *power)
+{
+    SystemloadPowerState state = POWER_STATE_AC;
+    bool lid_closed = false;
+    bool power_saver = false;
+
+#ifdef HAVE_UPOWER_GLIB
+    if (power->upower && up_client_get_on_battery (power->upower))
+    {
+        state = POWER_STATE_BATTERY;
+        lid_closed = up_client_get_lid_is_closed (power->upower);
+#if UP_CHECK_VERSION(0, 99, 0)
+        if (power->display_device)
+        {
+            guint level = 0;
+            g_object_get (power->display_device, "warning-level", &level, NULL);
+            if (level >= (guint) UP_DEVICE_LEVEL_LOW)
+                state = POWER_STATE_LOW_BATTERY;
+        }
+#endif
+    }
+#endif
+
+    if (power->profiles)
+    {
+        GVariant *profile = g_dbus_proxy_get_cached_property (power->profiles, "ActiveProfile");
+        if (profile)
+        {
+            if (g_variant_is_of_type (profile, G_VARIANT_TYPE_STRING))
+                power_saver = g_strcmp0 (g_variant_get_string (profile, NULL), "power-saver") == 0;
+            g_variant_unref (profile);
+        }
+    }
+
+    if (state == power->state && lid_closed == power->lid_closed && power_saver == power->power_saver)
+        return false;
+
+    power->state = state;
+    power->lid_closed = lid_closed;
+    power->power_saver = power_saver;
+    return true;
+}
+
+static void
+power_refresh (SystemloadPower *power)
+{
+    if (power_read (power))
+        power->callback (power->user_data);
+}
+
+#ifdef HAVE_UPOWER_GLIB
+static void
+#if UP_CHECK_VERSION(0, 99, 0)
+upower_changed_cb (GObject *object, GParamSpec *pspec, SystemloadPower *power)
+#else /* UP_CHECK_VERSION < 0.99 */
+upower_changed_cb (UpClient *client, SystemloadPower *power)
+#endif /* UP_CHECK_VERSION */
+{
+    power_refresh (power);
+}
+#endif /* HAVE_UPOWER_GLIB */
+
+static void
+profiles_changed_cb (GDBusProxy *proxy, GVariant *changed, gchar **invalidated, SystemloadPower *power)
+{
+    power_refresh (power);
+}
+
+static void
+profiles_owner_cb (GObject *proxy, GParamSpec *pspec, SystemloadPower *power)
+{
+    /* The cached properties are dropped when the daemon exits, and reloaded when it is restarted */
+    power_refresh (power);
+}
+
+static void
+profiles_ready_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    GError *error = NULL;
+    GDBusProxy *proxy = g_dbus_proxy_new_for_bus_finish (result, &error);
+
+    if (!proxy)
+    {
+        /* Cancelled by systemload_power_free(), or there is no system bus */
+        if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            g_message ("Power profiles are unavailable: %s", error->message);
+        g_error_free (error);
+        return;
+    }
+
+    auto power = (SystemloadPower*) user_data;
+    power->profiles = proxy;
+    g_signal_connect (proxy, "g-properties-changed", G_CALLBACK (profiles_changed_cb), power);
+    g_signal_connect (proxy, "notify::g-name-owner", G_CALLBACK (profiles_owner_cb), power);
+    power_refresh (power);
+}
+
+SystemloadPower *
+systemload_power_new (void (*callback)(gpointer user_data), gpointer user_data)
+{
+    auto power = g_new0 (SystemloadPower, 1);
+
+    power->callback = callback;
+    power->user_data = user_data;
+    power->state = POWER_STATE_AC;
+
+#ifdef HAVE_UPOWER_GLIB
+    power->upower = up_client_new ();
+    if (power->upower)
+    {
+#if UP_CHECK_VERSION(0, 99, 0)
+        g_signal_connect (power->upower, "notify", G_CALLBACK (upower_changed_cb), power);
+        power->display_device = up_client_get_display_device (power->upower);
+        if (power->display_device)
+            g_signal_connect (power->display_device, "notify::warning-level", G_CALLBACK (upower_changed_cb), power);
+#else /* UP_CHECK_VERSION < 0.99 */
+        g_signal_connect (power->upower, "changed", G_CALLBACK (upower_changed_cb), power);
+#endif /* UP_CHECK_VERSION */
+    }
+#endif /* HAVE_UPOWER_GLIB */
+
+    /* Asynchronously, so that a slow system bus does not delay the panel */
+    power->cancellable = g_cancellable_new ();
+    g_dbus_proxy_new_for_bus (G_BUS_TYPE_SYSTEM, G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START, NULL,
+                              POWER_PROFILES_NAME, POWER_PROFILES_PATH, POWER_PROFILES_INTERFACE,
+                              power->cancellable, profiles_ready_cb, power);
+
+    /* The callback is not invoked for the initial state, the caller reads it after creating the object */
+    power_read (power);
+
+    return power;
+}
+
+void
+systemload_power_free (SystemloadPower *power)
+{
+    if (!power)
+        return;
+
+    g_cancellable_cancel (power->cancellable);
+    g_object_unref (power->cancellable);
+    if (power->profiles)
+    {
+        g_signal_handlers_disconnect_by_data (power->profiles, power);
+        g_object_unref (power->profiles);
+    }
+#ifdef HAVE_UPOWER_GLIB
+#if UP_CHECK_VERSION(0, 99, 0)
+    if (power->display_device)
+    {
+        g_signal_handlers_disconnect_by_data (power->display_device, power);
+        g_object_unref (power->display_device);
+    }
+#endif
+    if (power->upower)
+    {
+        g_signal_handlers_disconnect_by_data (power->upower, power);
+        g_object_unref (power->upower);
+    }
+#endif
+    g_free (power);
+}
+
+SystemloadPowerState
+systemload_power_get_state (const SystemloadPower *power)
+{
+    g_return_val_if_fail (power != NULL, POWER_STATE_AC);
+
+    return power->state;
+}
+
+bool
+systemload_power_get_lid_closed (const SystemloadPower *power)
+{
+    g_return_val_if_fail (power != NULL, false);
+
+    return power->lid_closed;
+}
+
+bool
+systemload_power_get_power_saver (const SystemloadPower *power)
+{
+    g_return_val_if_fail (power != NULL, false);
+
+    return power->power_saver;
+}
+
+guint
+systemload_power_get_interval (const SystemloadPower *power, guint interval, guint battery_interval,
+                               const guint multipliers[N_POWER_STATES], guint saver_multiplier)
+{
+    g_return_val_if_fail (power != NULL, interval);
+
+    if (power->state != POWER_STATE_AC && battery_interval != 0)
+    {
+        /* Don't do any timeout if the lid is closed on battery */
+        if (power->lid_closed)
+            return 0;
+        interval = battery_interval;
+    }
+
+    interval *= multipliers[power->state];
+    if (power->power_saver)
+        interval *= saver_multiplier;
+    return interval;
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef _XFCE_SYSTEMLOAD_POWER_H_
+#define _XFCE_SYSTEMLOAD_POWER_H_
+
+#include <glib.h>
+
+#include "settings.h"
+
+struct SystemloadPower;
+
+/*
+ * Tracks the power supply through UPower, and the active profile of power-profiles-daemon.
+ * The callback is invoked when the state returned by the getters changes, not on every
+ * property notification of the services. Without UPower the state is always POWER_STATE_AC.
+ */
+SystemloadPower     *systemload_power_new             (void     (*callback)(gpointer user_data),
+                                                       gpointer   user_data);
+void                 systemload_power_free            (SystemloadPower *power);
+
+SystemloadPowerState systemload_power_get_state       (const SystemloadPower *power);
+bool                 systemload_power_get_lid_closed  (const SystemloadPower *power);
+bool                 systemload_power_get_power_saver (const SystemloadPower *power);
+
+/*
+ * Returns the update interval in ms for the current state, or 0 if there should be no updates.
+ * On battery, a non-zero battery_interval replaces the interval, and there are no updates while
+ * the lid is closed. Without a battery interval, the lid does not matter. The interval is then
+ * multiplied by the factor of the state, and by saver_multiplier while the power-saver profile is active.
+ */
+guint                systemload_power_get_interval    (const SystemloadPower *power,
+                                                       guint                  interval,
+                                                       guint                  battery_interval,
+                                                       const guint            multipliers[N_POWER_STATES],
+                                                       guint                  saver_multiplier);
+
+#endif /* _XFCE_SYSTEMLOAD_POWER_H_ */
@@ -0,0 +1,855 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+#include "procfile.h"
+
+/* Most files in /proc fit into this, /proc/meminfo and /proc/stat on large machines may not */
+#define INITIAL_BUFFER_SIZE (4 * 1024)
+#define MAX_BUFFER_SIZE (4 * 1024 * 1024)
+
+/* The buffer is grown before it has less room than this for the next read */
+#define MIN_READ_SIZE 1024
+
+/* Files whose contents were shorter than this are not read again to find their end, see read_is_complete() */
+#define SHORT_FILE_SIZE 2048
+
+struct _SystemloadProcScope {
+    guint64  tick;
+    gint64   time;       /* Monotonic time of the current tick, 0 before the first one */
+};
+
+struct _SystemloadProcFile {
+    gchar   *path;
+    SystemloadProcScope *scope;
+    gint     fd;         /* -1 when replaying */
+    gint     capture_id; /* Index of the path in the capture, -1 if none */
+    gint     slot;       /* Index in the table of registered files */
+    gchar   *buf;
+    gsize    size;       /* Allocated size of buf, without the padding */
+    gsize    length;     /* Length of the contents in buf */
+    bool     truncated;  /* The contents did not fit into MAX_BUFFER_SIZE */
+    bool     short_file; /* The previous contents were shorter than SHORT_FILE_SIZE */
+    guint64  used_tick;  /* Last tick of the scope in which the file was read */
+    guint64  read_tick;  /* Tick of the scope for which buf holds the contents */
+};
+
+/* All open files, indexed by their slot. Closed files leave a NULL hole which is reused. */
+static GPtrArray *files;
+
+/* The ticks of the regular update, the only ones which are batched, recorded and replayed */
+static SystemloadProcScope update_scope = { 1, 0 };
+
+/*
+ * The capture file is a magic number followed by records, each starting with its type:
+ *   CAPTURE_PATH       guint16 id, guint16 length, the path without a terminating NUL
+ *   CAPTURE_TICK       gint64 monotonic time in µs, the contents read in the tick follow
+ *   CAPTURE_CONTENTS   guint16 id, guint32 length, the contents
+ *   CAPTURE_UNCHANGED  guint16 id
+ */
+#define CAPTURE_MAGIC "SLCAPT01"
+#define CAPTURE_MAGIC_SIZE 8
+enum { CAPTURE_PATH = 1, CAPTURE_TICK, CAPTURE_CONTENTS, CAPTURE_UNCHANGED };
+
+enum { MODE_LIVE, MODE_RECORD, MODE_REPLAY };
+static gint capture_mode = -1;  /* Not initialized */
+
+/* Recording */
+static FILE *record_file;
+static GHashTable *record_ids;     /* Path -> id + 1 */
+static GPtrArray *record_last;     /* GByteArray, the last recorded contents by id */
+static GArray *record_ticks;       /* guint64, the tick in which a path was last recorded, by id */
+static guint64 record_tick;        /* The tick whose CAPTURE_TICK was written */
+
+/* Replay */
+struct t_replay_contents {
+    const gchar *data;  /* Points into the mapped capture, NULL if not read yet */
+    guint32      length;
+};
+static GMappedFile *replay_mapping;
+static const gchar *replay_pos, *replay_end;
+static GHashTable *replay_ids;     /* Path -> index in replay_contents + 1, the capture_id of the files */
+static GArray *replay_contents;    /* t_replay_contents by index */
+static GArray *replay_session_ids; /* guint, the id of a path in the current session -> index + 1, 0 if unknown */
+static gdouble replay_speed = 1;
+static gint64 replay_first_time, replay_start;  /* Recorded and actual time the replay of a session started */
+static bool replay_finished = false;
+
+/*
+ * Whether a read which returned n of the requested bytes, and which made the contents
+ * file->length bytes long, reached the end of the file. A seq_file returns what fits into its
+ * buffer of at least a page, so in general only a read which returns 0 is the end. A first read
+ * which returned less than requested and less than half a page can only have been cut short by
+ * a record longer than the rest of the page. Such a record would have made the previous contents
+ * longer than SHORT_FILE_SIZE as well, so the extra read is skipped only for files that were short.
+ */
+static bool
+read_is_complete (const SystemloadProcFile *file, gsize requested, gssize n)
+{
+    return n == 0 ||
+           (file->short_file && file->length == (gsize) n && (gsize) n < requested && n < SHORT_FILE_SIZE);
+}
+
+/*
+ * Makes room for the next read at the end of the contents, returns false if the buffer
+ * cannot grow anymore. The contents are then cut after their last complete line.
+ */
+static bool
+reserve_read (SystemloadProcFile *file)
+{
+    if (file->size - 1 - file->length >= MIN_READ_SIZE)
+        return true;
+
+    if (file->size >= MAX_BUFFER_SIZE)
+    {
+        while (file->length > 0 && file->buf[file->length - 1] != '\n')
+            file->length--;
+        file->truncated = true;
+        return false;
+    }
+
+    file->size *= 2;
+    file->buf = (gchar*) g_realloc (file->buf, file->size + SYSTEMLOAD_PROCFILE_PADDING);
+    return true;
+}
+
+#ifdef HAVE_LIBURING
+
+#define RING_ENTRIES 32
+
+static struct io_uring ring;
+static bool ring_initialized = false;
+static bool ring_failed = false;
+static bool ring_files_changed = false;
+
+static bool
+ring_init (void)
+{
+    if (ring_initialized)
+        return true;
+    if (ring_failed)
+        return false;
+
+    /* Files in /proc and /sys cannot be read without blocking, so io_uring hands every read to a worker thread */
+    if (g_strcmp0 (g_getenv ("SYSTEMLOAD_IO_URING"), "1") != 0)
+    {
+        ring_failed = true;
+        return false;
+    }
+
+    gint ret = io_uring_queue_init (RING_ENTRIES, &ring, 0);
+    if (ret < 0)
+    {
+        /* Not fatal: io_uring may be disabled by the kernel or by a seccomp filter */
+        g_info ("io_uring is not available (%s), reading files one at a time", g_strerror (-ret));
+        ring_failed = true;
+        return false;
+    }
+
+    ring_initialized = true;
+    ring_files_changed = true;
+    return true;
+}
+
+static bool
+ring_register_files (void)
+{
+    if (!ring_files_changed)
+        return true;
+
+    io_uring_unregister_files (&ring);
+    ring_files_changed = false;
+
+    if (files->len == 0)
+        return true;
+
+    gint *fds = g_new (gint, files->len);
+    for (guint i = 0; i < files->len; i++)
+    {
+        auto file = (const SystemloadProcFile*) g_ptr_array_index (files, i);
+        fds[i] = file ? file->fd : -1;
+    }
+    gint ret = io_uring_register_files (&ring, fds, files->len);
+    g_free (fds);
+
+    if (ret < 0)
+    {
+        g_warning ("Cannot register files with io_uring: %s", g_strerror (-ret));
+        io_uring_queue_exit (&ring);
+        ring_initialized = false;
+        ring_failed = true;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Reads all the files used in the previous tick, with one submission per round of reads.
+ * A seq_file returns about a page per read, so every file is read until a read returns 0:
+ * usually two rounds, more when one of the files is larger than a page.
+ */
+static void
+ring_read_batch (void)
+{
+    SystemloadProcFile *pending[RING_ENTRIES];
+    guint n_pending = 0;
+
+    if (!ring_init () || !ring_register_files ())
+        return;
+
+    /* The files which do not fit into the ring are left to the pread() path */
+    for (guint i = 0; i < files->len && n_pending < RING_ENTRIES; i++)
+    {
+        auto file = (SystemloadProcFile*) g_ptr_array_index (files, i);
+        if (file == NULL || file->scope != &update_scope || file->used_tick + 1 != update_scope.tick)
+            continue;
+        file->length = 0;
+        file->truncated = false;
+        pending[n_pending++] = file;
+    }
+
+    while (n_pending > 0)
+    {
+        for (guint i = 0; i < n_pending; i++)
+        {
+            auto file = pending[i];
+            struct io_uring_sqe *sqe = io_uring_get_sqe (&ring);
+            io_uring_prep_read (sqe, file->slot, file->buf + file->length, file->size - 1 - file->length, file->length);
+            sqe->flags |= IOSQE_FIXED_FILE;
+            io_uring_sqe_set_data (sqe, file);
+        }
+
+        gint ret = io_uring_submit_and_wait (&ring, n_pending);
+        if (ret < 0)
+        {
+            g_warning ("io_uring submission failed: %s", g_strerror (-ret));
+            return;
+        }
+
+        /* The completions hold the files, so the unfinished ones can be moved to the front */
+        struct io_uring_cqe *cqe;
+        unsigned head, seen = 0;
+        guint n_unfinished = 0;
+        io_uring_for_each_cqe (&ring, head, cqe)
+        {
+            auto file = (SystemloadProcFile*) io_uring_cqe_get_data (cqe);
+            seen++;
+
+            /* On an error, the file is read again by the pread() path */
+            if (cqe->res < 0)
+                continue;
+
+            const gsize requested = file->size - 1 - file->length;
+            file->length += cqe->res;
+            if (!read_is_complete (file, requested, cqe->res) && reserve_read (file))
+            {
+                pending[n_unfinished++] = file;
+                continue;
+            }
+            file->buf[file->length] = '\0';
+            file->short_file = file->length < SHORT_FILE_SIZE;
+            file->read_tick = update_scope.tick;
+        }
+        io_uring_cq_advance (&ring, seen);
+        n_pending = n_unfinished;
+    }
+}
+
+#endif /* HAVE_LIBURING */
+
+static void
+record_init (const gchar *path)
+{
+    record_file = fopen (path, "ab");
+    if (!record_file)
+    {
+        g_warning ("Cannot open the capture file '%s': %s", path, g_strerror (errno));
+        return;
+    }
+    /* Every recording session starts with a header, so they can be concatenated */
+    fwrite (CAPTURE_MAGIC, 1, CAPTURE_MAGIC_SIZE, record_file);
+    record_ids = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    record_last = g_ptr_array_new_with_free_func ((GDestroyNotify) g_byte_array_unref);
+    record_ticks = g_array_new (FALSE, TRUE, sizeof (guint64));
+}
+
+static gint
+record_path (const gchar *path)
+{
+    gpointer id = g_hash_table_lookup (record_ids, path);
+    if (id)
+        return GPOINTER_TO_INT (id) - 1;
+    if (record_last->len > G_MAXUINT16)
+        return -1;
+
+    const guint8 type = CAPTURE_PATH;
+    const guint16 new_id = record_last->len;
+    const guint16 length = MIN (strlen (path), G_MAXUINT16);
+    fwrite (&type, sizeof (type), 1, record_file);
+    fwrite (&new_id, sizeof (new_id), 1, record_file);
+    fwrite (&length, sizeof (length), 1, record_file);
+    fwrite (path, 1, length, record_file);
+
+    g_hash_table_insert (record_ids, g_strdup (path), GINT_TO_POINTER (new_id + 1));
+    g_ptr_array_add (record_last, g_byte_array_new ());
+    g_array_set_size (record_ticks, record_last->len);
+    return new_id;
+}
+
+/* Appends the contents of the file, once per tick and path */
+static void
+record_contents (SystemloadProcFile *file)
+{
+    if (file->capture_id < 0)
+        file->capture_id = record_path (file->path);
+    if (file->capture_id < 0)
+        return;
+
+    const guint16 id = file->capture_id;
+    guint64 *recorded = &g_array_index (record_ticks, guint64, id);
+    if (*recorded == update_scope.tick)
+        return;
+    *recorded = update_scope.tick;
+
+    if (record_tick != update_scope.tick)
+    {
+        const guint8 type = CAPTURE_TICK;
+        const gint64 time = systemload_procfile_get_time ();
+        fwrite (&type, sizeof (type), 1, record_file);
+        fwrite (&time, sizeof (time), 1, record_file);
+        record_tick = update_scope.tick;
+    }
+
+    auto last = (GByteArray*) g_ptr_array_index (record_last, id);
+    if (last->len == file->length && memcmp (last->data, file->buf, file->length) == 0)
+    {
+        const guint8 type = CAPTURE_UNCHANGED;
+        fwrite (&type, sizeof (type), 1, record_file);
+        fwrite (&id, sizeof (id), 1, record_file);
+        return;
+    }
+
+    const guint8 type = CAPTURE_CONTENTS;
+    const guint32 length = file->length;
+    fwrite (&type, sizeof (type), 1, record_file);
+    fwrite (&id, sizeof (id), 1, record_file);
+    fwrite (&length, sizeof (length), 1, record_file);
+    fwrite (file->buf, 1, length, record_file);
+
+    g_byte_array_set_size (last, 0);
+    g_byte_array_append (last, (const guint8*) file->buf, file->length);
+}
+
+/*
+ * Returns the size of the record at pos, or 0 if it is truncated or unknown.
+ * For CAPTURE_PATH and CAPTURE_CONTENTS, the id and the payload are returned as well.
+ */
+static gsize
+replay_parse_record (const gchar *pos, guint8 *type, guint16 *id, const gchar **payload, guint32 *length)
+{
+    const gsize available = replay_end - pos;
+    guint16 length16;
+
+    if (available < 1)
+        return 0;
+    *type = pos[0];
+    switch (*type)
+    {
+        case CAPTURE_PATH:
+            if (available < 5)
+                return 0;
+            memcpy (id, pos + 1, sizeof (*id));
+            memcpy (&length16, pos + 3, sizeof (length16));
+            *length = length16;
+            *payload = pos + 5;
+            return (available - 5 >= *length) ? 5 + *length : 0;
+        case CAPTURE_TICK:
+            return (available >= 1 + sizeof (gint64)) ? 1 + sizeof (gint64) : 0;
+        case CAPTURE_CONTENTS:
+            if (available < 7)
+                return 0;
+            memcpy (id, pos + 1, sizeof (*id));
+            memcpy (length, pos + 3, sizeof (*length));
+            *payload = pos + 7;
+            return (available - 7 >= *length) ? 7 + *length : 0;
+        case CAPTURE_UNCHANGED:
+            if (available < 3)
+                return 0;
+            memcpy (id, pos + 1, sizeof (*id));
+            return 3;
+        default:
+            /* The magic number of a concatenated session */
+            if (available >= CAPTURE_MAGIC_SIZE && memcmp (pos, CAPTURE_MAGIC, CAPTURE_MAGIC_SIZE) == 0)
+                return CAPTURE_MAGIC_SIZE;
+            return 0;
+    }
+}
+
+/* Maps the capture and collects its paths, so that the files can be opened before they are read */
+static void
+replay_init (const gchar *path)
+{
+    GError *error = NULL;
+
+    replay_mapping = g_mapped_file_new (path, FALSE, &error);
+    if (!replay_mapping)
+    {
+        g_warning ("Cannot open the capture file '%s': %s", path, error->message);
+        g_error_free (error);
+        return;
+    }
+    replay_pos = g_mapped_file_get_contents (replay_mapping);
+    replay_end = replay_pos + g_mapped_file_get_length (replay_mapping);
+    if (replay_end - replay_pos < CAPTURE_MAGIC_SIZE || memcmp (replay_pos, CAPTURE_MAGIC, CAPTURE_MAGIC_SIZE) != 0)
+    {
+        g_warning ("'%s' is not a capture file", path);
+        replay_end = replay_pos;
+    }
+
+    const gchar *speed = g_getenv ("SYSTEMLOAD_REPLAY_SPEED");
+    if (speed)
+        replay_speed = MAX (g_ascii_strtod (speed, NULL), 0);
+
+    /* Every session numbers its paths from 0, the indices are assigned by path across the sessions */
+    replay_ids = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    replay_contents = g_array_new (FALSE, TRUE, sizeof (t_replay_contents));
+    replay_session_ids = g_array_new (FALSE, TRUE, sizeof (guint));
+
+    for (const gchar *pos = replay_pos; pos < replay_end; )
+    {
+        guint8 type;
+        guint16 id;
+        const gchar *payload;
+        guint32 length;
+        gsize size = replay_parse_record (pos, &type, &id, &payload, &length);
+        if (size == 0)
+        {
+            g_warning ("The capture file '%s' is truncated at offset %" G_GSIZE_FORMAT,
+                       path, (gsize) (pos - g_mapped_file_get_contents (replay_mapping)));
+            replay_end = pos;
+            break;
+        }
+        if (type == CAPTURE_PATH)
+        {
+            gchar *recorded_path = g_strndup (payload, length);
+            if (!g_hash_table_contains (replay_ids, recorded_path))
+            {
+                g_array_set_size (replay_contents, replay_contents->len + 1);
+                g_hash_table_insert (replay_ids, recorded_path, GINT_TO_POINTER (replay_contents->len));
+            }
+            else
+                g_free (recorded_path);
+        }
+        pos += size;
+    }
+}
+
+/* Applies the records of the next tick, returns false at the end of the capture */
+static bool
+replay_next_tick (void)
+{
+    bool in_tick = false;
+
+    while (replay_pos < replay_end)
+    {
+        guint8 type;
+        guint16 id;
+        const gchar *payload;
+        guint32 length;
+        const gsize size = replay_parse_record (replay_pos, &type, &id, &payload, &length);
+        const bool magic = size == CAPTURE_MAGIC_SIZE && memcmp (replay_pos, CAPTURE_MAGIC, CAPTURE_MAGIC_SIZE) == 0;
+
+        /* A tick ends at the next one or at the start of the next session */
+        if ((type == CAPTURE_TICK || magic) && in_tick)
+            return true;
+        if (type == CAPTURE_TICK)
+        {
+            memcpy (&update_scope.time, replay_pos + 1, sizeof (update_scope.time));
+            in_tick = true;
+        }
+        else if (type == CAPTURE_PATH)
+        {
+            gchar *recorded_path = g_strndup (payload, length);
+            guint index = GPOINTER_TO_INT (g_hash_table_lookup (replay_ids, recorded_path));
+            g_free (recorded_path);
+            if (id >= replay_session_ids->len)
+                g_array_set_size (replay_session_ids, id + 1);
+            g_array_index (replay_session_ids, guint, id) = index;
+        }
+        else if (type == CAPTURE_CONTENTS && id < replay_session_ids->len && g_array_index (replay_session_ids, guint, id) != 0)
+        {
+            const guint index = g_array_index (replay_session_ids, guint, id) - 1;
+            auto contents = &g_array_index (replay_contents, t_replay_contents, index);
+            contents->data = payload;
+            contents->length = length;
+        }
+        else if (magic)
+        {
+            /* A new session: its ids are new, and the files it does not read have no contents */
+            g_array_set_size (replay_session_ids, 0);
+            for (guint i = 0; i < replay_contents->len; i++)
+                g_array_index (replay_contents, t_replay_contents, i).data = NULL;
+        }
+        /* CAPTURE_UNCHANGED keeps the previous contents of the session */
+        replay_pos += size;
+    }
+
+    return in_tick;
+}
+
+/*
+ * Returns the time of the next recorded tick, or -1 at the end of the capture.
+ * new_session is set if the tick belongs to a recording session which was appended later.
+ */
+static gint64
+replay_peek_time (bool *new_session)
+{
+    *new_session = false;
+    for (const gchar *pos = replay_pos; pos < replay_end; )
+    {
+        guint8 type;
+        guint16 id;
+        const gchar *payload;
+        guint32 length;
+        const gsize size = replay_parse_record (pos, &type, &id, &payload, &length);
+        if (type == CAPTURE_TICK)
+        {
+            gint64 time;
+            memcpy (&time, pos + 1, sizeof (time));
+            return time;
+        }
+        if (size == CAPTURE_MAGIC_SIZE && memcmp (pos, CAPTURE_MAGIC, CAPTURE_MAGIC_SIZE) == 0)
+            *new_session = true;
+        pos += size;
+    }
+    return -1;
+}
+
+static void
+replay_advance (void)
+{
+    const gint64 now = g_get_monotonic_time ();
+    bool advanced = false;
+
+    if (replay_speed == 0)
+        advanced = replay_next_tick ();
+    else
+    {
+        /* Catch up with the recorded time, the counters of the skipped ticks are cumulative */
+        bool new_session;
+        for (gint64 next; (next = replay_peek_time (&new_session)) >= 0; )
+        {
+            /* The monotonic clock of another session has an unrelated origin */
+            if (new_session || update_scope.time == 0)
+            {
+                replay_first_time = next;
+                replay_start = now;
+            }
+            if (next > replay_first_time + (gint64) ((now - replay_start) * replay_speed))
+                break;
+            advanced = replay_next_tick () || advanced;
+        }
+    }
+
+    if (!advanced && replay_pos >= replay_end && !replay_finished)
+    {
+        g_message ("The replay of the capture has finished");
+        replay_finished = true;
+    }
+}
+
+static void
+capture_init (void)
+{
+    if (capture_mode >= 0)
+        return;
+    capture_mode = MODE_LIVE;
+
+    const gchar *replay = g_getenv ("SYSTEMLOAD_REPLAY");
+    const gchar *record = g_getenv ("SYSTEMLOAD_RECORD");
+    if (replay && *replay)
+    {
+        replay_init (replay);
+        if (replay_mapping)
+            capture_mode = MODE_REPLAY;
+    }
+    else if (record && *record)
+    {
+        record_init (record);
+        if (record_file)
+            capture_mode = MODE_RECORD;
+    }
+}
+
+
+
+SystemloadProcFile *
+systemload_procfile_open (const gchar *path)
+{
+    return systemload_procfile_open_in_scope (NULL, path);
+}
+
+SystemloadProcFile *
+systemload_procfile_open_in_scope (SystemloadProcScope *scope, const gchar *path)
+{
+    gint fd = -1, capture_id = -1;
+
+    if (scope == NULL)
+        scope = &update_scope;
+
+    capture_init ();
+    if (capture_mode == MODE_REPLAY)
+    {
+        /* The capture only holds the ticks of the regular update */
+        if (scope != &update_scope)
+            return NULL;
+
+        gpointer id = g_hash_table_lookup (replay_ids, path);
+        if (!id)
+            return NULL;
+        capture_id = GPOINTER_TO_INT (id) - 1;
+    }
+    else
+    {
+        fd = open (path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return NULL;
+    }
+
+    SystemloadProcFile *file = g_new0 (SystemloadProcFile, 1);
+    file->path = g_strdup (path);
+    file->scope = scope;
+    file->fd = fd;
+    file->capture_id = capture_id;
+    file->size = INITIAL_BUFFER_SIZE;
+    file->buf = (gchar*) g_malloc0 (file->size + SYSTEMLOAD_PROCFILE_PADDING);
+
+    if (files == NULL)
+        files = g_ptr_array_new ();
+
+    file->slot = -1;
+    for (guint i = 0; i < files->len; i++)
+    {
+        if (g_ptr_array_index (files, i) == NULL)
+        {
+            file->slot = i;
+            files->pdata[i] = file;
+            break;
+        }
+    }
+    if (file->slot < 0)
+    {
+        file->slot = files->len;
+        g_ptr_array_add (files, file);
+    }
+
+#ifdef HAVE_LIBURING
+    ring_files_changed = true;
+#endif
+
+    return file;
+}
+
+void
+systemload_procfile_close (SystemloadProcFile *file)
+{
+    if (file == NULL)
+        return;
+
+    files->pdata[file->slot] = NULL;
+#ifdef HAVE_LIBURING
+    ring_files_changed = true;
+#endif
+
+    if (file->fd >= 0)
+        close (file->fd);
+    g_free (file->buf);
+    g_free (file->path);
+    g_free (file);
+}
+
+const gchar *
+systemload_procfile_get_path (const SystemloadProcFile *file)
+{
+    return file->path;
+}
+
+bool
+systemload_procfile_is_truncated (const SystemloadProcFile *file)
+{
+    return file->truncated;
+}
+
+/* Copies the replayed contents into the buffer, which keeps its padding */
+static bool
+replay_read (SystemloadProcFile *file)
+{
+    const auto contents = &g_array_index (replay_contents, t_replay_contents, file->capture_id);
+    if (!contents->data)
+        return false;
+
+    if (contents->length >= file->size)
+    {
+        file->size = contents->length + 1;
+        file->buf = (gchar*) g_realloc (file->buf, file->size + SYSTEMLOAD_PROCFILE_PADDING);
+    }
+    memcpy (file->buf, contents->data, contents->length);
+    file->length = contents->length;
+    return true;
+}
+
+const gchar *
+systemload_procfile_read (SystemloadProcFile *file, gsize *length)
+{
+    SystemloadProcScope *scope = file->scope;
+    file->used_tick = scope->tick;
+
+    if (file->read_tick != scope->tick && capture_mode == MODE_REPLAY)
+    {
+        if (!replay_read (file))
+            return NULL;
+        file->buf[file->length] = '\0';
+        file->read_tick = scope->tick;
+    }
+    else if (file->read_tick != scope->tick)
+    {
+        /* A seq_file returns about a page per read, usually only a read which returns 0 is the end */
+        file->length = 0;
+        file->truncated = false;
+        while (reserve_read (file))
+        {
+            const gsize requested = file->size - 1 - file->length;
+            ssize_t n = pread (file->fd, file->buf + file->length, requested, file->length);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return NULL;
+            }
+            file->length += n;
+            if (read_is_complete (file, requested, n))
+                break;
+        }
+        file->buf[file->length] = '\0';
+        file->short_file = file->length < SHORT_FILE_SIZE;
+        file->read_tick = scope->tick;
+    }
+
+    if (capture_mode == MODE_RECORD && scope == &update_scope)
+        record_contents (file);
+
+    if (length)
+        *length = file->length;
+    return file->buf;
+}
+
+void
+systemload_procfile_begin_tick (void)
+{
+    update_scope.tick++;
+
+    capture_init ();
+    if (capture_mode == MODE_REPLAY)
+    {
+        replay_advance ();
+        return;
+    }
+
+    update_scope.time = g_get_monotonic_time ();
+    if (capture_mode == MODE_RECORD)
+        fflush (record_file);
+
+#ifdef HAVE_LIBURING
+    if (files != NULL)
+        ring_read_batch ();
+#endif
+}
+
+gint64
+systemload_procfile_get_time (void)
+{
+    return systemload_procfile_scope_get_time (&update_scope);
+}
+
+bool
+systemload_procfile_is_replaying (void)
+{
+    capture_init ();
+    return capture_mode == MODE_REPLAY;
+}
+
+SystemloadProcScope *
+systemload_procfile_scope_new (void)
+{
+    SystemloadProcScope *scope = g_new0 (SystemloadProcScope, 1);
+    scope->tick = 1;
+    return scope;
+}
+
+void
+systemload_procfile_scope_free (SystemloadProcScope *scope)
+{
+    g_free (scope);
+}
+
+void
+systemload_procfile_scope_begin_tick (SystemloadProcScope *scope)
+{
+    if (scope == NULL)
+    {
+        systemload_procfile_begin_tick ();
+        return;
+    }
+
+    scope->tick++;
+    scope->time = g_get_monotonic_time ();
+}
+
+gint64
+systemload_procfile_scope_get_time (const SystemloadProcScope *scope)
+{
+    if (scope == NULL)
+        scope = &update_scope;
+    return scope->time != 0 ? scope->time : g_get_monotonic_time ();
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_PROCFILE_H_
+#define _XFCE_SYSTEMLOAD_PROCFILE_H_
+
+#include <glib.h>
+
+/*
+ * A file in /proc or /sys which is read on every update.
+ *
+ * The file descriptor stays open and the contents are re-read with pread() from offset 0 until
+ * the end of the file, instead of opening and closing the file every time. A file whose contents
+ * were short is read once, longer ones need a read which returns 0 to find their end.
+ *
+ * When built with liburing and SYSTEMLOAD_IO_URING=1 is set, systemload_procfile_begin_tick()
+ * reads all the files which were used in the previous tick with io_uring submissions, and
+ * systemload_procfile_read() then returns those contents without making a system call.
+ * This is not the default: the files in /proc and /sys do not support non-blocking reads, so
+ * io_uring hands each of them to a kernel worker thread, which costs more than the pread() it saves.
+ * See tests/bench-procfile.
+ */
+typedef struct _SystemloadProcFile SystemloadProcFile;
+
+/*
+ * The ticks of one consumer of the files, which decide when the contents are read again.
+ * The regular update uses the default scope, written as NULL, whose ticks are started by
+ * systemload_procfile_begin_tick(). Only the files of the default scope are read in the
+ * io_uring batch and recorded, so that a consumer which samples more often, like the peak
+ * sampler, neither re-reads the files of the update nor adds ticks to a capture. When
+ * replaying, the files of other scopes cannot be opened.
+ */
+typedef struct _SystemloadProcScope SystemloadProcScope;
+
+SystemloadProcScope *systemload_procfile_scope_new        (void);
+void                 systemload_procfile_scope_free       (SystemloadProcScope *scope);
+void                 systemload_procfile_scope_begin_tick (SystemloadProcScope *scope);
+gint64               systemload_procfile_scope_get_time   (const SystemloadProcScope *scope);
+
+/* Returns NULL if the file cannot be opened */
+SystemloadProcFile *systemload_procfile_open       (const gchar        *path);
+SystemloadProcFile *systemload_procfile_open_in_scope (SystemloadProcScope *scope,
+                                                       const gchar         *path);
+void                systemload_procfile_close      (SystemloadProcFile *file);
+const gchar        *systemload_procfile_get_path   (const SystemloadProcFile *file);
+
+/* Number of readable bytes after the terminating NUL of the buffers, for vectorized parsers */
+#define SYSTEMLOAD_PROCFILE_PADDING 64
+
+/*
+ * Returns the NUL-terminated contents of the file for the current tick, or NULL on error.
+ * The buffer is owned by the file and stays valid until the next read.
+ */
+const gchar        *systemload_procfile_read       (SystemloadProcFile *file,
+                                                    gsize              *length);
+
+/*
+ * Whether the contents of the last read did not fit into the largest buffer.
+ * They then end after the last complete line which did.
+ */
+bool                systemload_procfile_is_truncated (const SystemloadProcFile *file);
+
+/* Called once at the start of every update, before any of the files are read */
+void                systemload_procfile_begin_tick (void);
+
+/* Monotonic time of the current tick in µs, the recorded one when replaying */
+gint64              systemload_procfile_get_time   (void);
+
+/* Whether the files are served from a capture, see below */
+bool                systemload_procfile_is_replaying (void);
+
+/*
+ * Capture and replay, selected by environment variables when the first file is opened:
+ *
+ *   SYSTEMLOAD_RECORD=<path>        Appends the contents of every file read in a tick, with the
+ *                                   time of the tick, to a capture file. A file whose contents did
+ *                                   not change since its previous record is stored as a marker.
+ *   SYSTEMLOAD_REPLAY=<path>        Serves the files from a capture instead of the system.
+ *                                   Files which are not in the capture cannot be opened.
+ *   SYSTEMLOAD_REPLAY_SPEED=<x>     Replays x times faster than recorded, the default is 1.
+ *                                   With 0, every tick advances to the next recorded tick.
+ *
+ * Only the files in /proc and /sys are replayed, so the memory, swap and uptime sources should
+ * be set to procfs. The capture is in the byte order of the machine it was recorded on.
+ */
+
+#endif /* _XFCE_SYSTEMLOAD_PROCFILE_H_ */
@@ -0,0 +1,366 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+
+#include <glib.h>
+
+#include "procparse.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+typedef const gchar *(*FindEolFunc) (const gchar *s);
+typedef guint (*ParseUintsFunc) (const gchar *s, guint64 *fields, guint max, const gchar **next);
+
+static FindEolFunc find_eol_impl;
+static ParseUintsFunc parse_uints_impl;
+static ParseUintsFunc parse_uints_wide_impl;
+static const gchar *impl_name;
+
+static const gchar *
+find_eol_scalar (const gchar *s)
+{
+    while (*s != '\n' && *s != '\0')
+        s++;
+    return s;
+}
+
+static guint
+parse_uints_scalar (const gchar *s, guint64 *fields, guint max, const gchar **next)
+{
+    guint n = 0;
+
+    while (n < max)
+    {
+        /* Skip the separators, then accumulate the digits. The line end is never a digit. */
+        while ((guchar) (*s - '0') > 9 && *s != '\n' && *s != '\0')
+            s++;
+        if (*s == '\n' || *s == '\0')
+            break;
+
+        guint64 value = 0;
+        guint digit;
+        while ((digit = (guchar) (*s - '0')) <= 9)
+        {
+            value = 10 * value + digit;
+            s++;
+        }
+        fields[n++] = value;
+    }
+
+    if (next)
+    {
+        s = find_eol_scalar (s);
+        *next = (*s == '\n') ? s + 1 : s;
+    }
+    return n;
+}
+
+#ifdef HAVE_X86_SIMD
+
+/*
+ * The vectorized parser classifies 64 bytes at a time into a mask of digits and a mask of
+ * line ends. The numbers are then found with bit operations on the masks, so the digits are
+ * visited once to accumulate them and the separators are not visited one by one at all.
+ */
+typedef void (*ClassifyFunc) (const gchar *s, guint64 *digits, guint64 *eols);
+
+static ClassifyFunc classify_impl;
+
+__attribute__ ((target ("sse2")))
+static const gchar *
+find_eol_sse2 (const gchar *s)
+{
+    const __m128i newline = _mm_set1_epi8 ('\n');
+    const __m128i zero = _mm_setzero_si128 ();
+
+    for (;; s += 16)
+    {
+        __m128i v = _mm_loadu_si128 ((const __m128i*) s);
+        __m128i m = _mm_or_si128 (_mm_cmpeq_epi8 (v, newline), _mm_cmpeq_epi8 (v, zero));
+        guint mask = _mm_movemask_epi8 (m);
+        if (mask)
+            return s + __builtin_ctz (mask);
+    }
+}
+
+__attribute__ ((target ("sse2")))
+static void
+classify_sse2 (const gchar *s, guint64 *digits, guint64 *eols)
+{
+    const __m128i below_zero = _mm_set1_epi8 ('0' - 1);
+    const __m128i above_nine = _mm_set1_epi8 ('9' + 1);
+    const __m128i newline = _mm_set1_epi8 ('\n');
+    const __m128i zero = _mm_setzero_si128 ();
+
+    *digits = 0;
+    *eols = 0;
+    for (guint i = 0; i < 64; i += 16)
+    {
+        /* The comparisons are signed, bytes above 0x7f are negative and not digits either */
+        __m128i v = _mm_loadu_si128 ((const __m128i*) (s + i));
+        __m128i d = _mm_and_si128 (_mm_cmpgt_epi8 (v, below_zero), _mm_cmplt_epi8 (v, above_nine));
+        __m128i e = _mm_or_si128 (_mm_cmpeq_epi8 (v, newline), _mm_cmpeq_epi8 (v, zero));
+        *digits |= (guint64) (guint) _mm_movemask_epi8 (d) << i;
+        *eols |= (guint64) (guint) _mm_movemask_epi8 (e) << i;
+    }
+}
+
+__attribute__ ((target ("avx2")))
+static const gchar *
+find_eol_avx2 (const gchar *s)
+{
+    const __m256i newline = _mm256_set1_epi8 ('\n');
+    const __m256i zero = _mm256_setzero_si256 ();
+
+    for (;; s += 32)
+    {
+        __m256i v = _mm256_loadu_si256 ((const __m256i*) s);
+        __m256i m = _mm256_or_si256 (_mm256_cmpeq_epi8 (v, newline), _mm256_cmpeq_epi8 (v, zero));
+        guint mask = _mm256_movemask_epi8 (m);
+        if (mask)
+            return s + __builtin_ctz (mask);
+    }
+}
+
+__attribute__ ((target ("avx2")))
+static void
+classify_avx2 (const gchar *s, guint64 *digits, guint64 *eols)
+{
+    const __m256i below_zero = _mm256_set1_epi8 ('0' - 1);
+    const __m256i above_nine = _mm256_set1_epi8 ('9' + 1);
+    const __m256i newline = _mm256_set1_epi8 ('\n');
+    const __m256i zero = _mm256_setzero_si256 ();
+
+    *digits = 0;
+    *eols = 0;
+    for (guint i = 0; i < 64; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256 ((const __m256i*) (s + i));
+        __m256i d = _mm256_and_si256 (_mm256_cmpgt_epi8 (v, below_zero), _mm256_cmpgt_epi8 (above_nine, v));
+        __m256i e = _mm256_or_si256 (_mm256_cmpeq_epi8 (v, newline), _mm256_cmpeq_epi8 (v, zero));
+        *digits |= (guint64) (guint) _mm256_movemask_epi8 (d) << i;
+        *eols |= (guint64) (guint) _mm256_movemask_epi8 (e) << i;
+    }
+}
+
+/*
+ * Converts up to 8 digits at once: the digits are loaded as one little-endian word and shifted
+ * so that the missing leading digits become zeros, then adjacent digits, pairs and quadruples
+ * are combined. The bytes after the digits are shifted out, so they may be anything.
+ */
+static inline guint64
+parse_digits8 (const gchar *p, guint len)
+{
+    guint64 v;
+    memcpy (&v, p, sizeof (v));
+    v = (v - G_GUINT64_CONSTANT (0x3030303030303030)) << (8 * (8 - len));
+    v = (v * 10 + (v >> 8)) & G_GUINT64_CONSTANT (0x00ff00ff00ff00ff);
+    v = (v * 100 + (v >> 16)) & G_GUINT64_CONSTANT (0x0000ffff0000ffff);
+    return (v * 10000 + (v >> 32)) & G_GUINT64_CONSTANT (0x00000000ffffffff);
+}
+
+static inline guint64
+parse_digits (const gchar *p, guint len)
+{
+    /* The first chunk takes the digits which do not fill a chunk of 8 */
+    guint chunk = ((len - 1) & 7) + 1;
+    guint64 value = parse_digits8 (p, chunk);
+    for (p += chunk, len -= chunk; len > 0; p += 8, len -= 8)
+        value = value * 100000000 + parse_digits8 (p, 8);
+    return value;
+}
+
+/*
+ * A block never starts inside a number: it starts either at s, where a number starts by
+ * definition, or right after the last digit of a number which ran past the previous block.
+ */
+static guint
+parse_uints_simd (const gchar *s, guint64 *fields, guint max, const gchar **next)
+{
+    const gchar *block = s;
+    const gchar *eol = NULL;
+    guint n = 0;
+
+    while (n < max)
+    {
+        guint64 digits, eols;
+        classify_impl (block, &digits, &eols);
+
+        /* Only the digits before the line end belong to the line */
+        if (eols)
+            digits &= (eols & -eols) - 1;
+
+        guint64 starts = digits & ~(digits << 1);
+        const gchar *resume = NULL;
+        while (starts && n < max)
+        {
+            const guint pos = __builtin_ctzll (starts);
+            const guint64 rest = ~(digits >> pos);
+            const guint len = rest ? __builtin_ctzll (rest) : 64 - pos;
+
+            const gchar *p = block + pos;
+            guint64 value = parse_digits (p, len);
+            p += len;
+
+            /* The number reaches the end of the block and may go on in the next one */
+            if (pos + len == 64)
+            {
+                guint digit;
+                while ((digit = (guchar) (*p - '0')) <= 9)
+                {
+                    value = 10 * value + digit;
+                    p++;
+                }
+                resume = p;
+            }
+
+            fields[n++] = value;
+            starts &= starts - 1;
+        }
+
+        if (resume)
+            block = resume;
+        else if (n == max)
+            break;
+        else if (eols)
+        {
+            eol = block + __builtin_ctzll (eols);
+            break;
+        }
+        else
+            block += 64;
+    }
+
+    if (next)
+    {
+        /* The line end is only known when the line ran out of numbers before max */
+        if (!eol)
+            eol = find_eol_impl (block);
+        *next = (*eol == '\n') ? eol + 1 : eol;
+    }
+    return n;
+}
+
+#endif /* HAVE_X86_SIMD */
+
+static bool
+set_impl (const gchar *name)
+{
+#ifdef HAVE_X86_SIMD
+    __builtin_cpu_init ();
+    if (strcmp (name, "avx2") == 0 && __builtin_cpu_supports ("avx2"))
+    {
+        find_eol_impl = find_eol_avx2;
+        classify_impl = classify_avx2;
+        parse_uints_impl = parse_uints_wide_impl = parse_uints_simd;
+        impl_name = "avx2";
+        return true;
+    }
+    if (strcmp (name, "sse2") == 0 && __builtin_cpu_supports ("sse2"))
+    {
+        find_eol_impl = find_eol_sse2;
+        classify_impl = classify_sse2;
+        parse_uints_impl = parse_uints_wide_impl = parse_uints_simd;
+        impl_name = "sse2";
+        return true;
+    }
+#endif
+    if (strcmp (name, "scalar") == 0)
+    {
+        find_eol_impl = find_eol_scalar;
+        parse_uints_impl = parse_uints_wide_impl = parse_uints_scalar;
+        impl_name = "scalar";
+        return true;
+    }
+    return false;
+}
+
+/*
+ * The vector code wins on the wide columns of /proc/interrupts, whose numbers are separated by
+ * runs of spaces, but it loses to the scalar loop on lines packed with numbers like those of
+ * /proc/stat, at any number of CPUs: a block of 64 bytes holds about 8 numbers there, and the
+ * cost of classifying the block is not made up for. So the vector code only parses wide lines.
+ */
+static void
+select_impl (void)
+{
+    if (!set_impl ("avx2") && !set_impl ("sse2"))
+        set_impl ("scalar");
+    parse_uints_impl = parse_uints_scalar;
+}
+
+const gchar *
+systemload_find_eol (const gchar *s)
+{
+    if (G_UNLIKELY (find_eol_impl == NULL))
+        select_impl ();
+    return find_eol_impl (s);
+}
+
+guint
+systemload_parse_uints (const gchar *s, guint64 *fields, guint max, const gchar **next)
+{
+    if (G_UNLIKELY (parse_uints_impl == NULL))
+        select_impl ();
+    return parse_uints_impl (s, fields, max, next);
+}
+
+guint
+systemload_parse_uints_wide (const gchar *s, guint64 *fields, guint max, const gchar **next)
+{
+    if (G_UNLIKELY (parse_uints_wide_impl == NULL))
+        select_impl ();
+    return parse_uints_wide_impl (s, fields, max, next);
+}
+
+const gchar *
+systemload_parse_get_impl (void)
+{
+    if (G_UNLIKELY (impl_name == NULL))
+        select_impl ();
+    return impl_name;
+}
+
+gboolean
+systemload_parse_set_impl (const gchar *name)
+{
+    if (strcmp (name, "auto") == 0)
+    {
+        select_impl ();
+        return true;
+    }
+    return set_impl (name);
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_PROCPARSE_H_
+#define _XFCE_SYSTEMLOAD_PROCPARSE_H_
+
+#include <glib.h>
+
+/*
+ * Helpers for parsing the numeric files in /proc without the scanf family.
+ *
+ * Line ends are found 16 or 32 bytes at a time with SSE2 or AVX2, selected at runtime, and the
+ * numbers of wide lines are found in masks of the digits and line ends of 64 bytes at a time.
+ * Lines packed with numbers are parsed by a scalar loop, which is also the fallback on other
+ * architectures. The input must be NUL-terminated and followed by
+ * SYSTEMLOAD_PROCFILE_PADDING readable bytes, as the buffers of procfile.h are.
+ */
+
+/* Returns a pointer to the first '\n' or NUL at or after s */
+const gchar *systemload_find_eol     (const gchar *s);
+
+/*
+ * Parses the unsigned decimal numbers in the line starting at s. Any other characters
+ * separate the numbers, so the "12" of a "cpu12" label is returned as a number too.
+ * Returns the number of values stored into fields, at most max.
+ * If next is not NULL, it is set to the start of the following line, or to the terminating NUL.
+ */
+guint        systemload_parse_uints  (const gchar  *s,
+                                      guint64      *fields,
+                                      guint         max,
+                                      const gchar **next);
+
+/* Like systemload_parse_uints(), for lines whose numbers are padded into wide columns like those of /proc/interrupts */
+guint        systemload_parse_uints_wide (const gchar  *s,
+                                          guint64      *fields,
+                                          guint         max,
+                                          const gchar **next);
+
+/* Name of the implementation in use for wide lines: "avx2", "sse2" or "scalar", for debugging */
+const gchar *systemload_parse_get_impl (void);
+
+/*
+ * Selects an implementation of both parsers by name for tests and benchmarks, returns FALSE if it
+ * is not supported. "auto" restores the selection made at runtime.
+ */
+gboolean     systemload_parse_set_impl (const gchar *name);
+
+#endif /* _XFCE_SYSTEMLOAD_PROCPARSE_H_ */
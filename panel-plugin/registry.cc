@@ -0,0 +1,76 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <libxfce4util/libxfce4util.h>
+
+#include "registry.h"
+
+static const SystemloadMonitorInfo MONITORS[] = {
+    { CPU_MONITOR,  "cpu",        N_("CPU monitor"),        "cpu",  "#1c71d8", true },
+    { MEM_MONITOR,  "memory",     N_("Memory monitor"),     "mem",  "#2ec27e", true },
+    { SWAP_MONITOR, "swap",       N_("Swap monitor"),       "swap", "#f5c211", true },
+    { NET_MONITOR,  "network",    N_("Network monitor"),    "net",  "#e66100", true },
+    /* Added later, kept out of existing panels */
+    { FS_MONITOR,   "filesystem", N_("Filesystem monitor"), "disk", "#c061cb", false },
+    { PAGING_MONITOR, "paging",   N_("Paging monitor"),     "page", "#865e3c", false },
+    { SCHED_MONITOR, "scheduler", N_("Scheduler monitor"),  "run",  "#26a269", false },
+    { IRQ_MONITOR,  "interrupts", N_("Interrupt monitor"),  "irq",  "#e01b24", false },
+    { TCP_MONITOR,  "tcp",        N_("TCP monitor"),        "tcp",  "#1a5fb4", false },
+    { ZRAM_MONITOR, "compression", N_("Compressed memory monitor"), "zram", "#613583", false },
+    { LATENCY_MONITOR, "latency", N_("Scheduler latency monitor"), "lat", "#a347ba", false },
+};
+G_STATIC_ASSERT (G_N_ELEMENTS (MONITORS) == N_MONITORS);
+
+guint
+systemload_registry_get_n_monitors ()
+{
+    return G_N_ELEMENTS (MONITORS);
+}
+
+const SystemloadMonitorInfo *
+systemload_registry_get_nth (guint position)
+{
+    g_return_val_if_fail (position < G_N_ELEMENTS (MONITORS), NULL);
+
+    return &MONITORS[position];
+}
+
+const SystemloadMonitorInfo *
+systemload_registry_get (SystemloadMonitor id)
+{
+    for (gsize i = 0; i < G_N_ELEMENTS (MONITORS); i++)
+        if (MONITORS[i].id == id)
+            return &MONITORS[i];
+
+    g_return_val_if_reached (NULL);
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef _XFCE_SYSTEMLOAD_REGISTRY_H_
+#define _XFCE_SYSTEMLOAD_REGISTRY_H_
+
+#include <glib.h>
+
+#include "settings.h"
+
+/*
+ * Static description of a monitor. The configuration properties "<name>-enabled", "<name>-label", ...
+ * and their xfconf paths "/<name>/enabled", ... are generated from it, as are the monitors in the
+ * panel and their frames in the dialog.
+ */
+struct SystemloadMonitorInfo {
+    SystemloadMonitor  id;
+    const gchar       *name;             /* Also passed to the alert command */
+    const gchar       *title;            /* Frame in the dialog, untranslated */
+    const gchar       *default_label;
+    const gchar       *default_color;
+    bool               default_enabled;
+};
+
+/* The monitors, in the order in which they are shown in the panel and in the dialog */
+guint                        systemload_registry_get_n_monitors (void);
+const SystemloadMonitorInfo *systemload_registry_get_nth        (guint position);
+
+const SystemloadMonitorInfo *systemload_registry_get            (SystemloadMonitor id);
+
+#endif /* _XFCE_SYSTEMLOAD_REGISTRY_H_ */
@@ -0,0 +1,180 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+
+#include <glib.h>
+
+#include "procfile.h"
+#include "procparse.h"
+#include "schedstat.h"
+#include "toplist.h"
+
+#define PROC_SCHEDSTAT "/proc/schedstat"
+
+/*
+ * Columns of the cpu lines since version 15, after the number of the CPU:
+ * yld_count, an unused legacy field, sched_count, sched_goidle, ttwu_count, ttwu_local,
+ * rq_cpu_time, run_delay (ns) and pcount (timeslices)
+ */
+enum { SCHED_CPU, SCHED_RUN_DELAY = 8, SCHED_PCOUNT, N_SCHED_FIELDS };
+
+#define MIN_SCHEDSTAT_VERSION 15
+
+struct SystemloadSchedstatSampler {
+    SystemloadProcFile *proc_schedstat;
+    bool      version_checked;
+    guint64 (*counters)[2];  /* run_delay and pcount of the previous reading, by CPU */
+    guint     max_cpus;
+    gint64    time;           /* Of the previous reading, 0 before the first one */
+};
+
+SystemloadSchedstatSampler *
+systemload_schedstat_sampler_new (void)
+{
+    return g_new0 (SystemloadSchedstatSampler, 1);
+}
+
+void
+systemload_schedstat_sampler_free (SystemloadSchedstatSampler *sampler)
+{
+    if (!sampler)
+        return;
+    if (sampler->proc_schedstat)
+        systemload_procfile_close (sampler->proc_schedstat);
+    g_free (sampler->counters);
+    g_free (sampler);
+}
+
+static bool
+check_version (const gchar *buf)
+{
+    guint64 version;
+
+    if (strncmp (buf, "version ", 8) != 0 || systemload_parse_uints (buf, &version, 1, NULL) != 1)
+        return false;
+    if (version < MIN_SCHEDSTAT_VERSION)
+    {
+        g_warning ("Unsupported %s version %" G_GUINT64_FORMAT, PROC_SCHEDSTAT, version);
+        return false;
+    }
+    return true;
+}
+
+gint
+read_schedstat (SystemloadSchedstatSampler *sampler, SystemloadSchedstat *stat)
+{
+    memset (stat, 0, sizeof (*stat));
+
+    if (!sampler->proc_schedstat && (sampler->proc_schedstat = systemload_procfile_open (PROC_SCHEDSTAT)) == NULL)
+        return -1;
+    const gchar *buf = systemload_procfile_read (sampler->proc_schedstat, NULL);
+    if (!buf)
+        return -1;
+
+    /* The CPUs which were cut off would be missing from the average, the previous reading is kept */
+    if (systemload_procfile_is_truncated (sampler->proc_schedstat))
+        return -1;
+
+    /* Later versions only appended columns so far */
+    if (!sampler->version_checked)
+    {
+        if (!check_version (buf))
+        {
+            systemload_procfile_close (sampler->proc_schedstat);
+            sampler->proc_schedstat = NULL;
+            return -1;
+        }
+        sampler->version_checked = true;
+    }
+
+    const gint64 time = systemload_procfile_get_time ();
+    const gdouble seconds = (sampler->time != 0 && time > sampler->time) ? (time - sampler->time) / 1e6 : 0;
+    sampler->time = time;
+
+    /* The domain lines which follow every cpu line are skipped without being parsed */
+    guint64 total_delay = 0, total_pcount = 0;
+    for (const gchar *line = buf; *line; )
+    {
+        if (strncmp (line, "cpu", 3) != 0)
+        {
+            line = systemload_find_eol (line);
+            if (*line == '\n')
+                line++;
+            continue;
+        }
+
+        guint64 fields[N_SCHED_FIELDS];
+        if (systemload_parse_uints (line, fields, N_SCHED_FIELDS, &line) != N_SCHED_FIELDS || fields[SCHED_CPU] >= G_MAXUINT)
+            continue;
+
+        const guint cpu = fields[SCHED_CPU];
+        if (cpu >= sampler->max_cpus)
+        {
+            guint old_max = sampler->max_cpus;
+            sampler->max_cpus = MAX (cpu + 1, 2 * old_max);
+            sampler->counters = (guint64 (*)[2]) g_realloc (sampler->counters, sampler->max_cpus * sizeof (*sampler->counters));
+            memset (sampler->counters + old_max, 0, (sampler->max_cpus - old_max) * sizeof (*sampler->counters));
+        }
+
+        guint64 *old = sampler->counters[cpu];
+        const bool valid = seconds > 0 && fields[SCHED_RUN_DELAY] >= old[0] && fields[SCHED_PCOUNT] >= old[1] && old[1] != 0;
+        const guint64 delay = valid ? fields[SCHED_RUN_DELAY] - old[0] : 0;
+        const guint64 pcount = valid ? fields[SCHED_PCOUNT] - old[1] : 0;
+        old[0] = fields[SCHED_RUN_DELAY];
+        old[1] = fields[SCHED_PCOUNT];
+        if (pcount == 0)
+            continue;
+
+        total_delay += delay;
+        total_pcount += pcount;
+
+        /* Keep the CPUs with the longest average wait, sorted */
+        const gdouble wait = delay / 1e3 / pcount;
+        guint i;
+        SYSTEMLOAD_TOP_INSERT_POSITION (stat->cpus, stat->n_cpus, SCHEDSTAT_TOP_N, wait, wait, i);
+        if (i < SCHEDSTAT_TOP_N)
+        {
+            stat->cpus[i].cpu = cpu;
+            stat->cpus[i].wait = wait;
+            stat->cpus[i].wait_rate = delay / 1e6 / seconds;
+        }
+    }
+
+    if (total_pcount != 0)
+    {
+        stat->wait = total_delay / 1e3 / total_pcount;
+        stat->wait_rate = total_delay / 1e6 / seconds;
+    }
+
+    return 0;
+}
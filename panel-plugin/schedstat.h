@@ -0,0 +1,64 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_SCHEDSTAT_H_
+#define _XFCE_SYSTEMLOAD_SCHEDSTAT_H_
+
+#include <glib.h>
+
+/* Number of CPUs listed in SystemloadSchedstat */
+#define SCHEDSTAT_TOP_N 4
+
+struct SystemloadSchedCpu {
+    guint    cpu;
+    gdouble  wait;       /* Average time a task waited on the run queue of the CPU before a timeslice, in µs */
+    gdouble  wait_rate;  /* Time waited on the run queue of the CPU, in ms per second */
+};
+
+/* Since the previous reading, all 0 for the first one */
+struct SystemloadSchedstat {
+    gdouble  wait;       /* Average time a task waited on a run queue before a timeslice, in µs */
+    gdouble  wait_rate;  /* Time waited by all the tasks, in ms per second */
+    guint    n_cpus;     /* The CPUs with the longest average wait */
+    SystemloadSchedCpu cpus[SCHEDSTAT_TOP_N];
+};
+
+/* The previous counters of every CPU */
+struct SystemloadSchedstatSampler;
+
+SystemloadSchedstatSampler *systemload_schedstat_sampler_new  (void);
+void                        systemload_schedstat_sampler_free (SystemloadSchedstatSampler *sampler);
+
+/*
+ * Reads run_delay and pcount of the cpu lines of /proc/schedstat, which needs a kernel
+ * with CONFIG_SCHEDSTATS. Returns -1 if the file cannot be read, is truncated or has an unknown
+ * version, which is always the case on platforms other than Linux.
+ */
+gint read_schedstat (SystemloadSchedstatSampler *sampler, SystemloadSchedstat *stat);
+
+#endif /* _XFCE_SYSTEMLOAD_SCHEDSTAT_H_ */
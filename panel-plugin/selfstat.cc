@@ -0,0 +1,132 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#ifdef HAVE_MALLINFO2
+#include <malloc.h>
+#endif
+
+#include <glib.h>
+
+#include "selfstat.h"
+
+#if defined(__linux__)
+#include "procfile.h"
+#define PROC_SELF_STATM "/proc/self/statm"
+#endif
+
+struct SystemloadSelfSampler {
+    gint64   time;      /* Monotonic time of the previous reading, 0 before the first one */
+    gint64   cpu_time;  /* µs */
+    glong    switches;
+    gulong   heap;
+#if defined(__linux__)
+    SystemloadProcFile *statm;
+    gulong   page_kib;
+#endif
+};
+
+SystemloadSelfSampler *
+systemload_self_sampler_new (void)
+{
+    SystemloadSelfSampler *sampler = g_new0 (SystemloadSelfSampler, 1);
+#if defined(__linux__)
+    sampler->page_kib = MAX (sysconf (_SC_PAGESIZE), 1024) / 1024;
+#endif
+    return sampler;
+}
+
+void
+systemload_self_sampler_free (SystemloadSelfSampler *sampler)
+{
+    if (!sampler)
+        return;
+#if defined(__linux__)
+    if (sampler->statm)
+        systemload_procfile_close (sampler->statm);
+#endif
+    g_free (sampler);
+}
+
+static gulong
+read_rss (SystemloadSelfSampler *sampler, const struct rusage *ru)
+{
+#if defined(__linux__)
+    if (!sampler->statm)
+        sampler->statm = systemload_procfile_open (PROC_SELF_STATM);
+    const gchar *buf = sampler->statm ? systemload_procfile_read (sampler->statm, NULL) : NULL;
+    gulong size, resident;
+    if (buf && sscanf (buf, "%lu %lu", &size, &resident) == 2)
+        return resident * sampler->page_kib;
+#endif
+    /* KiB on Linux and the BSDs */
+    return ru->ru_maxrss;
+}
+
+void
+read_self_usage (SystemloadSelfSampler *sampler, SystemloadSelfUsage *usage)
+{
+    struct rusage ru;
+    const gint64 now = g_get_monotonic_time ();
+
+    memset (usage, 0, sizeof (*usage));
+    if (getrusage (RUSAGE_SELF, &ru) != 0)
+        return;
+
+    const gint64 cpu_time = (gint64) (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * G_USEC_PER_SEC +
+                            ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+    const glong switches = ru.ru_nvcsw;
+
+    usage->cpu_seconds = cpu_time / 1e6;
+    usage->rss = read_rss (sampler, &ru);
+#ifdef HAVE_MALLINFO2
+    usage->heap = mallinfo2 ().uordblks / 1024;
+#endif
+
+    if (sampler->time != 0 && now > sampler->time)
+    {
+        const gdouble elapsed = now - sampler->time;
+        usage->cpu = 100 * (cpu_time - sampler->cpu_time) / elapsed;
+        usage->wakeups = (switches - sampler->switches) * 1e6 / elapsed;
+        usage->heap_change = (glong) usage->heap - (glong) sampler->heap;
+    }
+
+    sampler->time = now;
+    sampler->cpu_time = cpu_time;
+    sampler->switches = switches;
+    sampler->heap = usage->heap;
+}
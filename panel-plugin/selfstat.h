@@ -0,0 +1,55 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_SELFSTAT_H_
+#define _XFCE_SYSTEMLOAD_SELFSTAT_H_
+
+#include <glib.h>
+
+/*
+ * The resources used by the process of the plugin, which the panel runs in a wrapper
+ * process of its own. This is the observer effect of the monitors.
+ */
+struct SystemloadSelfUsage {
+    gdouble  cpu_seconds;  /* User and system CPU time since the start of the process */
+    gdouble  cpu;          /* Percent of one CPU since the previous reading */
+    gdouble  wakeups;      /* Voluntary context switches per second since the previous reading */
+    gulong   rss;          /* KiB. The peak RSS on platforms without /proc/self/statm */
+    gulong   heap;         /* KiB allocated with malloc(), 0 if unknown */
+    glong    heap_change;  /* KiB since the previous reading */
+};
+
+struct SystemloadSelfSampler;
+
+SystemloadSelfSampler *systemload_self_sampler_new  (void);
+void                   systemload_self_sampler_free (SystemloadSelfSampler *sampler);
+
+/* The rates of the first reading are 0 */
+void read_self_usage (SystemloadSelfSampler *sampler, SystemloadSelfUsage *usage);
+
+#endif /* _XFCE_SYSTEMLOAD_SELFSTAT_H_ */
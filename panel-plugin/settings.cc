@@ -41,6 +41,7 @@
 #include <libxfce4ui/libxfce4ui.h>
 #include <xfconf/xfconf.h>
 
+#include "registry.h"
 #include "settings.h"
 
 
@@ -49,20 +50,30 @@
 #define DEFAULT_TIMEOUT 500
 #define DEFAULT_TIMEOUT_SECONDS 1
 #define DEFAULT_SYSTEM_MONITOR_COMMAND "xfce4-taskmanager"
-
-static const gchar *const DEFAULT_LABEL[] = {
-    "cpu",
-    "mem",
-    "net",
-    "swap",
-};
-
-static const gchar *const DEFAULT_COLOR[] = {
-    "#1c71d8", /* CPU */
-    "#2ec27e", /* MEM */
-    "#e66100", /* NET */
-    "#f5c211", /* SWAP */
+#define DEFAULT_METRICS_SOCKET ""
+#define DEFAULT_STATISTICS_WINDOW 60
+#define DEFAULT_STATISTICS_HALF_LIFE 5
+#define DEFAULT_ALERT_COMMAND ""
+#define DEFAULT_NETWORK_INCLUDE ""
+#define DEFAULT_NETWORK_EXCLUDE ""
+#define DEFAULT_FILESYSTEM_MOUNT_POINTS ""
+#define DEFAULT_FILESYSTEM_INTERVAL 30
+#define DEFAULT_LATENCY_BUDGET 2000
+#define DEFAULT_POWER_SAVER_MULTIPLIER 2
+#define DEFAULT_PEAK_INTERVAL 100
+#define DEFAULT_PEAK_BUDGET 1
+#define DEFAULT_SELF_BUDGET 0
+#define DEFAULT_ALERT_INTERVAL 300
+#define DEFAULT_ALERT_HOLD 10
+#define DEFAULT_ALERT_HYSTERESIS 5
+
+/* Factors by which the update interval is stretched in every power state */
+static const guint DEFAULT_POWER_MULTIPLIER[] = {
+    1,  /* POWER_STATE_AC */
+    1,  /* POWER_STATE_BATTERY, the interval is already the power-saving one */
+    4,  /* POWER_STATE_LOW_BATTERY */
 };
+G_STATIC_ASSERT (G_N_ELEMENTS (DEFAULT_POWER_MULTIPLIER) == N_POWER_STATES);
 
 
 
@@ -91,6 +102,29 @@ struct _SystemloadConfig {
   guint            timeout;
   guint            timeout_seconds;
   gchar           *system_monitor_command;
+  gchar           *metrics_socket;
+  bool             history;
+  guint            statistics_window;
+  guint            statistics_half_life;
+  gchar           *alert_command;
+  guint            alert_interval;
+  SystemloadCpuDisplay cpu_display_mode;
+  bool             cpu_heatmap_grouping;
+  bool             memory_numa_split;
+  gchar           *network_include;
+  gchar           *network_exclude;
+  gchar           *filesystem_mount_points;
+  guint            filesystem_interval;
+  guint            latency_budget;
+  guint            power_multiplier[N_POWER_STATES];
+  guint            power_saver_multiplier;
+  guint            peak_interval;
+  guint            peak_budget;
+  bool             self_metrics;
+  guint            self_budget;
+  SystemloadSource memory_source;
+  SystemloadSource swap_source;
+  SystemloadSource uptime_source;
   bool             uptime;
 
   struct {
@@ -98,7 +132,12 @@ struct _SystemloadConfig {
     bool           use_label;
     gchar         *label;
     GdkRGBA        color;
-  } monitor[4];
+    SystemloadStatistic statistic;
+    guint          alert_threshold;
+    guint          alert_hold;
+    guint          alert_hysteresis;
+    bool           on_battery;
+  } monitor[N_MONITORS];
 };
 
 enum SystemloadProperty {
@@ -106,25 +145,64 @@ enum SystemloadProperty {
     PROP_TIMEOUT,
     PROP_TIMEOUT_SECONDS,
     PROP_SYSTEM_MONITOR_COMMAND,
+    PROP_METRICS_SOCKET,
+    PROP_HISTORY,
+    PROP_STATISTICS_WINDOW,
+    PROP_STATISTICS_HALF_LIFE,
+    PROP_ALERT_COMMAND,
+    PROP_ALERT_INTERVAL,
+    PROP_CPU_DISPLAY_MODE,
+    PROP_CPU_HEATMAP_GROUPING,
+    PROP_MEMORY_NUMA_SPLIT,
+    PROP_NETWORK_INCLUDE,
+    PROP_NETWORK_EXCLUDE,
+    PROP_FILESYSTEM_MOUNT_POINTS,
+    PROP_FILESYSTEM_INTERVAL,
+    PROP_LATENCY_BUDGET,
+    PROP_POWER_AC_MULTIPLIER,
+    PROP_POWER_BATTERY_MULTIPLIER,
+    PROP_POWER_LOW_BATTERY_MULTIPLIER,
+    PROP_POWER_SAVER_MULTIPLIER,
+    PROP_PEAK_INTERVAL,
+    PROP_PEAK_BUDGET,
+    PROP_SELF_METRICS,
+    PROP_SELF_BUDGET,
+    PROP_MEMORY_SOURCE,
+    PROP_SWAP_SOURCE,
+    PROP_UPTIME_SOURCE,
     PROP_UPTIME,
-    PROP_CPU_ENABLED,
-    PROP_CPU_USE_LABEL,
-    PROP_CPU_LABEL,
-    PROP_CPU_COLOR,
-    PROP_MEMORY_ENABLED,
-    PROP_MEMORY_USE_LABEL,
-    PROP_MEMORY_LABEL,
-    PROP_MEMORY_COLOR,
-    PROP_NETWORK_ENABLED,
-    PROP_NETWORK_USE_LABEL,
-    PROP_NETWORK_LABEL,
-    PROP_NETWORK_COLOR,
-    PROP_SWAP_ENABLED,
-    PROP_SWAP_USE_LABEL,
-    PROP_SWAP_LABEL,
-    PROP_SWAP_COLOR,
-    N_PROPERTIES,
+    PROP_MONITOR_FIRST,  /* Followed by N_MONITOR_PROPERTIES properties for every monitor */
+};
+
+/* The properties which every monitor has, named "<monitor>-<suffix>" */
+enum SystemloadMonitorProperty {
+    MONITOR_PROP_ENABLED,
+    MONITOR_PROP_USE_LABEL,
+    MONITOR_PROP_LABEL,
+    MONITOR_PROP_COLOR,
+    MONITOR_PROP_STATISTIC,
+    MONITOR_PROP_ALERT_THRESHOLD,
+    MONITOR_PROP_ALERT_HOLD,
+    MONITOR_PROP_ALERT_HYSTERESIS,
+    MONITOR_PROP_ON_BATTERY,
+    N_MONITOR_PROPERTIES,
+};
+
+/* Also the last component of the xfconf path "/<monitor>/<suffix>" */
+static const gchar *const MONITOR_PROPERTY_SUFFIX[] = {
+    "enabled",
+    "use-label",
+    "label",
+    "color",
+    "statistic",
+    "alert-threshold",
+    "alert-hold",
+    "alert-hysteresis",
+    "on-battery",
 };
+G_STATIC_ASSERT (G_N_ELEMENTS (MONITOR_PROPERTY_SUFFIX) == N_MONITOR_PROPERTIES);
+
+#define PROP_MONITOR_LAST (PROP_MONITOR_FIRST + N_MONITORS * N_MONITOR_PROPERTIES)
 
 enum {
     CONFIGURATION_CHANGED,
@@ -134,34 +212,21 @@ enum {
 static guint systemload_config_signals [LAST_SIGNAL] = { 0, };
 
 static SystemloadMonitor
-prop2monitor (SystemloadProperty p)
+prop2monitor (guint prop_id)
 {
-  switch (p)
-    {
-    case PROP_CPU_ENABLED:
-    case PROP_CPU_USE_LABEL:
-    case PROP_CPU_LABEL:
-    case PROP_CPU_COLOR:
-      return CPU_MONITOR;
-    case PROP_MEMORY_ENABLED:
-    case PROP_MEMORY_USE_LABEL:
-    case PROP_MEMORY_LABEL:
-    case PROP_MEMORY_COLOR:
-      return MEM_MONITOR;
-    case PROP_NETWORK_ENABLED:
-    case PROP_NETWORK_USE_LABEL:
-    case PROP_NETWORK_LABEL:
-    case PROP_NETWORK_COLOR:
-      return NET_MONITOR;
-    case PROP_SWAP_ENABLED:
-    case PROP_SWAP_USE_LABEL:
-    case PROP_SWAP_LABEL:
-    case PROP_SWAP_COLOR:
-      return SWAP_MONITOR;
-    default:
-      /* Ideally, this codepath is never reached */
-      return CPU_MONITOR;
-    }
+  return SystemloadMonitor ((prop_id - PROP_MONITOR_FIRST) / N_MONITOR_PROPERTIES);
+}
+
+static SystemloadMonitorProperty
+prop2field (guint prop_id)
+{
+  return SystemloadMonitorProperty ((prop_id - PROP_MONITOR_FIRST) % N_MONITOR_PROPERTIES);
+}
+
+static gchar *
+monitor_property_name (SystemloadMonitor monitor, SystemloadMonitorProperty field)
+{
+  return g_strconcat (systemload_registry_get (monitor)->name, "-", MONITOR_PROPERTY_SUFFIX[field], NULL);
 }
 
 static GdkRGBA
@@ -192,7 +257,7 @@ static bool
 is_default_color (SystemloadMonitor m, const GdkRGBA *color)
 {
   GdkRGBA default_color;
-  if (G_LIKELY (gdk_rgba_parse (&default_color, DEFAULT_COLOR[m])))
+  if (G_LIKELY (gdk_rgba_parse (&default_color, systemload_registry_get (m)->default_color)))
     return rgba_equal (*color, default_color);
   else
     return FALSE;
@@ -234,110 +299,211 @@ systemload_config_class_init (SystemloadConfigClass *klass)
                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_UPTIME,
-                                   g_param_spec_boolean ("uptime-enabled", NULL, NULL,
-                                                         TRUE,
-                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_METRICS_SOCKET,
+                                   g_param_spec_string ("metrics-socket", NULL, NULL,
+                                                        DEFAULT_METRICS_SOCKET,
+                                                        GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_CPU_ENABLED,
-                                   g_param_spec_boolean ("cpu-enabled", NULL, NULL,
+                                   PROP_HISTORY,
+                                   g_param_spec_boolean ("history-enabled", NULL, NULL,
                                                          TRUE,
                                                          GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_CPU_USE_LABEL,
-                                   g_param_spec_boolean ("cpu-use-label", NULL, NULL,
-                                                         TRUE,
-                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_STATISTICS_WINDOW,
+                                   g_param_spec_uint ("statistics-window", NULL, NULL,
+                                                      10, 3600, DEFAULT_STATISTICS_WINDOW,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+  g_object_class_install_property (gobject_class,
+                                   PROP_STATISTICS_HALF_LIFE,
+                                   g_param_spec_uint ("statistics-half-life", NULL, NULL,
+                                                      1, 600, DEFAULT_STATISTICS_HALF_LIFE,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_CPU_LABEL,
-                                   g_param_spec_string ("cpu-label", NULL, NULL,
-                                                        DEFAULT_LABEL[CPU_MONITOR],
+                                   PROP_ALERT_COMMAND,
+                                   g_param_spec_string ("alert-command", NULL, NULL,
+                                                        DEFAULT_ALERT_COMMAND,
                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_CPU_COLOR,
-                                   g_param_spec_boxed ("cpu-color",
-                                                       NULL, NULL,
-                                                       GDK_TYPE_RGBA,
-                                                       GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_ALERT_INTERVAL,
+                                   g_param_spec_uint ("alert-interval", NULL, NULL,
+                                                      1, 86400, DEFAULT_ALERT_INTERVAL,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+  g_object_class_install_property (gobject_class,
+                                   PROP_CPU_DISPLAY_MODE,
+                                   g_param_spec_uint ("cpu-display-mode", NULL, NULL,
+                                                      CPU_DISPLAY_BAR, CPU_DISPLAY_HEATMAP, CPU_DISPLAY_BAR,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_MEMORY_ENABLED,
-                                   g_param_spec_boolean ("memory-enabled", NULL, NULL,
+                                   PROP_CPU_HEATMAP_GROUPING,
+                                   g_param_spec_boolean ("cpu-heatmap-grouping", NULL, NULL,
                                                          TRUE,
                                                          GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_MEMORY_USE_LABEL,
-                                   g_param_spec_boolean ("memory-use-label", NULL, NULL,
-                                                         TRUE,
+                                   PROP_MEMORY_NUMA_SPLIT,
+                                   g_param_spec_boolean ("memory-numa-split", NULL, NULL,
+                                                         FALSE,
                                                          GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_MEMORY_LABEL,
-                                   g_param_spec_string ("memory-label", NULL, NULL,
-                                                        DEFAULT_LABEL[MEM_MONITOR],
+                                   PROP_NETWORK_INCLUDE,
+                                   g_param_spec_string ("network-include", NULL, NULL,
+                                                        DEFAULT_NETWORK_INCLUDE,
                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_MEMORY_COLOR,
-                                   g_param_spec_boxed ("memory-color",
-                                                       NULL, NULL,
-                                                       GDK_TYPE_RGBA,
-                                                       GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_NETWORK_EXCLUDE,
+                                   g_param_spec_string ("network-exclude", NULL, NULL,
+                                                        DEFAULT_NETWORK_EXCLUDE,
+                                                        GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_NETWORK_ENABLED,
-                                   g_param_spec_boolean ("network-enabled", NULL, NULL,
-                                                         TRUE,
-                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_FILESYSTEM_MOUNT_POINTS,
+                                   g_param_spec_string ("filesystem-mount-points", NULL, NULL,
+                                                        DEFAULT_FILESYSTEM_MOUNT_POINTS,
+                                                        GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_NETWORK_USE_LABEL,
-                                   g_param_spec_boolean ("network-use-label", NULL, NULL,
-                                                         TRUE,
-                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_FILESYSTEM_INTERVAL,
+                                   g_param_spec_uint ("filesystem-interval", NULL, NULL,
+                                                      1, 3600, DEFAULT_FILESYSTEM_INTERVAL,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_NETWORK_LABEL,
-                                   g_param_spec_string ("network-label", NULL, NULL,
-                                                        DEFAULT_LABEL[NET_MONITOR],
-                                                        GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_LATENCY_BUDGET,
+                                   g_param_spec_uint ("latency-budget", NULL, NULL,
+                                                      100, 1000000, DEFAULT_LATENCY_BUDGET,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_NETWORK_COLOR,
-                                   g_param_spec_boxed ("network-color",
-                                                       NULL, NULL,
-                                                       GDK_TYPE_RGBA,
-                                                       GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_POWER_AC_MULTIPLIER,
+                                   g_param_spec_uint ("power-ac-multiplier", NULL, NULL,
+                                                      1, 60, DEFAULT_POWER_MULTIPLIER[POWER_STATE_AC],
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_SWAP_ENABLED,
-                                   g_param_spec_boolean ("swap-enabled", NULL, NULL,
-                                                         TRUE,
-                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_POWER_BATTERY_MULTIPLIER,
+                                   g_param_spec_uint ("power-battery-multiplier", NULL, NULL,
+                                                      1, 60, DEFAULT_POWER_MULTIPLIER[POWER_STATE_BATTERY],
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_SWAP_USE_LABEL,
-                                   g_param_spec_boolean ("swap-use-label", NULL, NULL,
-                                                         TRUE,
+                                   PROP_POWER_LOW_BATTERY_MULTIPLIER,
+                                   g_param_spec_uint ("power-low-battery-multiplier", NULL, NULL,
+                                                      1, 60, DEFAULT_POWER_MULTIPLIER[POWER_STATE_LOW_BATTERY],
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+  g_object_class_install_property (gobject_class,
+                                   PROP_POWER_SAVER_MULTIPLIER,
+                                   g_param_spec_uint ("power-saver-multiplier", NULL, NULL,
+                                                      1, 60, DEFAULT_POWER_SAVER_MULTIPLIER,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+  g_object_class_install_property (gobject_class,
+                                   PROP_PEAK_INTERVAL,
+                                   g_param_spec_uint ("peak-interval", NULL, NULL,
+                                                      MIN_PEAK_INTERVAL, MAX_PEAK_INTERVAL, DEFAULT_PEAK_INTERVAL,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+  g_object_class_install_property (gobject_class,
+                                   PROP_PEAK_BUDGET,
+                                   g_param_spec_uint ("peak-budget", NULL, NULL,
+                                                      1, 25, DEFAULT_PEAK_BUDGET,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+  g_object_class_install_property (gobject_class,
+                                   PROP_SELF_METRICS,
+                                   g_param_spec_boolean ("self-metrics", NULL, NULL,
+                                                         FALSE,
                                                          GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_SWAP_LABEL,
-                                   g_param_spec_string ("swap-label", NULL, NULL,
-                                                        DEFAULT_LABEL[SWAP_MONITOR],
-                                                        GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_SELF_BUDGET,
+                                   g_param_spec_uint ("self-budget", NULL, NULL,
+                                                      0, 100, DEFAULT_SELF_BUDGET,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+  g_object_class_install_property (gobject_class,
+                                   PROP_MEMORY_SOURCE,
+                                   g_param_spec_uint ("memory-source", NULL, NULL,
+                                                      SOURCE_AUTO, SOURCE_SYSCALL, SOURCE_AUTO,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+  g_object_class_install_property (gobject_class,
+                                   PROP_SWAP_SOURCE,
+                                   g_param_spec_uint ("swap-source", NULL, NULL,
+                                                      SOURCE_AUTO, SOURCE_SYSCALL, SOURCE_AUTO,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+  g_object_class_install_property (gobject_class,
+                                   PROP_UPTIME_SOURCE,
+                                   g_param_spec_uint ("uptime-source", NULL, NULL,
+                                                      SOURCE_AUTO, SOURCE_SYSCALL, SOURCE_AUTO,
+                                                      GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
   g_object_class_install_property (gobject_class,
-                                   PROP_SWAP_COLOR,
-                                   g_param_spec_boxed ("swap-color",
-                                                       NULL, NULL,
-                                                       GDK_TYPE_RGBA,
-                                                       GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                                   PROP_UPTIME,
+                                   g_param_spec_boolean ("uptime-enabled", NULL, NULL,
+                                                         TRUE,
+                                                         GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+  for (guint m = 0; m < N_MONITORS; m++)
+    {
+      const SystemloadMonitorInfo *info = systemload_registry_get (SystemloadMonitor (m));
+      const GParamFlags flags = GParamFlags (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+      for (guint field = 0; field < N_MONITOR_PROPERTIES; field++)
+        {
+          gchar *name = monitor_property_name (SystemloadMonitor (m), SystemloadMonitorProperty (field));
+          /* Interned strings are never freed, as G_PARAM_STATIC_NAME requires */
+          const gchar *static_name = g_intern_string (name);
+          GParamSpec *pspec = NULL;
+
+          switch (SystemloadMonitorProperty (field))
+            {
+            case MONITOR_PROP_ENABLED:
+              pspec = g_param_spec_boolean (static_name, NULL, NULL, info->default_enabled, flags);
+              break;
+            case MONITOR_PROP_USE_LABEL:
+              pspec = g_param_spec_boolean (static_name, NULL, NULL, TRUE, flags);
+              break;
+            case MONITOR_PROP_LABEL:
+              pspec = g_param_spec_string (static_name, NULL, NULL, info->default_label, flags);
+              break;
+            case MONITOR_PROP_COLOR:
+              pspec = g_param_spec_boxed (static_name, NULL, NULL, GDK_TYPE_RGBA, flags);
+              break;
+            case MONITOR_PROP_STATISTIC:
+              pspec = g_param_spec_uint (static_name, NULL, NULL,
+                                         STATISTIC_CURRENT, STATISTIC_PEAK, STATISTIC_CURRENT, flags);
+              break;
+            case MONITOR_PROP_ALERT_THRESHOLD:
+              pspec = g_param_spec_uint (static_name, NULL, NULL, 0, 100, 0, flags);
+              break;
+            case MONITOR_PROP_ALERT_HOLD:
+              pspec = g_param_spec_uint (static_name, NULL, NULL, 0, 3600, DEFAULT_ALERT_HOLD, flags);
+              break;
+            case MONITOR_PROP_ALERT_HYSTERESIS:
+              pspec = g_param_spec_uint (static_name, NULL, NULL, 0, 100, DEFAULT_ALERT_HYSTERESIS, flags);
+              break;
+            case MONITOR_PROP_ON_BATTERY:
+              pspec = g_param_spec_boolean (static_name, NULL, NULL, TRUE, flags);
+              break;
+            case N_MONITOR_PROPERTIES:
+              break;
+            }
+
+          g_object_class_install_property (gobject_class, PROP_MONITOR_FIRST + m * N_MONITOR_PROPERTIES + field, pspec);
+          g_free (name);
+        }
+    }
 
   systemload_config_signals[CONFIGURATION_CHANGED] =
     g_signal_new (g_intern_static_string ("configuration-changed"),
@@ -356,13 +522,43 @@ systemload_config_init (SystemloadConfig *config)
   config->timeout = DEFAULT_TIMEOUT;
   config->timeout_seconds = DEFAULT_TIMEOUT_SECONDS;
   config->system_monitor_command = g_strdup (DEFAULT_SYSTEM_MONITOR_COMMAND);
+  config->metrics_socket = g_strdup (DEFAULT_METRICS_SOCKET);
+  config->history = true;
+  config->statistics_window = DEFAULT_STATISTICS_WINDOW;
+  config->statistics_half_life = DEFAULT_STATISTICS_HALF_LIFE;
+  config->alert_command = g_strdup (DEFAULT_ALERT_COMMAND);
+  config->alert_interval = DEFAULT_ALERT_INTERVAL;
+  config->cpu_display_mode = CPU_DISPLAY_BAR;
+  config->cpu_heatmap_grouping = true;
+  config->memory_numa_split = false;
+  config->network_include = g_strdup (DEFAULT_NETWORK_INCLUDE);
+  config->network_exclude = g_strdup (DEFAULT_NETWORK_EXCLUDE);
+  config->filesystem_mount_points = g_strdup (DEFAULT_FILESYSTEM_MOUNT_POINTS);
+  config->filesystem_interval = DEFAULT_FILESYSTEM_INTERVAL;
+  config->latency_budget = DEFAULT_LATENCY_BUDGET;
+  for (gsize i = 0; i < G_N_ELEMENTS (config->power_multiplier); i++)
+    config->power_multiplier[i] = DEFAULT_POWER_MULTIPLIER[i];
+  config->power_saver_multiplier = DEFAULT_POWER_SAVER_MULTIPLIER;
+  config->peak_interval = DEFAULT_PEAK_INTERVAL;
+  config->peak_budget = DEFAULT_PEAK_BUDGET;
+  config->self_metrics = false;
+  config->self_budget = DEFAULT_SELF_BUDGET;
+  config->memory_source = SOURCE_AUTO;
+  config->swap_source = SOURCE_AUTO;
+  config->uptime_source = SOURCE_AUTO;
   config->uptime = true;
   for (gsize i = 0; i < G_N_ELEMENTS (config->monitor); i++)
     {
-      config->monitor[i].enabled = true;
+      const SystemloadMonitorInfo *info = systemload_registry_get (SystemloadMonitor (i));
+      config->monitor[i].enabled = info->default_enabled;
       config->monitor[i].use_label = true;
-      config->monitor[i].label = g_strdup (DEFAULT_LABEL[i]);
-      gdk_rgba_parse (&config->monitor[i].color, DEFAULT_COLOR[i]);
+      config->monitor[i].label = g_strdup (info->default_label);
+      gdk_rgba_parse (&config->monitor[i].color, info->default_color);
+      config->monitor[i].statistic = STATISTIC_CURRENT;
+      config->monitor[i].alert_threshold = 0;
+      config->monitor[i].alert_hold = DEFAULT_ALERT_HOLD;
+      config->monitor[i].alert_hysteresis = DEFAULT_ALERT_HYSTERESIS;
+      config->monitor[i].on_battery = true;
     }
 }
 
@@ -376,6 +572,11 @@ systemload_config_finalize (GObject *object)
   xfconf_shutdown();
   g_free (config->property_base);
   g_free (config->system_monitor_command);
+  g_free (config->metrics_socket);
+  g_free (config->alert_command);
+  g_free (config->network_include);
+  g_free (config->network_exclude);
+  g_free (config->filesystem_mount_points);
   for (gsize i = 0; i < G_N_ELEMENTS (config->monitor); i++)
     g_free (config->monitor[i].label);
 
@@ -384,6 +585,132 @@ systemload_config_finalize (GObject *object)
 
 
 
+static void
+monitor_get_property (const SystemloadConfig *config,
+                      guint                   prop_id,
+                      GValue                 *value)
+{
+  auto m = &config->monitor[prop2monitor (prop_id)];
+
+  switch (prop2field (prop_id))
+    {
+    case MONITOR_PROP_ENABLED:
+      g_value_set_boolean (value, m->enabled);
+      break;
+    case MONITOR_PROP_USE_LABEL:
+      g_value_set_boolean (value, m->use_label);
+      break;
+    case MONITOR_PROP_LABEL:
+      g_value_set_string (value, m->label);
+      break;
+    case MONITOR_PROP_COLOR:
+      g_value_set_boxed (value, &m->color);
+      break;
+    case MONITOR_PROP_STATISTIC:
+      g_value_set_uint (value, m->statistic);
+      break;
+    case MONITOR_PROP_ALERT_THRESHOLD:
+      g_value_set_uint (value, m->alert_threshold);
+      break;
+    case MONITOR_PROP_ALERT_HOLD:
+      g_value_set_uint (value, m->alert_hold);
+      break;
+    case MONITOR_PROP_ALERT_HYSTERESIS:
+      g_value_set_uint (value, m->alert_hysteresis);
+      break;
+    case MONITOR_PROP_ON_BATTERY:
+      g_value_set_boolean (value, m->on_battery);
+      break;
+    case N_MONITOR_PROPERTIES:
+      break;
+    }
+}
+
+static void
+monitor_set_property (SystemloadConfig *config,
+                      guint             prop_id,
+                      const GValue     *value,
+                      GParamSpec       *pspec)
+{
+  const SystemloadMonitor monitor = prop2monitor (prop_id);
+  auto m = &config->monitor[monitor];
+  const GdkRGBA *val_rgba;
+  bool changed = false;
+
+  switch (prop2field (prop_id))
+    {
+    case MONITOR_PROP_ENABLED:
+      changed = (m->enabled != (bool) g_value_get_boolean (value));
+      m->enabled = g_value_get_boolean (value);
+      break;
+
+    case MONITOR_PROP_USE_LABEL:
+      changed = (m->use_label != (bool) g_value_get_boolean (value));
+      m->use_label = g_value_get_boolean (value);
+      break;
+
+    case MONITOR_PROP_LABEL:
+      if (g_strcmp0 (m->label, g_value_get_string (value)) != 0)
+        {
+          g_free (m->label);
+          m->label = g_value_dup_string (value);
+          changed = true;
+        }
+      break;
+
+    case MONITOR_PROP_COLOR:
+      val_rgba = (const GdkRGBA*) g_value_get_boxed (value);
+      if (!rgba_equal (m->color, *val_rgba))
+        {
+          m->color = *val_rgba;
+          changed = true;
+        }
+      if (is_default_color (monitor, val_rgba))
+        {
+          char *property = g_strconcat (config->property_base, "/", systemload_registry_get (monitor)->name, "/color", NULL);
+          xfconf_channel_reset_property (config->channel, property, TRUE);
+          g_free (property);
+        }
+      break;
+
+    case MONITOR_PROP_STATISTIC:
+      changed = (m->statistic != g_value_get_uint (value));
+      m->statistic = SystemloadStatistic (g_value_get_uint (value));
+      break;
+
+    case MONITOR_PROP_ALERT_THRESHOLD:
+      changed = (m->alert_threshold != g_value_get_uint (value));
+      m->alert_threshold = g_value_get_uint (value);
+      break;
+
+    case MONITOR_PROP_ALERT_HOLD:
+      changed = (m->alert_hold != g_value_get_uint (value));
+      m->alert_hold = g_value_get_uint (value);
+      break;
+
+    case MONITOR_PROP_ALERT_HYSTERESIS:
+      changed = (m->alert_hysteresis != g_value_get_uint (value));
+      m->alert_hysteresis = g_value_get_uint (value);
+      break;
+
+    case MONITOR_PROP_ON_BATTERY:
+      changed = (m->on_battery != (bool) g_value_get_boolean (value));
+      m->on_battery = g_value_get_boolean (value);
+      break;
+
+    case N_MONITOR_PROPERTIES:
+      break;
+    }
+
+  if (changed)
+    {
+      g_object_notify_by_pspec (G_OBJECT (config), pspec);
+      g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+    }
+}
+
+
+
 static void
 systemload_config_get_property (GObject    *object,
                                 guint       _prop_id,
@@ -407,40 +734,115 @@ systemload_config_get_property (GObject    *object,
       g_value_set_string (value, config->system_monitor_command);
       break;
 
-    case PROP_UPTIME:
-      g_value_set_boolean (value, config->uptime);
+    case PROP_METRICS_SOCKET:
+      g_value_set_string (value, config->metrics_socket);
       break;
 
-    case PROP_CPU_ENABLED:
-    case PROP_MEMORY_ENABLED:
-    case PROP_NETWORK_ENABLED:
-    case PROP_SWAP_ENABLED:
-      g_value_set_boolean (value, config->monitor[prop2monitor(prop_id)].enabled);
+    case PROP_HISTORY:
+      g_value_set_boolean (value, config->history);
       break;
 
-    case PROP_CPU_USE_LABEL:
-    case PROP_MEMORY_USE_LABEL:
-    case PROP_NETWORK_USE_LABEL:
-    case PROP_SWAP_USE_LABEL:
-      g_value_set_boolean (value, config->monitor[prop2monitor(prop_id)].use_label);
+    case PROP_STATISTICS_WINDOW:
+      g_value_set_uint (value, config->statistics_window);
       break;
 
-    case PROP_CPU_LABEL:
-    case PROP_MEMORY_LABEL:
-    case PROP_NETWORK_LABEL:
-    case PROP_SWAP_LABEL:
-      g_value_set_string (value, config->monitor[prop2monitor(prop_id)].label);
+    case PROP_STATISTICS_HALF_LIFE:
+      g_value_set_uint (value, config->statistics_half_life);
       break;
 
-    case PROP_CPU_COLOR:
-    case PROP_MEMORY_COLOR:
-    case PROP_NETWORK_COLOR:
-    case PROP_SWAP_COLOR:
-      g_value_set_boxed (value, &config->monitor[prop2monitor(prop_id)].color);
+    case PROP_ALERT_COMMAND:
+      g_value_set_string (value, config->alert_command);
+      break;
+
+    case PROP_ALERT_INTERVAL:
+      g_value_set_uint (value, config->alert_interval);
+      break;
+
+    case PROP_CPU_DISPLAY_MODE:
+      g_value_set_uint (value, config->cpu_display_mode);
+      break;
+
+    case PROP_CPU_HEATMAP_GROUPING:
+      g_value_set_boolean (value, config->cpu_heatmap_grouping);
+      break;
+
+    case PROP_MEMORY_NUMA_SPLIT:
+      g_value_set_boolean (value, config->memory_numa_split);
+      break;
+
+    case PROP_NETWORK_INCLUDE:
+      g_value_set_string (value, config->network_include);
+      break;
+
+    case PROP_NETWORK_EXCLUDE:
+      g_value_set_string (value, config->network_exclude);
+      break;
+
+    case PROP_FILESYSTEM_MOUNT_POINTS:
+      g_value_set_string (value, config->filesystem_mount_points);
+      break;
+
+    case PROP_FILESYSTEM_INTERVAL:
+      g_value_set_uint (value, config->filesystem_interval);
+      break;
+
+    case PROP_LATENCY_BUDGET:
+      g_value_set_uint (value, config->latency_budget);
+      break;
+
+    case PROP_POWER_AC_MULTIPLIER:
+      g_value_set_uint (value, config->power_multiplier[POWER_STATE_AC]);
+      break;
+
+    case PROP_POWER_BATTERY_MULTIPLIER:
+      g_value_set_uint (value, config->power_multiplier[POWER_STATE_BATTERY]);
+      break;
+
+    case PROP_POWER_LOW_BATTERY_MULTIPLIER:
+      g_value_set_uint (value, config->power_multiplier[POWER_STATE_LOW_BATTERY]);
+      break;
+
+    case PROP_POWER_SAVER_MULTIPLIER:
+      g_value_set_uint (value, config->power_saver_multiplier);
+      break;
+
+    case PROP_PEAK_INTERVAL:
+      g_value_set_uint (value, config->peak_interval);
+      break;
+
+    case PROP_PEAK_BUDGET:
+      g_value_set_uint (value, config->peak_budget);
+      break;
+
+    case PROP_SELF_METRICS:
+      g_value_set_boolean (value, config->self_metrics);
+      break;
+
+    case PROP_SELF_BUDGET:
+      g_value_set_uint (value, config->self_budget);
+      break;
+
+    case PROP_MEMORY_SOURCE:
+      g_value_set_uint (value, config->memory_source);
+      break;
+
+    case PROP_SWAP_SOURCE:
+      g_value_set_uint (value, config->swap_source);
+      break;
+
+    case PROP_UPTIME_SOURCE:
+      g_value_set_uint (value, config->uptime_source);
+      break;
+
+    case PROP_UPTIME:
+      g_value_set_boolean (value, config->uptime);
       break;
 
     default:
-      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      if (prop_id >= PROP_MONITOR_FIRST && prop_id < PROP_MONITOR_LAST)
+        monitor_get_property (config, prop_id, value);
+      else
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
     }
 }
@@ -455,7 +857,6 @@ systemload_config_set_property (GObject      *object,
 {
   SystemloadConfig *config = SYSTEMLOAD_CONFIG (object);
   gboolean          val_bool;
-  GdkRGBA          *val_rgba;
   const char       *val_string;
   guint             val_uint;
 
@@ -492,210 +893,276 @@ systemload_config_set_property (GObject      *object,
         }
       break;
 
-    case PROP_UPTIME:
-      val_bool = g_value_get_boolean (value);
-      if (config->uptime != val_bool)
+    case PROP_METRICS_SOCKET:
+      val_string = g_value_get_string (value);
+      if (g_strcmp0 (config->metrics_socket, val_string) != 0)
         {
-          config->uptime = val_bool;
-          g_object_notify (G_OBJECT (config), "uptime-enabled");
+          g_free (config->metrics_socket);
+          config->metrics_socket = g_value_dup_string (value);
+          g_object_notify (G_OBJECT (config), "metrics-socket");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_CPU_ENABLED:
+    case PROP_HISTORY:
       val_bool = g_value_get_boolean (value);
-      if (config->monitor[CPU_MONITOR].enabled != val_bool)
+      if (config->history != val_bool)
         {
-          config->monitor[CPU_MONITOR].enabled = val_bool;
-          g_object_notify (G_OBJECT (config), "cpu-enabled");
+          config->history = val_bool;
+          g_object_notify (G_OBJECT (config), "history-enabled");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_CPU_USE_LABEL:
-      val_bool = g_value_get_boolean (value);
-      if (config->monitor[CPU_MONITOR].use_label != val_bool)
+    case PROP_STATISTICS_WINDOW:
+      val_uint = g_value_get_uint (value);
+      if (config->statistics_window != val_uint)
+        {
+          config->statistics_window = val_uint;
+          g_object_notify (G_OBJECT (config), "statistics-window");
+          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+        }
+      break;
+
+    case PROP_STATISTICS_HALF_LIFE:
+      val_uint = g_value_get_uint (value);
+      if (config->statistics_half_life != val_uint)
         {
-          config->monitor[CPU_MONITOR].use_label = val_bool;
-          g_object_notify (G_OBJECT (config), "cpu-use-label");
+          config->statistics_half_life = val_uint;
+          g_object_notify (G_OBJECT (config), "statistics-half-life");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_CPU_LABEL:
+    case PROP_ALERT_COMMAND:
       val_string = g_value_get_string (value);
-      if (g_strcmp0 (config->monitor[CPU_MONITOR].label, val_string) != 0)
+      if (g_strcmp0 (config->alert_command, val_string) != 0)
         {
-          g_free (config->monitor[CPU_MONITOR].label);
-          config->monitor[CPU_MONITOR].label = g_value_dup_string (value);
-          g_object_notify (G_OBJECT (config), "cpu-label");
+          g_free (config->alert_command);
+          config->alert_command = g_value_dup_string (value);
+          g_object_notify (G_OBJECT (config), "alert-command");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_CPU_COLOR:
-      val_rgba = (GdkRGBA*) g_value_dup_boxed (value);
-      if (!rgba_equal (config->monitor[CPU_MONITOR].color, *val_rgba))
+    case PROP_ALERT_INTERVAL:
+      val_uint = g_value_get_uint (value);
+      if (config->alert_interval != val_uint)
         {
-          config->monitor[CPU_MONITOR].color = *val_rgba;
-          g_object_notify (G_OBJECT (config), "cpu-color");
+          config->alert_interval = val_uint;
+          g_object_notify (G_OBJECT (config), "alert-interval");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
-      if (is_default_color (CPU_MONITOR, val_rgba))
+      break;
+
+    case PROP_CPU_DISPLAY_MODE:
+      val_uint = g_value_get_uint (value);
+      if (config->cpu_display_mode != val_uint)
         {
-          char *property = g_strconcat (config->property_base, "/cpu/color", NULL);
-          xfconf_channel_reset_property (config->channel, property, TRUE);
-          g_free (property);
+          config->cpu_display_mode = SystemloadCpuDisplay (val_uint);
+          g_object_notify (G_OBJECT (config), "cpu-display-mode");
+          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
-      g_boxed_free (GDK_TYPE_RGBA, val_rgba);
       break;
 
-    case PROP_MEMORY_ENABLED:
+    case PROP_CPU_HEATMAP_GROUPING:
       val_bool = g_value_get_boolean (value);
-      if (config->monitor[MEM_MONITOR].enabled != val_bool)
+      if (config->cpu_heatmap_grouping != val_bool)
         {
-          config->monitor[MEM_MONITOR].enabled = val_bool;
-          g_object_notify (G_OBJECT (config), "memory-enabled");
+          config->cpu_heatmap_grouping = val_bool;
+          g_object_notify (G_OBJECT (config), "cpu-heatmap-grouping");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_MEMORY_USE_LABEL:
+    case PROP_MEMORY_NUMA_SPLIT:
       val_bool = g_value_get_boolean (value);
-      if (config->monitor[MEM_MONITOR].use_label != val_bool)
+      if (config->memory_numa_split != val_bool)
         {
-          config->monitor[MEM_MONITOR].use_label = val_bool;
-          g_object_notify (G_OBJECT (config), "memory-use-label");
+          config->memory_numa_split = val_bool;
+          g_object_notify (G_OBJECT (config), "memory-numa-split");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_MEMORY_LABEL:
+    case PROP_NETWORK_INCLUDE:
       val_string = g_value_get_string (value);
-      if (g_strcmp0 (config->monitor[MEM_MONITOR].label, val_string) != 0)
+      if (g_strcmp0 (config->network_include, val_string) != 0)
         {
-          g_free (config->monitor[MEM_MONITOR].label);
-          config->monitor[MEM_MONITOR].label = g_value_dup_string (value);
-          g_object_notify (G_OBJECT (config), "memory-label");
+          g_free (config->network_include);
+          config->network_include = g_value_dup_string (value);
+          g_object_notify (G_OBJECT (config), "network-include");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_MEMORY_COLOR:
-      val_rgba = (GdkRGBA*) g_value_dup_boxed (value);
-      if (!rgba_equal (config->monitor[MEM_MONITOR].color, *val_rgba))
+    case PROP_NETWORK_EXCLUDE:
+      val_string = g_value_get_string (value);
+      if (g_strcmp0 (config->network_exclude, val_string) != 0)
         {
-          config->monitor[MEM_MONITOR].color = *val_rgba;
-          g_object_notify (G_OBJECT (config), "memory-color");
+          g_free (config->network_exclude);
+          config->network_exclude = g_value_dup_string (value);
+          g_object_notify (G_OBJECT (config), "network-exclude");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
-      if (is_default_color (MEM_MONITOR, val_rgba))
+      break;
+
+    case PROP_FILESYSTEM_MOUNT_POINTS:
+      val_string = g_value_get_string (value);
+      if (g_strcmp0 (config->filesystem_mount_points, val_string) != 0)
         {
-          char *property = g_strconcat (config->property_base, "/memory/color", NULL);
-          xfconf_channel_reset_property (config->channel, property, TRUE);
-          g_free (property);
+          g_free (config->filesystem_mount_points);
+          config->filesystem_mount_points = g_value_dup_string (value);
+          g_object_notify (G_OBJECT (config), "filesystem-mount-points");
+          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
-      g_boxed_free (GDK_TYPE_RGBA, val_rgba);
       break;
 
-    case PROP_NETWORK_ENABLED:
-      val_bool = g_value_get_boolean (value);
-      if (config->monitor[NET_MONITOR].enabled != val_bool)
+    case PROP_FILESYSTEM_INTERVAL:
+      val_uint = g_value_get_uint (value);
+      if (config->filesystem_interval != val_uint)
         {
-          config->monitor[NET_MONITOR].enabled = val_bool;
-          g_object_notify (G_OBJECT (config), "network-enabled");
+          config->filesystem_interval = val_uint;
+          g_object_notify (G_OBJECT (config), "filesystem-interval");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_NETWORK_USE_LABEL:
-      val_bool = g_value_get_boolean (value);
-      if (config->monitor[NET_MONITOR].use_label != val_bool)
+    case PROP_LATENCY_BUDGET:
+      val_uint = g_value_get_uint (value);
+      if (config->latency_budget != val_uint)
         {
-          config->monitor[NET_MONITOR].use_label = val_bool;
-          g_object_notify (G_OBJECT (config), "network-use-label");
+          config->latency_budget = val_uint;
+          g_object_notify (G_OBJECT (config), "latency-budget");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_NETWORK_LABEL:
-      val_string = g_value_get_string (value);
-      if (g_strcmp0 (config->monitor[NET_MONITOR].label, val_string) != 0)
+    case PROP_POWER_AC_MULTIPLIER:
+      val_uint = g_value_get_uint (value);
+      if (config->power_multiplier[POWER_STATE_AC] != val_uint)
+        {
+          config->power_multiplier[POWER_STATE_AC] = val_uint;
+          g_object_notify (G_OBJECT (config), "power-ac-multiplier");
+          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+        }
+      break;
+
+    case PROP_POWER_BATTERY_MULTIPLIER:
+      val_uint = g_value_get_uint (value);
+      if (config->power_multiplier[POWER_STATE_BATTERY] != val_uint)
         {
-          g_free (config->monitor[NET_MONITOR].label);
-          config->monitor[NET_MONITOR].label = g_value_dup_string (value);
-          g_object_notify (G_OBJECT (config), "network-label");
+          config->power_multiplier[POWER_STATE_BATTERY] = val_uint;
+          g_object_notify (G_OBJECT (config), "power-battery-multiplier");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_NETWORK_COLOR:
-      val_rgba = (GdkRGBA*) g_value_dup_boxed (value);
-      if (!rgba_equal (config->monitor[NET_MONITOR].color, *val_rgba))
+    case PROP_POWER_LOW_BATTERY_MULTIPLIER:
+      val_uint = g_value_get_uint (value);
+      if (config->power_multiplier[POWER_STATE_LOW_BATTERY] != val_uint)
         {
-          config->monitor[NET_MONITOR].color = *val_rgba;
-          g_object_notify (G_OBJECT (config), "network-color");
+          config->power_multiplier[POWER_STATE_LOW_BATTERY] = val_uint;
+          g_object_notify (G_OBJECT (config), "power-low-battery-multiplier");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
-      if (is_default_color (NET_MONITOR, val_rgba))
+      break;
+
+    case PROP_POWER_SAVER_MULTIPLIER:
+      val_uint = g_value_get_uint (value);
+      if (config->power_saver_multiplier != val_uint)
         {
-          char *property = g_strconcat (config->property_base, "/network/color", NULL);
-          xfconf_channel_reset_property (config->channel, property, TRUE);
-          g_free (property);
+          config->power_saver_multiplier = val_uint;
+          g_object_notify (G_OBJECT (config), "power-saver-multiplier");
+          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
-      g_boxed_free (GDK_TYPE_RGBA, val_rgba);
       break;
 
-    case PROP_SWAP_ENABLED:
-      val_bool = g_value_get_boolean (value);
-      if (config->monitor[SWAP_MONITOR].enabled != val_bool)
+    case PROP_PEAK_INTERVAL:
+      val_uint = g_value_get_uint (value);
+      if (config->peak_interval != val_uint)
+        {
+          config->peak_interval = val_uint;
+          g_object_notify (G_OBJECT (config), "peak-interval");
+          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+        }
+      break;
+
+    case PROP_PEAK_BUDGET:
+      val_uint = g_value_get_uint (value);
+      if (config->peak_budget != val_uint)
         {
-          config->monitor[SWAP_MONITOR].enabled = val_bool;
-          g_object_notify (G_OBJECT (config), "swap-enabled");
+          config->peak_budget = val_uint;
+          g_object_notify (G_OBJECT (config), "peak-budget");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_SWAP_USE_LABEL:
+    case PROP_SELF_METRICS:
       val_bool = g_value_get_boolean (value);
-      if (config->monitor[SWAP_MONITOR].use_label != val_bool)
+      if (config->self_metrics != val_bool)
         {
-          config->monitor[SWAP_MONITOR].use_label = val_bool;
-          g_object_notify (G_OBJECT (config), "swap-use-label");
+          config->self_metrics = val_bool;
+          g_object_notify (G_OBJECT (config), "self-metrics");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_SWAP_LABEL:
-      val_string = g_value_get_string (value);
-      if (g_strcmp0 (config->monitor[SWAP_MONITOR].label, val_string) != 0)
+    case PROP_SELF_BUDGET:
+      val_uint = g_value_get_uint (value);
+      if (config->self_budget != val_uint)
         {
-          g_free (config->monitor[SWAP_MONITOR].label);
-          config->monitor[SWAP_MONITOR].label = g_value_dup_string (value);
-          g_object_notify (G_OBJECT (config), "swap-label");
+          config->self_budget = val_uint;
+          g_object_notify (G_OBJECT (config), "self-budget");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
       break;
 
-    case PROP_SWAP_COLOR:
-      val_rgba = (GdkRGBA*) g_value_dup_boxed (value);
-      if (!rgba_equal (config->monitor[SWAP_MONITOR].color, *val_rgba))
+    case PROP_MEMORY_SOURCE:
+      val_uint = g_value_get_uint (value);
+      if (config->memory_source != val_uint)
         {
-          config->monitor[SWAP_MONITOR].color = *val_rgba;
-          g_object_notify (G_OBJECT (config), "swap-color");
+          config->memory_source = SystemloadSource (val_uint);
+          g_object_notify (G_OBJECT (config), "memory-source");
           g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
-      if (is_default_color (SWAP_MONITOR, val_rgba))
+      break;
+
+    case PROP_SWAP_SOURCE:
+      val_uint = g_value_get_uint (value);
+      if (config->swap_source != val_uint)
         {
-          char *property = g_strconcat (config->property_base, "/swap/color", NULL);
-          xfconf_channel_reset_property (config->channel, property, TRUE);
-          g_free (property);
+          config->swap_source = SystemloadSource (val_uint);
+          g_object_notify (G_OBJECT (config), "swap-source");
+          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+        }
+      break;
+
+    case PROP_UPTIME_SOURCE:
+      val_uint = g_value_get_uint (value);
+      if (config->uptime_source != val_uint)
+        {
+          config->uptime_source = SystemloadSource (val_uint);
+          g_object_notify (G_OBJECT (config), "uptime-source");
+          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
+        }
+      break;
+
+    case PROP_UPTIME:
+      val_bool = g_value_get_boolean (value);
+      if (config->uptime != val_bool)
+        {
+          config->uptime = val_bool;
+          g_object_notify (G_OBJECT (config), "uptime-enabled");
+          g_signal_emit (G_OBJECT (config), systemload_config_signals [CONFIGURATION_CHANGED], 0);
         }
-      g_boxed_free (GDK_TYPE_RGBA, val_rgba);
       break;
 
     default:
-      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      if (prop_id >= PROP_MONITOR_FIRST && prop_id < PROP_MONITOR_LAST)
+        monitor_set_property (config, prop_id, value, pspec);
+      else
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
     }
 }
@@ -726,6 +1193,193 @@ systemload_config_get_system_monitor_command (const SystemloadConfig *config)
   return config->system_monitor_command;
 }
 
+const gchar*
+systemload_config_get_metrics_socket (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_METRICS_SOCKET);
+
+  return config->metrics_socket;
+}
+
+bool
+systemload_config_get_history_enabled (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), true);
+
+  return config->history;
+}
+
+guint
+systemload_config_get_statistics_window (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_STATISTICS_WINDOW);
+
+  return config->statistics_window;
+}
+
+guint
+systemload_config_get_statistics_half_life (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_STATISTICS_HALF_LIFE);
+
+  return config->statistics_half_life;
+}
+
+const gchar*
+systemload_config_get_alert_command (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_ALERT_COMMAND);
+
+  return config->alert_command;
+}
+
+guint
+systemload_config_get_alert_interval (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_ALERT_INTERVAL);
+
+  return config->alert_interval;
+}
+
+SystemloadCpuDisplay
+systemload_config_get_cpu_display_mode (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), CPU_DISPLAY_BAR);
+
+  return config->cpu_display_mode;
+}
+
+bool
+systemload_config_get_cpu_heatmap_grouping (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), true);
+
+  return config->cpu_heatmap_grouping;
+}
+
+bool
+systemload_config_get_memory_numa_split (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), false);
+
+  return config->memory_numa_split;
+}
+
+const gchar*
+systemload_config_get_network_include (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_NETWORK_INCLUDE);
+
+  return config->network_include;
+}
+
+const gchar*
+systemload_config_get_network_exclude (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_NETWORK_EXCLUDE);
+
+  return config->network_exclude;
+}
+
+const gchar*
+systemload_config_get_filesystem_mount_points (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_FILESYSTEM_MOUNT_POINTS);
+
+  return config->filesystem_mount_points;
+}
+
+guint
+systemload_config_get_filesystem_interval (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_FILESYSTEM_INTERVAL);
+
+  return config->filesystem_interval;
+}
+
+guint
+systemload_config_get_latency_budget (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_LATENCY_BUDGET);
+
+  return config->latency_budget;
+}
+
+guint
+systemload_config_get_power_multiplier (const SystemloadConfig *config, SystemloadPowerState state)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), 1);
+
+  if (state >= 0 && (gsize) state < G_N_ELEMENTS (config->power_multiplier))
+      return config->power_multiplier[state];
+  else
+      return 1;
+}
+
+guint
+systemload_config_get_power_saver_multiplier (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_POWER_SAVER_MULTIPLIER);
+
+  return config->power_saver_multiplier;
+}
+
+guint
+systemload_config_get_peak_interval (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_PEAK_INTERVAL);
+
+  return config->peak_interval;
+}
+
+guint
+systemload_config_get_peak_budget (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_PEAK_BUDGET);
+
+  return config->peak_budget;
+}
+
+bool
+systemload_config_get_self_metrics (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), false);
+
+  return config->self_metrics;
+}
+
+guint
+systemload_config_get_self_budget (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_SELF_BUDGET);
+
+  return config->self_budget;
+}
+
+SystemloadSource
+systemload_config_get_memory_source (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), SOURCE_AUTO);
+
+  return config->memory_source;
+}
+
+SystemloadSource
+systemload_config_get_swap_source (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), SOURCE_AUTO);
+
+  return config->swap_source;
+}
+
+SystemloadSource
+systemload_config_get_uptime_source (const SystemloadConfig *config)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), SOURCE_AUTO);
+
+  return config->uptime_source;
+}
+
 bool
 systemload_config_get_uptime_enabled (const SystemloadConfig *config)
 {
@@ -779,6 +1433,62 @@ systemload_config_get_color (const SystemloadConfig *config, SystemloadMonitor m
 }
 
 
+SystemloadStatistic
+systemload_config_get_statistic (const SystemloadConfig *config, SystemloadMonitor monitor)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), STATISTIC_CURRENT);
+
+  if (monitor >= 0 && (gsize) monitor < G_N_ELEMENTS (config->monitor))
+      return config->monitor[monitor].statistic;
+  else
+      return STATISTIC_CURRENT;
+}
+
+guint
+systemload_config_get_alert_threshold (const SystemloadConfig *config, SystemloadMonitor monitor)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), 0);
+
+  if (monitor >= 0 && (gsize) monitor < G_N_ELEMENTS (config->monitor))
+      return config->monitor[monitor].alert_threshold;
+  else
+      return 0;
+}
+
+guint
+systemload_config_get_alert_hold (const SystemloadConfig *config, SystemloadMonitor monitor)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_ALERT_HOLD);
+
+  if (monitor >= 0 && (gsize) monitor < G_N_ELEMENTS (config->monitor))
+      return config->monitor[monitor].alert_hold;
+  else
+      return DEFAULT_ALERT_HOLD;
+}
+
+guint
+systemload_config_get_alert_hysteresis (const SystemloadConfig *config, SystemloadMonitor monitor)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), DEFAULT_ALERT_HYSTERESIS);
+
+  if (monitor >= 0 && (gsize) monitor < G_N_ELEMENTS (config->monitor))
+      return config->monitor[monitor].alert_hysteresis;
+  else
+      return DEFAULT_ALERT_HYSTERESIS;
+}
+
+bool
+systemload_config_get_on_battery (const SystemloadConfig *config, SystemloadMonitor monitor)
+{
+  g_return_val_if_fail (IS_SYSTEMLOAD_CONFIG (config), true);
+
+  if (monitor >= 0 && (gsize) monitor < G_N_ELEMENTS (config->monitor))
+      return config->monitor[monitor].on_battery;
+  else
+      return true;
+}
+
+
 
 SystemloadConfig *
 systemload_config_new (const gchar *property_base)
@@ -805,73 +1515,128 @@ systemload_config_new (const gchar *property_base)
       xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "system-monitor-command");
       g_free (property);
 
-      property = g_strconcat (property_base, "/uptime/enabled", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "uptime-enabled");
+      property = g_strconcat (property_base, "/metrics-socket", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "metrics-socket");
+      g_free (property);
+
+      property = g_strconcat (property_base, "/history-enabled", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "history-enabled");
+      g_free (property);
+
+      property = g_strconcat (property_base, "/statistics-window", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "statistics-window");
+      g_free (property);
+
+      property = g_strconcat (property_base, "/statistics-half-life", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "statistics-half-life");
+      g_free (property);
+
+      property = g_strconcat (property_base, "/alert-command", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "alert-command");
+      g_free (property);
+
+      property = g_strconcat (property_base, "/alert-interval", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "alert-interval");
       g_free (property);
 
-      property = g_strconcat (property_base, "/cpu/enabled", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "cpu-enabled");
+      property = g_strconcat (property_base, "/cpu/display-mode", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "cpu-display-mode");
       g_free (property);
 
-      property = g_strconcat (property_base, "/cpu/use-label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "cpu-use-label");
+      property = g_strconcat (property_base, "/cpu/heatmap-grouping", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "cpu-heatmap-grouping");
       g_free (property);
 
-      property = g_strconcat (property_base, "/cpu/label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "cpu-label");
+      property = g_strconcat (property_base, "/memory/numa-split", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "memory-numa-split");
       g_free (property);
 
-      property = g_strconcat (property_base, "/cpu/color", NULL);
-      xfconf_g_property_bind_gdkrgba (channel, property, config, "cpu-color");
+      property = g_strconcat (property_base, "/network/include", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "network-include");
       g_free (property);
 
-      property = g_strconcat (property_base, "/memory/enabled", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "memory-enabled");
+      property = g_strconcat (property_base, "/network/exclude", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "network-exclude");
       g_free (property);
 
-      property = g_strconcat (property_base, "/memory/use-label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "memory-use-label");
+      property = g_strconcat (property_base, "/filesystem/mount-points", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "filesystem-mount-points");
       g_free (property);
 
-      property = g_strconcat (property_base, "/memory/label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "memory-label");
+      property = g_strconcat (property_base, "/filesystem/interval", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "filesystem-interval");
       g_free (property);
 
-      property = g_strconcat (property_base, "/memory/color", NULL);
-      xfconf_g_property_bind_gdkrgba (channel, property, config, "memory-color");
+      property = g_strconcat (property_base, "/latency/budget", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "latency-budget");
       g_free (property);
 
-      property = g_strconcat (property_base, "/network/enabled", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "network-enabled");
+      property = g_strconcat (property_base, "/power/ac-multiplier", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "power-ac-multiplier");
       g_free (property);
 
-      property = g_strconcat (property_base, "/network/use-label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "network-use-label");
+      property = g_strconcat (property_base, "/power/battery-multiplier", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "power-battery-multiplier");
       g_free (property);
 
-      property = g_strconcat (property_base, "/network/label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "network-label");
+      property = g_strconcat (property_base, "/power/low-battery-multiplier", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "power-low-battery-multiplier");
       g_free (property);
 
-      property = g_strconcat (property_base, "/network/color", NULL);
-      xfconf_g_property_bind_gdkrgba (channel, property, config, "network-color");
+      property = g_strconcat (property_base, "/power/saver-multiplier", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "power-saver-multiplier");
       g_free (property);
 
-      property = g_strconcat (property_base, "/swap/enabled", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "swap-enabled");
+      property = g_strconcat (property_base, "/peak/interval", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "peak-interval");
       g_free (property);
 
-      property = g_strconcat (property_base, "/swap/use-label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "swap-use-label");
+      property = g_strconcat (property_base, "/peak/budget", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "peak-budget");
       g_free (property);
 
-      property = g_strconcat (property_base, "/swap/label", NULL);
-      xfconf_g_property_bind (channel, property, G_TYPE_STRING, config, "swap-label");
+      property = g_strconcat (property_base, "/self/metrics", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "self-metrics");
       g_free (property);
 
-      property = g_strconcat (property_base, "/swap/color", NULL);
-      xfconf_g_property_bind_gdkrgba (channel, property, config, "swap-color");
+      property = g_strconcat (property_base, "/self/budget", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "self-budget");
       g_free (property);
+
+      property = g_strconcat (property_base, "/memory/source", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "memory-source");
+      g_free (property);
+
+      property = g_strconcat (property_base, "/swap/source", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "swap-source");
+      g_free (property);
+
+      property = g_strconcat (property_base, "/uptime/source", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_UINT, config, "uptime-source");
+      g_free (property);
+
+      property = g_strconcat (property_base, "/uptime/enabled", NULL);
+      xfconf_g_property_bind (channel, property, G_TYPE_BOOLEAN, config, "uptime-enabled");
+      g_free (property);
+
+      for (guint m = 0; m < N_MONITORS; m++)
+        {
+          const SystemloadMonitorInfo *info = systemload_registry_get (SystemloadMonitor (m));
+
+          for (guint field = 0; field < N_MONITOR_PROPERTIES; field++)
+            {
+              gchar *name = monitor_property_name (SystemloadMonitor (m), SystemloadMonitorProperty (field));
+              GParamSpec *pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (config), name);
+
+              property = g_strconcat (property_base, "/", info->name, "/", MONITOR_PROPERTY_SUFFIX[field], NULL);
+              if (field == MONITOR_PROP_COLOR)
+                xfconf_g_property_bind_gdkrgba (channel, property, config, name);
+              else
+                xfconf_g_property_bind (channel, property, G_PARAM_SPEC_VALUE_TYPE (pspec), config, name);
+              g_free (property);
+              g_free (name);
+            }
+        }
     }
 
   return config;
@@ -22,15 +22,61 @@
 #define _XFCE_SYSTEMLOAD_SETTINGS_H_
 
 #include <glib.h>
+#include <gdk/gdk.h>
 
 #define MIN_TIMEOUT 500
 #define MAX_TIMEOUT 10000
 
+/* Interval of the high-resolution sampling behind STATISTIC_PEAK, in ms */
+#define MIN_PEAK_INTERVAL 50
+#define MAX_PEAK_INTERVAL 250
+
+/* Identifies a monitor in snapshots and in the history file, new monitors are appended. See registry.h */
 enum SystemloadMonitor {
     CPU_MONITOR,
     MEM_MONITOR,
     NET_MONITOR,
     SWAP_MONITOR,
+    FS_MONITOR,
+    PAGING_MONITOR,
+    SCHED_MONITOR,
+    IRQ_MONITOR,
+    TCP_MONITOR,
+    ZRAM_MONITOR,
+    LATENCY_MONITOR,
+    N_MONITORS,
+};
+
+/* The value shown by the bar of a monitor */
+enum SystemloadStatistic {
+    STATISTIC_CURRENT,
+    STATISTIC_AVERAGE,
+    STATISTIC_MINIMUM,
+    STATISTIC_MAXIMUM,
+    STATISTIC_P95,
+    STATISTIC_PEAK,  /* Maximum since the previous update, sampled at the peak interval. See peak.h */
+};
+
+/* How the CPU monitor is drawn */
+enum SystemloadCpuDisplay {
+    CPU_DISPLAY_BAR,      /* A single bar showing the total load */
+    CPU_DISPLAY_STACKED,  /* One segment per CPU state */
+    CPU_DISPLAY_HEATMAP,  /* One cell per core */
+};
+
+/* Where the values of memory, swap and uptime are read from, on platforms which offer a choice */
+enum SystemloadSource {
+    SOURCE_AUTO,     /* The cheapest source which provides the values that are displayed */
+    SOURCE_PROCFS,   /* Parse the files in /proc */
+    SOURCE_SYSCALL,  /* sysinfo() and clock_gettime(), memory usage includes the page cache */
+};
+
+/* The power supply, as reported by UPower */
+enum SystemloadPowerState {
+    POWER_STATE_AC,           /* Also used when the power supply is unknown */
+    POWER_STATE_BATTERY,
+    POWER_STATE_LOW_BATTERY,  /* The warning level of the battery is "low" or worse */
+    N_POWER_STATES,
 };
 
 typedef struct _SystemloadConfigClass SystemloadConfigClass;
@@ -55,10 +101,40 @@ guint              systemload_config_get_timeout                    (const Syste
 guint              systemload_config_get_timeout_seconds            (const SystemloadConfig *config);
 const gchar       *systemload_config_get_system_monitor_command     (const SystemloadConfig *config);
 bool               systemload_config_get_uptime_enabled             (const SystemloadConfig *config);
+const gchar       *systemload_config_get_metrics_socket             (const SystemloadConfig *config);
+bool               systemload_config_get_history_enabled            (const SystemloadConfig *config);
+guint              systemload_config_get_statistics_window          (const SystemloadConfig *config);
+guint              systemload_config_get_statistics_half_life       (const SystemloadConfig *config);
+const gchar       *systemload_config_get_alert_command              (const SystemloadConfig *config);
+guint              systemload_config_get_alert_interval             (const SystemloadConfig *config);
+SystemloadCpuDisplay systemload_config_get_cpu_display_mode       (const SystemloadConfig *config);
+bool               systemload_config_get_cpu_heatmap_grouping       (const SystemloadConfig *config);
+bool               systemload_config_get_memory_numa_split          (const SystemloadConfig *config);
+const gchar       *systemload_config_get_network_include            (const SystemloadConfig *config);
+const gchar       *systemload_config_get_network_exclude            (const SystemloadConfig *config);
+const gchar       *systemload_config_get_filesystem_mount_points    (const SystemloadConfig *config);
+guint              systemload_config_get_filesystem_interval        (const SystemloadConfig *config);
+guint              systemload_config_get_latency_budget             (const SystemloadConfig *config);  /* µs */
+guint              systemload_config_get_power_multiplier           (const SystemloadConfig *config, SystemloadPowerState state);
+guint              systemload_config_get_power_saver_multiplier     (const SystemloadConfig *config);
+guint              systemload_config_get_peak_interval              (const SystemloadConfig *config);
+guint              systemload_config_get_peak_budget                (const SystemloadConfig *config);  /* Percent of one CPU */
+bool               systemload_config_get_self_metrics               (const SystemloadConfig *config);
+guint              systemload_config_get_self_budget                (const SystemloadConfig *config);  /* Percent of one CPU, 0 if unlimited */
+SystemloadSource   systemload_config_get_memory_source              (const SystemloadConfig *config);
+SystemloadSource   systemload_config_get_swap_source                (const SystemloadConfig *config);
+SystemloadSource   systemload_config_get_uptime_source              (const SystemloadConfig *config);
 
 bool               systemload_config_get_enabled   (const SystemloadConfig *config, SystemloadMonitor monitor);
 bool               systemload_config_get_use_label (const SystemloadConfig *config, SystemloadMonitor monitor);
 const gchar       *systemload_config_get_label     (const SystemloadConfig *config, SystemloadMonitor monitor);
 const GdkRGBA     *systemload_config_get_color     (const SystemloadConfig *config, SystemloadMonitor monitor);
+SystemloadStatistic systemload_config_get_statistic (const SystemloadConfig *config, SystemloadMonitor monitor);
+bool               systemload_config_get_on_battery (const SystemloadConfig *config, SystemloadMonitor monitor);
+
+/* A threshold of 0 means that the alert is disabled */
+guint              systemload_config_get_alert_threshold  (const SystemloadConfig *config, SystemloadMonitor monitor);
+guint              systemload_config_get_alert_hold       (const SystemloadConfig *config, SystemloadMonitor monitor);
+guint              systemload_config_get_alert_hysteresis (const SystemloadConfig *config, SystemloadMonitor monitor);
 
 #endif /* _XFCE_SYSTEMLOAD_SETTINGS_H_ */
@@ -0,0 +1,75 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_SNAPSHOT_H_
+#define _XFCE_SYSTEMLOAD_SNAPSHOT_H_
+
+#include <glib.h>
+
+#include "cpu.h"
+#include "irqstat.h"
+#include "schedstat.h"
+#include "selfstat.h"
+#include "settings.h"
+#include "tcpstat.h"
+#include "vmstat.h"
+#include "zram.h"
+
+/* The values read by the most recent update of the monitors */
+struct SystemloadSnapshot {
+    gint64   time;                  /* Wall-clock time, as returned by g_get_real_time() */
+
+    bool     enabled[N_MONITORS];
+    gulong   value[N_MONITORS];     /* Range: 0% ... 100% */
+
+    gulong   mem_total, mem_used;   /* KiB */
+    gulong   swap_total, swap_used; /* KiB */
+    gulong   swap_ram_total, swap_ram_used;  /* KiB, the part of the swap space compressed in RAM by zram, 0 without ZRAM_MONITOR */
+    gulong   net_bits;              /* Bits per second */
+    SystemloadCpuLoad cpu;          /* Breakdown of the CPU load into states */
+    bool     vmstat_valid;          /* The paging monitor could read /proc/vmstat */
+    SystemloadVmstat vmstat;
+    bool     activity_valid;        /* The scheduler monitor could read /proc/stat */
+    SystemloadCpuActivity activity;
+    bool     irq_valid;             /* The interrupt monitor could read /proc/interrupts or /proc/softirqs */
+    SystemloadIrqStat irq;
+    bool     tcp_valid;             /* The TCP monitor could read /proc/net/snmp */
+    SystemloadTcpStat tcp;
+    bool     compressed_valid;      /* The compressed memory monitor could read /proc/meminfo */
+    SystemloadCompressedMemory compressed;
+    bool     schedstat_valid;       /* The scheduler latency monitor could read /proc/schedstat */
+    SystemloadSchedstat schedstat;
+
+    bool     uptime_enabled;
+    gulong   uptime;                /* Seconds */
+
+    bool     self_enabled;          /* The cost of the plugin is shown, exported or checked */
+    SystemloadSelfUsage self;
+};
+
+#endif /* _XFCE_SYSTEMLOAD_SNAPSHOT_H_ */
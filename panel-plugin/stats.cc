@@ -0,0 +1,193 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <math.h>
+
+#include "stats.h"
+
+#define N_BUCKETS 101
+
+/* A double-ended queue of sample sequence numbers, with room for a whole window */
+struct t_deque {
+    guint64  *seq;
+    guint     front, size;
+};
+
+struct _SystemloadStats {
+    guint     window;
+    gdouble   alpha;
+    gdouble   average;
+    guint64   n_samples;        /* Sequence number of the next sample */
+
+    guint8   *values;           /* The samples in the window, indexed by sequence number modulo window */
+    guint32   histogram[N_BUCKETS];
+    t_deque   min, max;         /* Sequence numbers of the samples which can still become the minimum/maximum */
+};
+
+
+
+static inline guint64
+deque_front (const t_deque *d)
+{
+    return d->seq[d->front];
+}
+
+static inline guint64
+deque_back (const t_deque *d, guint window)
+{
+    return d->seq[(d->front + d->size - 1) % window];
+}
+
+static inline void
+deque_pop_front (t_deque *d, guint window)
+{
+    d->front = (d->front + 1) % window;
+    d->size--;
+}
+
+static inline void
+deque_push_back (t_deque *d, guint window, guint64 seq)
+{
+    d->seq[(d->front + d->size) % window] = seq;
+    d->size++;
+}
+
+
+
+SystemloadStats *
+systemload_stats_new (guint window, gdouble half_life)
+{
+    SystemloadStats *stats = g_new0 (SystemloadStats, 1);
+
+    stats->window = MAX (window, 1);
+    stats->alpha = (half_life > 0) ? 1 - exp2 (-1 / half_life) : 1;
+    stats->values = g_new0 (guint8, stats->window);
+    stats->min.seq = g_new0 (guint64, stats->window);
+    stats->max.seq = g_new0 (guint64, stats->window);
+
+    return stats;
+}
+
+void
+systemload_stats_free (SystemloadStats *stats)
+{
+    if (stats == NULL)
+        return;
+
+    g_free (stats->values);
+    g_free (stats->min.seq);
+    g_free (stats->max.seq);
+    g_free (stats);
+}
+
+guint
+systemload_stats_get_window (const SystemloadStats *stats)
+{
+    return stats->window;
+}
+
+void
+systemload_stats_add (SystemloadStats *stats, gulong value)
+{
+    const guint window = stats->window;
+    const guint64 seq = stats->n_samples++;
+    const guint8 v = MIN (value, N_BUCKETS - 1);
+
+    /* Drop the sample which leaves the window */
+    if (seq >= window)
+    {
+        const guint64 old = seq - window;
+        stats->histogram[stats->values[old % window]]--;
+        if (stats->min.size && deque_front (&stats->min) == old)
+            deque_pop_front (&stats->min, window);
+        if (stats->max.size && deque_front (&stats->max) == old)
+            deque_pop_front (&stats->max, window);
+    }
+
+    stats->values[seq % window] = v;
+    stats->histogram[v]++;
+
+    /* A new sample makes all larger (smaller) samples before it irrelevant for the minimum (maximum) */
+    while (stats->min.size && stats->values[deque_back (&stats->min, window) % window] >= v)
+        stats->min.size--;
+    deque_push_back (&stats->min, window, seq);
+
+    while (stats->max.size && stats->values[deque_back (&stats->max, window) % window] <= v)
+        stats->max.size--;
+    deque_push_back (&stats->max, window, seq);
+
+    if (seq == 0)
+        stats->average = v;
+    else
+        stats->average += stats->alpha * (v - stats->average);
+}
+
+gdouble
+systemload_stats_get_average (const SystemloadStats *stats)
+{
+    return stats->average;
+}
+
+gulong
+systemload_stats_get_min (const SystemloadStats *stats)
+{
+    if (stats->min.size == 0)
+        return 0;
+    return stats->values[deque_front (&stats->min) % stats->window];
+}
+
+gulong
+systemload_stats_get_max (const SystemloadStats *stats)
+{
+    if (stats->max.size == 0)
+        return 0;
+    return stats->values[deque_front (&stats->max) % stats->window];
+}
+
+gulong
+systemload_stats_get_percentile (const SystemloadStats *stats, guint percentile)
+{
+    const guint64 count = MIN (stats->n_samples, stats->window);
+    if (count == 0)
+        return 0;
+
+    /* Nearest-rank method; the resolution of the histogram is 1% */
+    const guint64 rank = MAX (1, (count * MIN (percentile, 100) + 99) / 100);
+    guint64 seen = 0;
+    for (guint i = 0; i < N_BUCKETS; i++)
+    {
+        seen += stats->histogram[i];
+        if (seen >= rank)
+            return i;
+    }
+    return N_BUCKETS - 1;
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_STATS_H_
+#define _XFCE_SYSTEMLOAD_STATS_H_
+
+#include <glib.h>
+
+/*
+ * Streaming statistics over the most recent samples of a monitor. Values range from 0 to 100.
+ *
+ * Adding a sample takes constant (amortized) time: the minimum and maximum are maintained
+ * with monotonic deques, the percentiles with a histogram of the values in the window.
+ */
+typedef struct _SystemloadStats SystemloadStats;
+
+/* window: number of samples; half_life: number of samples after which a sample's weight in the average is halved */
+SystemloadStats *systemload_stats_new            (guint                  window,
+                                                  gdouble                half_life);
+void             systemload_stats_free           (SystemloadStats       *stats);
+guint            systemload_stats_get_window     (const SystemloadStats *stats);
+
+void             systemload_stats_add            (SystemloadStats       *stats,
+                                                  gulong                 value);
+
+gdouble          systemload_stats_get_average    (const SystemloadStats *stats);
+gulong           systemload_stats_get_min        (const SystemloadStats *stats);
+gulong           systemload_stats_get_max        (const SystemloadStats *stats);
+gulong           systemload_stats_get_percentile (const SystemloadStats *stats,
+                                                  guint                  percentile);
+
+#endif /* _XFCE_SYSTEMLOAD_STATS_H_ */
@@ -48,16 +48,31 @@
 #include <libxfce4ui/libxfce4ui.h>
 #include <libxfce4panel/libxfce4panel.h>
 
-#ifdef HAVE_UPOWER_GLIB
-#include <upower.h>
-#endif
-
+#include "alert.h"
 #include "cpu.h"
+#include "exporter.h"
+#include "filesystem.h"
+#include "heatmap.h"
+#include "history.h"
+#include "irqstat.h"
 #include "memswap.h"
 #include "network.h"
+#include "numa.h"
+#include "peak.h"
 #include "plugin.h"
+#include "power.h"
+#include "procfile.h"
+#include "registry.h"
+#include "schedstat.h"
+#include "selfstat.h"
 #include "settings.h"
+#include "snapshot.h"
+#include "stats.h"
+#include "tcpstat.h"
+#include "topology.h"
 #include "uptime.h"
+#include "vmstat.h"
+#include "zram.h"
 
 
 
@@ -71,15 +86,16 @@ struct t_monitor {
     GtkWidget  *label;
     GtkWidget  *status;
     GtkWidget  *ebox;
+    GtkWidget  *stack;  /* Stacked bar of the CPU monitor or node-split bar of the memory monitor, else NULL */
+    SystemloadHeatmap *heatmap;  /* Per-core heatmap of the CPU monitor, NULL for the other monitors */
 
-    gulong     value_read; /* Range: 0% ... 100% */
+    SystemloadStats *stats;
+    SystemloadAlert *alert;
 };
 
 struct t_uptime_monitor {
     GtkWidget  *label;
     GtkWidget  *ebox;
-
-    gulong     value_read;
 };
 
 struct t_global_monitor {
@@ -91,23 +107,127 @@ struct t_global_monitor {
     bool              use_timeout_seconds;
     guint             timeout_id;
     t_command         command;
-    t_monitor         *monitor[4];
+    t_monitor         *monitor[N_MONITORS];
     t_uptime_monitor  uptime;
-#ifdef HAVE_UPOWER_GLIB
-    UpClient          *upower;
-#endif
+    SystemloadSnapshot snapshot;
+    SystemloadCpuSampler *cpu_sampler;  /* The previous readings the loads of the snapshot are relative to */
+    SystemloadMemSampler *mem_sampler;
+    SystemloadNetSampler *net_sampler;
+    SystemloadVmstatSampler *vmstat_sampler;  /* Only while the paging monitor is enabled */
+    SystemloadIrqSampler *irq_sampler;        /* Only while the interrupt monitor is enabled */
+    SystemloadTcpSampler *tcp_sampler;        /* Only while the TCP monitor is enabled */
+    SystemloadZramSampler *zram_sampler;      /* Only while the compressed memory monitor is enabled */
+    SystemloadSchedstatSampler *schedstat_sampler;  /* Only while the scheduler latency monitor is enabled */
+    bool              primed;
+    guint             stats_interval; /* Update interval the statistics are computed for, in ms */
+    gdouble           stats_half_life;
+    SystemloadExporter *exporter;
+    SystemloadHistory *history;
+    SystemloadCpuTopology *topology;
+    SystemloadNuma    *numa;
+    SystemloadFilesystems *filesystems;
+    guint             filesystems_timeout_id;
+    guint             filesystems_interval;  /* Seconds */
+    SystemloadPower   *power;
+    SystemloadPeakSampler *peak_sampler;  /* Only while a monitor shows its peak */
+    bool              peak_enabled[N_MONITORS];
+    guint             peak_timeout_id;
+    guint             peak_interval;
+    bool              peak_valid;  /* peak[] holds the maxima since the previous update */
+    gulong            peak[N_MONITORS];
+    SystemloadSelfSampler *self_sampler;
+    gint64            self_window_start;  /* Monotonic time, see check_self_budget() */
+    gdouble           self_window_cpu;
+    const guint8      *core_loads;  /* Per-core loads of the current update, when the heatmap or NUMA needs them */
+    guint             n_cores;
+};
+
+/*
+ * The code behind a monitor of the registry. Only the sources of enabled monitors are polled,
+ * and the optional setup() hook lets a source hold state only while its monitor is enabled.
+ */
+struct t_source {
+    /* Adds the widgets beyond the label and the bar, called once */
+    void (*create)       (t_global_monitor *global, t_monitor *m);
+    /* Applies the configuration, also called with enabled = false when the plugin is freed */
+    void (*setup)        (t_global_monitor *global, bool enabled);
+    /* Reads snapshot->value[] of the monitor, and the fields of the snapshot the monitor owns */
+    void (*sample)       (t_global_monitor *global, SystemloadSnapshot *snapshot);
+    void (*tooltip)      (const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+    /* Adds the settings specific to the monitor to the dialog, below row 2 of the grid */
+    void (*add_settings) (t_global_monitor *global, GtkGrid *grid);
 };
 
 
 
-static const SystemloadMonitor VISUAL_ORDER[] = {
-    CPU_MONITOR,
-    MEM_MONITOR,
-    SWAP_MONITOR,
-    NET_MONITOR,
+/* Colors of the segments of the stacked CPU bar, the user time has the color of the CPU monitor */
+static const gchar *const CPU_STATE_COLOR[] = {
+    NULL,       /* CPU_STATE_USER */
+    "#9141ac",  /* CPU_STATE_SYSTEM */
+    "#c64600",  /* CPU_STATE_IRQ */
+    "#77767b",  /* CPU_STATE_IOWAIT */
+    "#a51d2d",  /* CPU_STATE_STEAL */
 };
+G_STATIC_ASSERT (G_N_ELEMENTS (CPU_STATE_COLOR) == N_CPU_STATES);
 
 static gboolean setup_monitor_cb(gpointer user_data);
+static void setup_history(t_global_monitor *global);
+static void power_changed_cb(gpointer user_data);
+
+static void create_cpu(t_global_monitor *global, t_monitor *m);
+static void setup_cpu(t_global_monitor *global, bool enabled);
+static void sample_cpu(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_cpu(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void add_cpu_settings(t_global_monitor *global, GtkGrid *grid);
+static void create_memory(t_global_monitor *global, t_monitor *m);
+static void setup_memory(t_global_monitor *global, bool enabled);
+static void sample_memory(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_memory(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void add_memory_settings(t_global_monitor *global, GtkGrid *grid);
+static void setup_network(t_global_monitor *global, bool enabled);
+static void sample_network(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_network(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void add_network_settings(t_global_monitor *global, GtkGrid *grid);
+static void sample_swap(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_swap(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void setup_filesystems(t_global_monitor *global, bool enabled);
+static void sample_filesystems(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_filesystems(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void add_filesystem_settings(t_global_monitor *global, GtkGrid *grid);
+static void setup_paging(t_global_monitor *global, bool enabled);
+static void sample_paging(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_paging(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void sample_scheduler(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_scheduler(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void setup_interrupts(t_global_monitor *global, bool enabled);
+static void sample_interrupts(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_interrupts(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void setup_tcp(t_global_monitor *global, bool enabled);
+static void sample_tcp(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_tcp(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void setup_compressed(t_global_monitor *global, bool enabled);
+static void sample_compressed(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_compressed(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void setup_latency(t_global_monitor *global, bool enabled);
+static void sample_latency(t_global_monitor *global, SystemloadSnapshot *snapshot);
+static void tooltip_latency(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size);
+static void add_latency_settings(t_global_monitor *global, GtkGrid *grid);
+
+/* Indexed by SystemloadMonitor */
+static const t_source SOURCES[] = {
+    { create_cpu,    setup_cpu,         sample_cpu,         tooltip_cpu,         add_cpu_settings },
+    { create_memory, setup_memory,      sample_memory,      tooltip_memory,      add_memory_settings },
+    { NULL,          setup_network,     sample_network,     tooltip_network,     add_network_settings },
+    { NULL,          NULL,              sample_swap,        tooltip_swap,        NULL },
+    { NULL,          setup_filesystems, sample_filesystems, tooltip_filesystems, add_filesystem_settings },
+    { NULL,          setup_paging,      sample_paging,      tooltip_paging,      NULL },
+    { NULL,          NULL,              sample_scheduler,   tooltip_scheduler,   NULL },
+    { NULL,          setup_interrupts,  sample_interrupts,  tooltip_interrupts,  NULL },
+    { NULL,          setup_tcp,         sample_tcp,         tooltip_tcp,         NULL },
+    { NULL,          setup_compressed,  sample_compressed,  tooltip_compressed,  NULL },
+    { NULL,          setup_latency,     sample_latency,     tooltip_latency,     add_latency_settings },
+};
+G_STATIC_ASSERT (G_N_ELEMENTS (SOURCES) == N_MONITORS);
 
 
 
@@ -167,89 +287,864 @@ set_tooltip(GtkWidget *w, const gchar *caption)
     g_free(displayed_caption);
 }
 
+/* The value of the monitor as selected by its "statistic" setting */
+static gulong
+statistic_value(const t_global_monitor *global, SystemloadMonitor monitor)
+{
+    const SystemloadStats *stats = global->monitor[monitor]->stats;
+
+    if (stats)
+    {
+        switch (systemload_config_get_statistic (global->config, monitor))
+        {
+            case STATISTIC_CURRENT:
+                break;
+            case STATISTIC_AVERAGE:
+                return lround (systemload_stats_get_average (stats));
+            case STATISTIC_MINIMUM:
+                return systemload_stats_get_min (stats);
+            case STATISTIC_MAXIMUM:
+                return systemload_stats_get_max (stats);
+            case STATISTIC_P95:
+                return systemload_stats_get_percentile (stats, 95);
+            case STATISTIC_PEAK:
+                /* The average over the update interval can exceed the sampled maximum */
+                if (global->peak_valid && global->peak_enabled[monitor])
+                    return MAX (global->peak[monitor], global->snapshot.value[monitor]);
+                break;
+        }
+    }
+
+    return global->snapshot.value[monitor];
+}
+
 static void
-update_monitors(t_global_monitor *global)
+append_statistics(const t_global_monitor *global, SystemloadMonitor monitor, gchar *tooltip, gsize size)
+{
+    const SystemloadStats *stats = global->monitor[monitor]->stats;
+
+    if (stats)
+    {
+        g_strlcat (tooltip, "\n", size);
+        gsize len = strlen (tooltip);
+        g_snprintf(tooltip + len, size - len, _("Last %us: average %ld%%, min %lu%%, max %lu%%, 95th percentile %lu%%"),
+                   systemload_config_get_statistics_window (global->config),
+                   lround (systemload_stats_get_average (stats)),
+                   systemload_stats_get_min (stats),
+                   systemload_stats_get_max (stats),
+                   systemload_stats_get_percentile (stats, 95));
+    }
+
+    if (global->peak_valid && global->peak_enabled[monitor])
+    {
+        g_strlcat (tooltip, "\n", size);
+        gsize len = strlen (tooltip);
+        g_snprintf(tooltip + len, size - len, _("Peak since the last update: %lu%%"),
+                   MAX (global->peak[monitor], global->snapshot.value[monitor]));
+    }
+}
+
+static void
+append_self_usage(const t_global_monitor *global, gchar *tooltip, gsize size)
+{
+    const SystemloadSelfUsage *self = &global->snapshot.self;
+
+    g_strlcat (tooltip, "\n", size);
+    gsize len = strlen (tooltip);
+    g_snprintf(tooltip + len, size - len, _("Plugin: %.1f%% CPU, %.1f wakeups/s, %lu MiB resident"),
+               self->cpu, self->wakeups, self->rss >> 10);
+    if (self->heap)
+    {
+        len = strlen (tooltip);
+        g_snprintf(tooltip + len, size - len, _(", heap %lu KiB (%+ld KiB)"), self->heap, self->heap_change);
+    }
+}
+
+static void
+append_cpu_states(const t_global_monitor *global, gchar *tooltip, gsize size)
+{
+    const SystemloadCpuLoad *cpu = &global->snapshot.cpu;
+
+    g_strlcat (tooltip, "\n", size);
+    gsize len = strlen (tooltip);
+    g_snprintf(tooltip + len, size - len, _("User %.0f%%, system %.0f%%, IRQ %.0f%%, I/O wait %.0f%%, steal %.0f%%"),
+               cpu->state[CPU_STATE_USER],
+               cpu->state[CPU_STATE_SYSTEM],
+               cpu->state[CPU_STATE_IRQ],
+               cpu->state[CPU_STATE_IOWAIT],
+               cpu->state[CPU_STATE_STEAL]);
+}
+
+static void
+append_numa_nodes(const t_global_monitor *global, SystemloadMonitor monitor, gchar *tooltip, gsize size)
+{
+    for (guint i = 0; i < systemload_numa_get_n_nodes (global->numa); i++)
+    {
+        const SystemloadNumaNode *node = systemload_numa_get_node (global->numa, i);
+
+        g_strlcat (tooltip, "\n", size);
+        gsize len = strlen (tooltip);
+        if (monitor == CPU_MONITOR)
+        {
+            if (node->n_cpus != 0)
+                g_snprintf(tooltip + len, size - len, _("Node %u: %u%%"), node->id, node->cpu_load);
+            else
+                g_snprintf(tooltip + len, size - len, _("Node %u: no CPUs"), node->id);
+        }
+        else
+        {
+            g_snprintf(tooltip + len, size - len, _("Node %u: %luMB of %luMB used"),
+                       node->id, node->mem_used >> 10, node->mem_total >> 10);
+        }
+    }
+}
+
+static gboolean
+draw_cpu_stack_cb(GtkWidget *widget, cairo_t *cr, t_global_monitor *global)
+{
+    const gint width = gtk_widget_get_allocated_width (widget);
+    const gint height = gtk_widget_get_allocated_height (widget);
+    /* Like the progress bars, the stack grows upwards in horizontal panels */
+    const bool vertical = (xfce_panel_plugin_get_orientation (global->plugin) == GTK_ORIENTATION_HORIZONTAL);
+    const gint length = vertical ? height : width;
+    gdouble offset = 0;
+    GdkRGBA color;
+
+    if (gtk_style_context_has_class (gtk_widget_get_style_context (widget), "alert"))
+    {
+        gdk_rgba_parse (&color, ALERT_COLOR);
+        color.alpha = 0.4;
+        gdk_cairo_set_source_rgba (cr, &color);
+        cairo_paint (cr);
+    }
+
+    for (gsize i = 0; i < N_CPU_STATES; i++)
+    {
+        gdouble size = length * global->snapshot.cpu.state[i] / 100;
+
+        if (i == CPU_STATE_USER)
+            color = *systemload_config_get_color (global->config, CPU_MONITOR);
+        else
+            gdk_rgba_parse (&color, CPU_STATE_COLOR[i]);
+
+        gdk_cairo_set_source_rgba (cr, &color);
+        if (vertical)
+            cairo_rectangle (cr, 0, height - offset - size, width, size);
+        else
+            cairo_rectangle (cr, offset, 0, size, height);
+        cairo_fill (cr);
+        offset += size;
+    }
+
+    return FALSE;
+}
+
+/* One bar per NUMA node, side by side across the width of the memory bar */
+static gboolean
+draw_mem_nodes_cb(GtkWidget *widget, cairo_t *cr, t_global_monitor *global)
+{
+    const gint width = gtk_widget_get_allocated_width (widget);
+    const gint height = gtk_widget_get_allocated_height (widget);
+    const bool vertical = (xfce_panel_plugin_get_orientation (global->plugin) == GTK_ORIENTATION_HORIZONTAL);
+    const guint n_nodes = systemload_numa_get_n_nodes (global->numa);
+    GdkRGBA color;
+
+    if (n_nodes == 0)
+        return FALSE;
+
+    if (gtk_style_context_has_class (gtk_widget_get_style_context (widget), "alert"))
+        gdk_rgba_parse (&color, ALERT_COLOR);
+    else
+        color = *systemload_config_get_color (global->config, MEM_MONITOR);
+
+    /* The nodes are separated by 1px gaps */
+    const gint thickness = vertical ? width : height;
+    const gint length = vertical ? height : width;
+    const gdouble node_thickness = MAX ((thickness - (gdouble) (n_nodes - 1)) / n_nodes, 1);
+
+    for (guint i = 0; i < n_nodes; i++)
+    {
+        const SystemloadNumaNode *node = systemload_numa_get_node (global->numa, i);
+        const gdouble offset = i * (node_thickness + 1);
+        const gdouble size = node->mem_total ? length * (gdouble) node->mem_used / node->mem_total : 0;
+
+        color.alpha = 0.25;
+        gdk_cairo_set_source_rgba (cr, &color);
+        if (vertical)
+            cairo_rectangle (cr, offset, 0, node_thickness, height);
+        else
+            cairo_rectangle (cr, 0, offset, width, node_thickness);
+        cairo_fill (cr);
+
+        color.alpha = 1;
+        gdk_cairo_set_source_rgba (cr, &color);
+        if (vertical)
+            cairo_rectangle (cr, offset, height - size, node_thickness, size);
+        else
+            cairo_rectangle (cr, 0, offset, size, node_thickness);
+        cairo_fill (cr);
+    }
+
+    return FALSE;
+}
+
+static void
+setup_heatmap(t_global_monitor *global, guint n_cells)
+{
+    gint *group = NULL;
+
+    if (systemload_config_get_cpu_heatmap_grouping (global->config))
+    {
+        /* The topology is read once, and again only if the number of cores changes */
+        if (!global->topology || global->topology->n_cpus != n_cells)
+        {
+            systemload_cpu_topology_free (global->topology);
+            global->topology = systemload_cpu_topology_read (n_cells);
+        }
+
+        /* Group by NUMA node first, then by socket */
+        group = g_new (gint, MAX (n_cells, 1));
+        for (guint i = 0; i < n_cells; i++)
+            group[i] = (global->topology->node[i] + 1) * 65536 + (global->topology->package[i] + 1);
+    }
+
+    systemload_heatmap_set_cells (global->monitor[CPU_MONITOR]->heatmap, n_cells, group);
+    g_free (group);
+}
+
+static void
+update_heatmap(t_global_monitor *global, const guint8 *loads, guint n)
+{
+    SystemloadHeatmap *heatmap = global->monitor[CPU_MONITOR]->heatmap;
+    guint8 total;
+
+    if (n == 0)
+    {
+        /* No per-core values on this platform, show the total load in a single cell */
+        total = MIN (global->snapshot.value[CPU_MONITOR], 100);
+        loads = &total;
+        n = 1;
+    }
+
+    if (n != systemload_heatmap_get_n_cells (heatmap))
+        setup_heatmap (global, n);
+    systemload_heatmap_update (heatmap, loads);
+}
+
+/* Evaluates the alert rules, this is done for every snapshot and costs the same for every update */
+static void
+update_alerts(t_global_monitor *global)
 {
     const SystemloadConfig *config = global->config;
-    gulong MTotal = 0, MUsed = 0, NTotal = 0, STotal = 0, SUsed = 0;
+    const SystemloadSnapshot *snapshot = &global->snapshot;
+    const gint64 now = g_get_monotonic_time ();
 
     for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
-        global->monitor[i]->value_read = 0;
+    {
+        auto monitor = (SystemloadMonitor) i;
+        t_monitor *m = global->monitor[i];
+        SystemloadAlertRule rule;
+
+        rule.threshold = snapshot->enabled[i] ? systemload_config_get_alert_threshold (config, monitor) : 0;
+        rule.hold = systemload_config_get_alert_hold (config, monitor);
+        rule.hysteresis = systemload_config_get_alert_hysteresis (config, monitor);
+
+        switch (systemload_alert_evaluate (m->alert, &rule, snapshot->value[i], now))
+        {
+            case ALERT_RAISED:
+                gtk_style_context_add_class (gtk_widget_get_style_context (m->status), "alert");
+                if (m->stack)
+                    gtk_style_context_add_class (gtk_widget_get_style_context (m->stack), "alert");
+                if (m->heatmap)
+                    gtk_style_context_add_class (gtk_widget_get_style_context (systemload_heatmap_get_widget (m->heatmap)), "alert");
+                systemload_alert_run (m->alert,
+                                      systemload_config_get_alert_command (config),
+                                      systemload_registry_get (monitor)->name, snapshot->value[i],
+                                      systemload_config_get_alert_interval (config), now);
+                break;
+            case ALERT_CLEARED:
+                gtk_style_context_remove_class (gtk_widget_get_style_context (m->status), "alert");
+                if (m->stack)
+                    gtk_style_context_remove_class (gtk_widget_get_style_context (m->stack), "alert");
+                if (m->heatmap)
+                    gtk_style_context_remove_class (gtk_widget_get_style_context (systemload_heatmap_get_widget (m->heatmap)), "alert");
+                break;
+            case ALERT_UNCHANGED:
+                break;
+        }
+    }
+}
 
-    if (systemload_config_get_enabled (config, CPU_MONITOR))
-        global->monitor[CPU_MONITOR]->value_read = read_cpuload();
-    if (systemload_config_get_enabled (config, MEM_MONITOR) ||
-        systemload_config_get_enabled (config, SWAP_MONITOR))
+static void
+sample_cpu(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    const bool numa = systemload_numa_get_n_nodes (global->numa) != 0;
+    const bool heatmap = gtk_widget_get_visible (systemload_heatmap_get_widget (global->monitor[CPU_MONITOR]->heatmap));
+
+    snapshot->value[CPU_MONITOR] = read_cpuload(global->cpu_sampler, &snapshot->cpu);
+    /* This parses the /proc/stat buffer which was already read by read_cpuload() */
+    if (heatmap || numa)
+        global->n_cores = read_cpuload_cores (global->cpu_sampler, &global->core_loads);
+    if (numa)
+        systemload_numa_update_cpu (global->numa, global->core_loads, global->n_cores);
+}
+
+static void
+tooltip_cpu(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    g_snprintf(tooltip, size, _("System Load: %ld%%"), snapshot->value[CPU_MONITOR]);
+    append_cpu_states(global, tooltip, size);
+    append_numa_nodes(global, CPU_MONITOR, tooltip, size);
+    append_statistics(global, CPU_MONITOR, tooltip, size);
+}
+
+/*
+ * /proc/meminfo is needed for MemAvailable. When only swap is shown, or when
+ * it is parsed anyway, take swap from the same source to avoid a second read.
+ */
+static void
+sample_memswap(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    const SystemloadConfig *config = global->config;
+    const SystemloadSource mem_source = systemload_config_get_memory_source (config);
+    const SystemloadSource swap_source = systemload_config_get_swap_source (config);
+    const bool mem_procfs = snapshot->enabled[MEM_MONITOR] && mem_source != SOURCE_SYSCALL;
+    const bool swap_procfs = snapshot->enabled[SWAP_MONITOR] &&
+                             (swap_source == SOURCE_PROCFS || (swap_source == SOURCE_AUTO && mem_procfs));
+    gulong mem, swap, mem_total, mem_used, swap_total, swap_used;
+
+    if (mem_procfs || swap_procfs)
     {
-        gulong mem, swap;
-        if (read_memswap(&mem, &swap, &MTotal, &MUsed, &STotal, &SUsed) == 0)
+        if (read_memswap(global->mem_sampler, &mem, &swap, &mem_total, &mem_used, &swap_total, &swap_used) == 0)
         {
-            global->monitor[MEM_MONITOR]->value_read = mem;
-            global->monitor[SWAP_MONITOR]->value_read = swap;
+            if (mem_procfs)
+            {
+                snapshot->value[MEM_MONITOR] = mem;
+                snapshot->mem_total = mem_total;
+                snapshot->mem_used = mem_used;
+            }
+            if (swap_procfs)
+            {
+                snapshot->value[SWAP_MONITOR] = swap;
+                snapshot->swap_total = swap_total;
+                snapshot->swap_used = swap_used;
+            }
         }
     }
-    if (systemload_config_get_enabled (config, NET_MONITOR))
+
+    if ((snapshot->enabled[MEM_MONITOR] && !mem_procfs) || (snapshot->enabled[SWAP_MONITOR] && !swap_procfs))
     {
-        gulong net;
-        if (read_netload (&net, &NTotal) == 0)
-            global->monitor[NET_MONITOR]->value_read = net;
+        if (read_memswap_syscall(global->mem_sampler, &mem, &swap, &mem_total, &mem_used, &swap_total, &swap_used) == 0)
+        {
+            if (snapshot->enabled[MEM_MONITOR] && !mem_procfs)
+            {
+                snapshot->value[MEM_MONITOR] = mem;
+                snapshot->mem_total = mem_total;
+                snapshot->mem_used = mem_used;
+            }
+            if (snapshot->enabled[SWAP_MONITOR] && !swap_procfs)
+            {
+                snapshot->value[SWAP_MONITOR] = swap;
+                snapshot->swap_total = swap_total;
+                snapshot->swap_used = swap_used;
+            }
+        }
     }
-    if (systemload_config_get_uptime_enabled (config))
-        global->uptime.value_read = read_uptime();
+}
 
-    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+static void
+sample_memory(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    if (systemload_numa_get_n_nodes (global->numa) != 0)
+        systemload_numa_update_memory (global->numa);
+    sample_memswap (global, snapshot);
+}
+
+static void
+tooltip_memory(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    g_snprintf(tooltip, size, _("Memory: %ldMB of %ldMB used"), snapshot->mem_used >> 10 , snapshot->mem_total >> 10);
+    append_numa_nodes(global, MEM_MONITOR, tooltip, size);
+    append_statistics(global, MEM_MONITOR, tooltip, size);
+}
+
+static void
+sample_swap(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    /* Already read together with the memory */
+    if (!snapshot->enabled[MEM_MONITOR])
+        sample_memswap (global, snapshot);
+}
+
+static void
+tooltip_swap(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    if (snapshot->swap_total)
     {
-        const auto monitor = (SystemloadMonitor) i;
-        t_monitor *m = global->monitor[monitor];
+        g_snprintf(tooltip, size, _("Swap: %ldMB of %ldMB used"), snapshot->swap_used >> 10, snapshot->swap_total >> 10);
+        if (snapshot->swap_ram_total)
+        {
+            /* Compressed swap costs RAM rather than disk I/O, so its usage means something else */
+            const gulong disk_total = snapshot->swap_total - MIN (snapshot->swap_ram_total, snapshot->swap_total);
+            const gulong disk_used = snapshot->swap_used - MIN (snapshot->swap_ram_used, snapshot->swap_used);
+            g_strlcat (tooltip, "\n", size);
+            gsize len = strlen (tooltip);
+            g_snprintf(tooltip + len, size - len, _("Compressed in RAM: %ldMB of %ldMB, on disk: %ldMB of %ldMB"),
+                       snapshot->swap_ram_used >> 10, snapshot->swap_ram_total >> 10, disk_used >> 10, disk_total >> 10);
+        }
+        append_statistics(global, SWAP_MONITOR, tooltip, size);
+    }
+    else
+        g_snprintf(tooltip, size, _("No swap"));
+}
 
-        if (systemload_config_get_enabled (config, monitor))
+static void
+sample_network(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    gulong net;
+    if (read_netload (global->net_sampler, &net, &snapshot->net_bits) == 0)
+        snapshot->value[NET_MONITOR] = net;
+}
+
+static void
+tooltip_network(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    g_snprintf(tooltip, size, _("Network: %ld Mbit/s"), (glong) round (snapshot->net_bits / 1e6));
+    append_statistics(global, NET_MONITOR, tooltip, size);
+}
+
+static void
+sample_filesystems(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    /* statvfs() runs on its own, slower timer; see update_filesystems_cb() */
+    if (global->filesystems)
+        snapshot->value[FS_MONITOR] = systemload_filesystems_get_usage (global->filesystems);
+}
+
+static void
+tooltip_filesystems(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    const guint n = global->filesystems ? systemload_filesystems_get_n (global->filesystems) : 0;
+
+    if (n == 0)
+    {
+        g_snprintf(tooltip, size, _("No filesystems"));
+        return;
+    }
+
+    g_snprintf(tooltip, size, _("Disk: %lu%% used on the fullest filesystem"), snapshot->value[FS_MONITOR]);
+    for (guint i = 0; i < n; i++)
+    {
+        const SystemloadFilesystem *fs = systemload_filesystems_get (global->filesystems, i);
+        gsize len;
+
+        g_strlcat (tooltip, "\n", size);
+        len = strlen (tooltip);
+        if (fs->mounted && fs->total != 0)
         {
-            gulong value = MIN(m->value_read, 100);
-            set_fraction(GTK_PROGRESS_BAR(global->monitor[i]->status), value / 100.0);
+            gchar *used = g_format_size (fs->used);
+            gchar *total = g_format_size (fs->total);
+            gchar *available = g_format_size (fs->available);
+            g_snprintf(tooltip + len, size - len, _("%s: %s of %s used, %s available"),
+                       fs->mount_point, used, total, available);
+            g_free (used);
+            g_free (total);
+            g_free (available);
         }
+        else
+            g_snprintf(tooltip + len, size - len, _("%s: not mounted"), fs->mount_point);
+    }
+    append_statistics(global, FS_MONITOR, tooltip, size);
+}
+
+static void
+sample_paging(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    SystemloadVmstat *vm = &snapshot->vmstat;
+
+    snapshot->vmstat_valid = read_vmstat (global->vmstat_sampler, vm) == 0;
+    if (snapshot->vmstat_valid)
+    {
+        const gdouble bytes = (vm->rate[VMSTAT_PSWPIN] + vm->rate[VMSTAT_PSWPOUT]) * vm->page_size;
+        snapshot->value[PAGING_MONITOR] = MIN (lround (100 * bytes / MAX_SWAP_IO_BYTES), 100);
+    }
+}
+
+static void
+tooltip_paging(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    const SystemloadVmstat *vm = &snapshot->vmstat;
+
+    if (!snapshot->vmstat_valid)
+    {
+        g_snprintf(tooltip, size, _("Paging: not available"));
+        return;
+    }
+
+    const gdouble scanned = vm->rate[VMSTAT_PGSCAN_KSWAPD] + vm->rate[VMSTAT_PGSCAN_DIRECT];
+    const gdouble stolen = vm->rate[VMSTAT_PGSTEAL_KSWAPD] + vm->rate[VMSTAT_PGSTEAL_DIRECT];
+    gsize len;
+
+    g_snprintf(tooltip, size, _("Swap: %.1f MiB/s in, %.1f MiB/s out"),
+               vm->rate[VMSTAT_PSWPIN] * vm->page_size / (1024 * 1024),
+               vm->rate[VMSTAT_PSWPOUT] * vm->page_size / (1024 * 1024));
+    g_strlcat (tooltip, "\n", size);
+    len = strlen (tooltip);
+    g_snprintf(tooltip + len, size - len, _("Major faults: %.0f/s"), vm->rate[VMSTAT_PGMAJFAULT]);
+    if (scanned > 0)
+    {
+        /* Efficiency well below 100% means that reclaim scans many pages it cannot free: thrashing */
+        g_strlcat (tooltip, "\n", size);
+        len = strlen (tooltip);
+        g_snprintf(tooltip + len, size - len, _("Reclaim: %.0f pages/s scanned, %.0f%% efficiency, %.0f%% direct"),
+                   scanned, MIN (100 * stolen / scanned, 100.0), 100 * vm->rate[VMSTAT_PGSCAN_DIRECT] / scanned);
+    }
+    if (vm->oom_kills)
+    {
+        g_strlcat (tooltip, "\n", size);
+        len = strlen (tooltip);
+        g_snprintf(tooltip + len, size - len, _("OOM kills since boot: %" G_GUINT64_FORMAT), vm->oom_kills);
+    }
+    append_statistics(global, PAGING_MONITOR, tooltip, size);
+}
+
+static void
+sample_scheduler(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    /* Parses the /proc/stat buffer of sample_cpu() when the CPU monitor is enabled */
+    snapshot->activity_valid = read_cpu_activity (global->cpu_sampler, &snapshot->activity) == 0;
+    if (snapshot->activity_valid)
+    {
+        /* Full at one runnable task per CPU, not counting the plugin itself */
+        const guint runnable = snapshot->activity.running > 0 ? snapshot->activity.running - 1 : 0;
+        snapshot->value[SCHED_MONITOR] = MIN (100 * runnable / g_get_num_processors (), 100);
+    }
+}
+
+static void
+tooltip_scheduler(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    const SystemloadCpuActivity *activity = &snapshot->activity;
+
+    if (!snapshot->activity_valid)
+    {
+        g_snprintf(tooltip, size, _("Scheduler: not available"));
+        return;
+    }
+
+    gsize len;
+
+    g_snprintf(tooltip, size, _("Tasks: %u runnable, %u blocked on I/O"), activity->running, activity->blocked);
+    g_strlcat (tooltip, "\n", size);
+    len = strlen (tooltip);
+    g_snprintf(tooltip + len, size - len, _("Context switches: %.0f/s, interrupts: %.0f/s"),
+               activity->context_switches, activity->interrupts);
+    g_strlcat (tooltip, "\n", size);
+    len = strlen (tooltip);
+    g_snprintf(tooltip + len, size - len, _("Forks: %.1f/s"), activity->forks);
+    append_statistics(global, SCHED_MONITOR, tooltip, size);
+}
+
+static void
+sample_interrupts(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    snapshot->irq_valid = read_irqstat (global->irq_sampler, &snapshot->irq) == 0;
+    if (snapshot->irq_valid)
+        snapshot->value[IRQ_MONITOR] = snapshot->irq.concentration;
+}
+
+static void
+tooltip_interrupts(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    const SystemloadIrqStat *irq = &snapshot->irq;
+    gsize len;
+
+    if (!snapshot->irq_valid)
+    {
+        g_snprintf(tooltip, size, _("Interrupts: not available"));
+        return;
+    }
+
+    g_snprintf(tooltip, size, _("Interrupts and softirqs: %.0f/s, %u%% concentrated on one CPU"),
+               irq->rate, irq->concentration);
+    for (guint i = 0; i < irq->n_sources; i++)
+    {
+        const SystemloadIrqSource *source = &irq->sources[i];
+        g_strlcat (tooltip, "\n", size);
+        len = strlen (tooltip);
+        g_snprintf(tooltip + len, size - len, _("%s: %.0f/s, %.0f%% on CPU %u"),
+                   source->name, source->rate, source->top_share, source->top_cpu);
+    }
+    for (guint i = 0; i < irq->n_cpus; i++)
+    {
+        g_strlcat (tooltip, i == 0 ? "\n" : ", ", size);
+        len = strlen (tooltip);
+        g_snprintf(tooltip + len, size - len, _("CPU %u: %.0f/s"), irq->cpus[i].cpu, irq->cpus[i].rate);
+    }
+    append_statistics(global, IRQ_MONITOR, tooltip, size);
+}
+
+static void
+sample_tcp(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    const SystemloadTcpStat *tcp = &snapshot->tcp;
+
+    snapshot->tcp_valid = read_tcpstat (global->tcp_sampler, &snapshot->tcp) == 0;
+    if (snapshot->tcp_valid && tcp->out_segments > 0)
+        snapshot->value[TCP_MONITOR] = MIN (lround (100 * tcp->retransmits / tcp->out_segments * 100 / MAX_RETRANSMIT_PERCENT), 100);
+}
+
+static void
+tooltip_tcp(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    const SystemloadTcpStat *tcp = &snapshot->tcp;
+    gsize len;
+
+    if (!snapshot->tcp_valid)
+    {
+        g_snprintf(tooltip, size, _("TCP: not available"));
+        return;
+    }
+
+    g_snprintf(tooltip, size, _("TCP: %.2f%% of %.0f segments/s retransmitted"),
+               tcp->out_segments > 0 ? 100 * tcp->retransmits / tcp->out_segments : 0.0, tcp->out_segments);
+    g_strlcat (tooltip, "\n", size);
+    len = strlen (tooltip);
+    g_snprintf(tooltip + len, size - len, _("Timeouts: %.1f/s, accept queue overflows: %.1f/s"),
+               tcp->timeouts, tcp->listen_overflows);
+
+    gchar *memory = g_format_size (tcp->memory);
+    g_strlcat (tooltip, "\n", size);
+    len = strlen (tooltip);
+    g_snprintf(tooltip + len, size - len, _("Sockets: %u in use, %u orphaned, %s of buffers"),
+               tcp->sockets, tcp->orphans, memory);
+    g_free (memory);
+
+    if (tcp->states_valid)
+    {
+        g_strlcat (tooltip, "\n", size);
+        len = strlen (tooltip);
+        g_snprintf(tooltip + len, size - len, _("Connections: %u established, %u listening, %u time-wait, %u close-wait, %u half-open"),
+                   tcp->states[TCP_STATE_ESTABLISHED], tcp->states[TCP_STATE_LISTEN], tcp->states[TCP_STATE_TIME_WAIT],
+                   tcp->states[TCP_STATE_CLOSE_WAIT], tcp->states[TCP_STATE_SYN_SENT] + tcp->states[TCP_STATE_SYN_RECV]);
+    }
+    append_statistics(global, TCP_MONITOR, tooltip, size);
+}
+
+static void
+sample_compressed(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    const SystemloadCompressedMemory *compressed = &snapshot->compressed;
+
+    /* The bar is the RAM taken by the compressed pages, which the swap bar does not show */
+    snapshot->compressed_valid = read_compressed_memory (global->zram_sampler, global->mem_sampler, &snapshot->compressed) == 0;
+    if (snapshot->compressed_valid && compressed->mem_total)
+        snapshot->value[ZRAM_MONITOR] = MIN (100 * (compressed->zram_used + compressed->zswap_used) / compressed->mem_total, 100);
+
+    /* The part of the swap space which the swap tooltip shows as compressed in RAM */
+    if (snapshot->compressed_valid && compressed->n_zram)
+        read_swap_devices (global->mem_sampler, &snapshot->swap_ram_total, &snapshot->swap_ram_used);
+}
+
+static void
+append_compressed(gchar *tooltip, gsize size, const gchar *format, guint64 stored, guint64 used)
+{
+    gchar *stored_text = g_format_size (stored);
+    gchar *used_text = g_format_size (used);
+
+    g_strlcat (tooltip, "\n", size);
+    gsize len = strlen (tooltip);
+    g_snprintf(tooltip + len, size - len, format, stored_text, used_text, used ? (gdouble) stored / used : 0.0);
+    g_free (stored_text);
+    g_free (used_text);
+}
+
+static void
+tooltip_compressed(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    const SystemloadCompressedMemory *compressed = &snapshot->compressed;
+
+    if (!snapshot->compressed_valid || (compressed->n_zram == 0 && !compressed->zswap))
+    {
+        g_snprintf(tooltip, size, _("No compressed memory"));
+        return;
     }
 
-    if (systemload_config_get_enabled (config, CPU_MONITOR))
+    g_snprintf(tooltip, size, _("Compressed memory: %lu%% of RAM"), snapshot->value[ZRAM_MONITOR]);
+    if (compressed->n_zram)
+        append_compressed (tooltip, size, _("zram: %s stored in %s, ratio %.1f:1"),
+                           compressed->zram_stored, compressed->zram_used);
+    if (compressed->zswap)
+        append_compressed (tooltip, size, _("zswap: %s stored in %s, ratio %.1f:1"),
+                           compressed->zswap_stored, compressed->zswap_used);
+    append_statistics(global, ZRAM_MONITOR, tooltip, size);
+}
+
+static void
+sample_latency(t_global_monitor *global, SystemloadSnapshot *snapshot)
+{
+    const guint budget = systemload_config_get_latency_budget (global->config);
+
+    snapshot->schedstat_valid = read_schedstat (global->schedstat_sampler, &snapshot->schedstat) == 0;
+    if (snapshot->schedstat_valid)
+        snapshot->value[LATENCY_MONITOR] = MIN (lround (100 * snapshot->schedstat.wait / budget), 100);
+}
+
+static void
+tooltip_latency(const t_global_monitor *global, const SystemloadSnapshot *snapshot, gchar *tooltip, gsize size)
+{
+    const SystemloadSchedstat *stat = &snapshot->schedstat;
+
+    if (!snapshot->schedstat_valid)
     {
-        gchar tooltip[128];
-        g_snprintf(tooltip, sizeof(tooltip), _("System Load: %ld%%"), global->monitor[CPU_MONITOR]->value_read);
-        set_tooltip(global->monitor[CPU_MONITOR]->ebox, tooltip);
+        g_snprintf(tooltip, size, _("Scheduler latency: not available"));
+        return;
     }
 
-    if (systemload_config_get_enabled (config, MEM_MONITOR))
+    g_snprintf(tooltip, size, _("Run queue wait: %.2f ms per timeslice, %.0f ms/s in total"),
+               stat->wait / 1e3, stat->wait_rate);
+    for (guint i = 0; i < stat->n_cpus; i++)
     {
-        gchar tooltip[128];
-        g_snprintf(tooltip, sizeof(tooltip), _("Memory: %ldMB of %ldMB used"), MUsed >> 10 , MTotal >> 10);
-        set_tooltip(global->monitor[MEM_MONITOR]->ebox, tooltip);
+        g_strlcat (tooltip, "\n", size);
+        gsize len = strlen (tooltip);
+        g_snprintf(tooltip + len, size - len, _("CPU %u: %.2f ms per timeslice, %.0f ms/s"),
+                   stat->cpus[i].cpu, stat->cpus[i].wait / 1e3, stat->cpus[i].wait_rate);
     }
+    append_statistics(global, LATENCY_MONITOR, tooltip, size);
+}
+
+/*
+ * Warns when the plugin used more CPU time than its budget over the statistics window.
+ * A benchmark can run the panel with G_DEBUG=fatal-warnings to fail on this.
+ */
+static void
+check_self_budget(t_global_monitor *global)
+{
+    const guint budget = systemload_config_get_self_budget (global->config);
+    const gint64 now = g_get_monotonic_time ();
+    const gdouble cpu_seconds = global->snapshot.self.cpu_seconds;
 
-    if (systemload_config_get_enabled (config, NET_MONITOR))
+    if (budget == 0)
     {
-        gchar tooltip[128];
-        g_snprintf(tooltip, sizeof(tooltip), _("Network: %ld Mbit/s"), (glong) round (NTotal / 1e6));
-        set_tooltip(global->monitor[NET_MONITOR]->ebox, tooltip);
+        global->self_window_start = 0;
+        return;
     }
 
-    if (systemload_config_get_enabled (config, SWAP_MONITOR))
+    const gint64 elapsed = now - global->self_window_start;
+    if (global->self_window_start != 0 &&
+        elapsed < (gint64) systemload_config_get_statistics_window (global->config) * G_USEC_PER_SEC)
+        return;
+
+    if (global->self_window_start != 0)
     {
-        gchar tooltip[128];
+        const gdouble share = 100 * (cpu_seconds - global->self_window_cpu) * G_USEC_PER_SEC / elapsed;
+        if (share > budget)
+            g_warning ("The plugin used %.2f%% of a CPU over %" G_GINT64_FORMAT " s at an update interval of %u ms, "
+                       "more than its budget of %u%%",
+                       share, elapsed / G_USEC_PER_SEC, global->stats_interval, budget);
+    }
+
+    global->self_window_start = now;
+    global->self_window_cpu = cpu_seconds;
+}
+
+static void
+update_monitors(t_global_monitor *global)
+{
+    const SystemloadConfig *config = global->config;
+    SystemloadSnapshot *snapshot = &global->snapshot;
+
+    systemload_procfile_begin_tick ();
+
+    memset (snapshot, 0, sizeof (*snapshot));
+    snapshot->time = g_get_real_time ();
+    const bool on_battery = systemload_power_get_state (global->power) != POWER_STATE_AC;
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+        snapshot->enabled[i] = systemload_config_get_enabled (config, (SystemloadMonitor) i) &&
+                               (!on_battery || systemload_config_get_on_battery (config, (SystemloadMonitor) i));
+    snapshot->uptime_enabled = systemload_config_get_uptime_enabled (config);
 
-        if (STotal)
-            g_snprintf(tooltip, sizeof(tooltip), _("Swap: %ldMB of %ldMB used"), SUsed >> 10, STotal >> 10);
+    global->core_loads = NULL;
+    global->n_cores = 0;
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+        if (snapshot->enabled[i])
+            SOURCES[i].sample (global, snapshot);
+
+    if (snapshot->uptime_enabled)
+    {
+        if (systemload_config_get_uptime_source (config) == SOURCE_PROCFS)
+            snapshot->uptime = read_uptime();
         else
-            g_snprintf(tooltip, sizeof(tooltip), _("No swap"));
+            snapshot->uptime = read_uptime_clock();
+    }
 
-        set_tooltip(global->monitor[SWAP_MONITOR]->ebox, tooltip);
+    snapshot->self_enabled = global->exporter || systemload_config_get_self_metrics (config) ||
+                             systemload_config_get_self_budget (config) != 0;
+    if (snapshot->self_enabled)
+    {
+        read_self_usage (global->self_sampler, &snapshot->self);
+        check_self_budget (global);
     }
 
-    if (systemload_config_get_uptime_enabled (config))
+    /*
+     * The first reading of the CPU and network monitors only primes the readers.
+     * Until the next update, show the most recent values from the history instead.
+     */
+    if (!global->primed)
+    {
+        SystemloadSnapshot last;
+        global->primed = true;
+        if (global->history && systemload_history_get (global->history, 0, &last))
+        {
+            snapshot->value[CPU_MONITOR] = last.value[CPU_MONITOR];
+            snapshot->value[NET_MONITOR] = last.value[NET_MONITOR];
+            snapshot->net_bits = last.net_bits;
+        }
+    }
+    else
+    {
+        if (global->history)
+            systemload_history_append (global->history, snapshot);
+        for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+            if (snapshot->enabled[i] && global->monitor[i]->stats)
+                systemload_stats_add (global->monitor[i]->stats, snapshot->value[i]);
+        update_alerts (global);
+    }
+
+    if (global->exporter)
+        systemload_exporter_update (global->exporter, snapshot);
+
+    global->peak_valid = global->peak_sampler && systemload_peak_sampler_take (global->peak_sampler, global->peak);
+
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    {
+        if (snapshot->enabled[i])
+        {
+            const t_monitor *m = global->monitor[i];
+            gulong value = MIN(statistic_value (global, (SystemloadMonitor) i), 100);
+            gchar tooltip[1024];
+
+            set_fraction(GTK_PROGRESS_BAR(m->status), value / 100.0);
+            if (m->stack && gtk_widget_get_visible (m->stack))
+                gtk_widget_queue_draw (m->stack);
+            if (m->heatmap && gtk_widget_get_visible (systemload_heatmap_get_widget (m->heatmap)))
+                update_heatmap (global, global->core_loads, global->n_cores);
+
+            SOURCES[i].tooltip (global, snapshot, tooltip, sizeof(tooltip));
+            if (systemload_config_get_self_metrics (config))
+                append_self_usage (global, tooltip, sizeof(tooltip));
+            set_tooltip(m->ebox, tooltip);
+        }
+    }
+
+    if (snapshot->uptime_enabled)
     {
         gchar days_str[2][32], hours_str[2][32], mins_str[2][32];
         gchar text[128], tooltip[128];
 
-        gint days = global->uptime.value_read / 86400;
-        gint hours = (global->uptime.value_read / 3600) % 24;
-        gint mins = (global->uptime.value_read / 60) % 60;
+        gint days = snapshot->uptime / 86400;
+        gint hours = (snapshot->uptime / 3600) % 24;
+        gint mins = (snapshot->uptime / 60) % 60;
 
         g_snprintf(days_str[0], sizeof(days_str), _("%dd"), days);
         g_snprintf(hours_str[0], sizeof(hours_str), _("%dh"), hours);
@@ -286,11 +1181,33 @@ monitor_update_orientation (XfcePanelPlugin  *plugin,
         gtk_progress_bar_set_inverted (GTK_PROGRESS_BAR(global->monitor[count]->status), (panel_orientation == GTK_ORIENTATION_HORIZONTAL));
         gtk_orientable_set_orientation (GTK_ORIENTABLE(global->monitor[count]->status),
                                         (panel_orientation == GTK_ORIENTATION_HORIZONTAL) ? GTK_ORIENTATION_VERTICAL : GTK_ORIENTATION_HORIZONTAL);
+        if (global->monitor[count]->heatmap)
+            systemload_heatmap_set_orientation (global->monitor[count]->heatmap, panel_orientation);
     }
     gtk_label_set_angle(GTK_LABEL(global->uptime.label),
                         (orientation == GTK_ORIENTATION_HORIZONTAL) ? 0 : -90);
 }
 
+static void
+create_cpu (t_global_monitor *global, t_monitor *m)
+{
+    m->stack = gtk_drawing_area_new();
+    g_signal_connect (G_OBJECT (m->stack), "draw", G_CALLBACK (draw_cpu_stack_cb), global);
+    gtk_box_pack_start(GTK_BOX(m->box), m->stack, FALSE, FALSE, 0);
+
+    m->heatmap = systemload_heatmap_new();
+    systemload_heatmap_set_orientation(m->heatmap, xfce_panel_plugin_get_orientation(global->plugin));
+    gtk_box_pack_start(GTK_BOX(m->box), systemload_heatmap_get_widget(m->heatmap), FALSE, FALSE, 0);
+}
+
+static void
+create_memory (t_global_monitor *global, t_monitor *m)
+{
+    m->stack = gtk_drawing_area_new();
+    g_signal_connect (G_OBJECT (m->stack), "draw", G_CALLBACK (draw_mem_nodes_cb), global);
+    gtk_box_pack_start(GTK_BOX(m->box), m->stack, FALSE, FALSE, 0);
+}
+
 static void
 create_monitor (t_global_monitor *global)
 {
@@ -299,9 +1216,9 @@ create_monitor (t_global_monitor *global)
     global->box = gtk_box_new(xfce_panel_plugin_get_orientation(global->plugin), 0);
     gtk_widget_show(global->box);
 
-    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    for(guint i = 0; i < systemload_registry_get_n_monitors (); i++)
     {
-        SystemloadMonitor monitor = VISUAL_ORDER[i];
+        SystemloadMonitor monitor = systemload_registry_get_nth (i)->id;
         t_monitor *m = global->monitor[monitor];
 
         m->label = gtk_label_new (systemload_config_get_label (config, monitor));
@@ -336,6 +1253,9 @@ create_monitor (t_global_monitor *global)
         gtk_widget_show(GTK_WIDGET(m->status));
 
         gtk_box_pack_start(GTK_BOX(m->box), GTK_WIDGET(m->status), FALSE, FALSE, 0);
+
+        if (SOURCES[monitor].create)
+            SOURCES[monitor].create (global, m);
         gtk_box_pack_start(GTK_BOX(global->box), GTK_WIDGET(m->ebox), FALSE, FALSE, 0);
 
         gtk_widget_show_all(GTK_WIDGET(m->ebox));
@@ -356,107 +1276,411 @@ create_monitor (t_global_monitor *global)
                        GTK_WIDGET(global->uptime.ebox),
                        FALSE, FALSE, 0);
 
-    gtk_container_add(GTK_CONTAINER(global->ebox), GTK_WIDGET(global->box));
-    gtk_event_box_set_visible_window(GTK_EVENT_BOX(global->ebox), FALSE);
-    gtk_widget_show(GTK_WIDGET(global->ebox));
+    gtk_container_add(GTK_CONTAINER(global->ebox), GTK_WIDGET(global->box));
+    gtk_event_box_set_visible_window(GTK_EVENT_BOX(global->ebox), FALSE);
+    gtk_widget_show(GTK_WIDGET(global->ebox));
+}
+
+static t_global_monitor *
+monitor_control_new(XfcePanelPlugin *plugin)
+{
+    t_global_monitor *global = g_new0 (t_global_monitor, 1);
+    global->plugin = plugin;
+    global->power = systemload_power_new (power_changed_cb, global);
+    global->numa = systemload_numa_new ();
+    global->cpu_sampler = systemload_cpu_sampler_new (NULL);
+    global->mem_sampler = systemload_mem_sampler_new (NULL);
+    global->net_sampler = systemload_net_sampler_new (NULL);
+    global->self_sampler = systemload_self_sampler_new ();
+
+    /* initialize xfconf */
+    global->config = systemload_config_new (xfce_panel_plugin_get_property_base (plugin));
+
+    global->timeout = systemload_config_get_timeout (global->config);
+    if (global->timeout < MIN_TIMEOUT)
+        global->timeout = MIN_TIMEOUT;
+    global->timeout_seconds = systemload_config_get_timeout_seconds (global->config);
+    global->use_timeout_seconds = (global->timeout_seconds > 0);
+
+    global->ebox = gtk_event_box_new();
+    gtk_widget_show(global->ebox);
+
+    global->command.command_text = g_strdup (systemload_config_get_system_monitor_command (global->config));
+    if (strlen(global->command.command_text) > 0)
+        global->command.enabled = true;
+
+    xfce_panel_plugin_add_action_widget (plugin, global->ebox);
+
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    {
+        global->monitor[i] = g_new0 (t_monitor, 1);
+        global->monitor[i]->alert = systemload_alert_new ();
+    }
+
+    setup_history (global);
+
+    systemload_config_on_change (global->config, setup_monitor_cb, global);
+
+    return global;
+}
+
+static void
+monitor_free(XfcePanelPlugin *plugin, t_global_monitor *global)
+{
+    systemload_power_free (global->power);
+
+    if (global->timeout_id)
+        g_source_remove(global->timeout_id);
+    if (global->peak_timeout_id)
+        g_source_remove(global->peak_timeout_id);
+    systemload_peak_sampler_free (global->peak_sampler);
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+        if (SOURCES[i].setup)
+            SOURCES[i].setup (global, false);
+
+    systemload_exporter_free (global->exporter);
+    systemload_history_close (global->history);
+    systemload_cpu_topology_free (global->topology);
+    systemload_numa_free (global->numa);
+    systemload_cpu_sampler_free (global->cpu_sampler);
+    systemload_mem_sampler_free (global->mem_sampler);
+    systemload_net_sampler_free (global->net_sampler);
+    systemload_self_sampler_free (global->self_sampler);
+
+    g_free(global->command.command_text);
+
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    {
+        systemload_stats_free (global->monitor[i]->stats);
+        systemload_alert_free (global->monitor[i]->alert);
+        g_free (global->monitor[i]);
+    }
+
+    g_free(global);
+}
+
+static gboolean
+update_monitors_cb(gpointer user_data)
+{
+    auto global = (t_global_monitor*) user_data;
+
+    update_monitors (global);
+    return TRUE;
+}
+
+/* (Re)creates the statistics if the update interval or the statistics settings have changed */
+static void
+setup_stats(t_global_monitor *global, guint interval)
+{
+    const guint window_seconds = systemload_config_get_statistics_window (global->config);
+    const guint window = (1000 * window_seconds + interval - 1) / interval;
+    const gdouble half_life = 1000.0 * systemload_config_get_statistics_half_life (global->config) / interval;
+
+    if (global->stats_interval == interval && global->monitor[0]->stats &&
+        systemload_stats_get_window (global->monitor[0]->stats) == window &&
+        global->stats_half_life == half_life)
+        return;
+
+    global->stats_interval = interval;
+    global->stats_half_life = half_life;
+
+    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    {
+        systemload_stats_free (global->monitor[i]->stats);
+        global->monitor[i]->stats = systemload_stats_new (window, half_life);
+    }
+
+    /* Pre-fill the statistics with the part of the history that falls into the window */
+    if (global->history)
+    {
+        const gint64 start = g_get_real_time () - (gint64) window_seconds * G_USEC_PER_SEC;
+        guint n = MIN (systemload_history_get_length (global->history), window);
+        while (n-- > 0)
+        {
+            SystemloadSnapshot record;
+            if (!systemload_history_get (global->history, n, &record) || record.time < start)
+                continue;
+            for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+                if (record.enabled[i])
+                    systemload_stats_add (global->monitor[i]->stats, record.value[i]);
+        }
+    }
+}
+
+static gboolean
+update_peaks_cb(gpointer user_data)
+{
+    auto global = (t_global_monitor*) user_data;
+    const guint interval = systemload_peak_sampler_sample (global->peak_sampler, global->peak_enabled);
+
+    /* The interval grows while the sampling exceeds its CPU budget */
+    if (interval == global->peak_interval)
+        return TRUE;
+    global->peak_interval = interval;
+    global->peak_timeout_id = g_timeout_add (interval, update_peaks_cb, global);
+    return FALSE;
+}
+
+/*
+ * Samples the monitors which show their peak between the updates, but only on AC power
+ * and outside of the power saver mode. interval is the update interval, 0 if there are no updates.
+ */
+static void
+setup_peak(t_global_monitor *global, guint interval)
+{
+    const SystemloadConfig *config = global->config;
+    const bool power_saving = systemload_power_get_state (global->power) != POWER_STATE_AC ||
+                              systemload_power_get_power_saver (global->power);
+    bool any = false;
+
+    for (gsize i = 0; i < G_N_ELEMENTS (global->peak_enabled); i++)
+    {
+        const auto monitor = (SystemloadMonitor) i;
+        global->peak_enabled[i] = interval != 0 && !power_saving &&
+                                  systemload_peak_sampler_supports (monitor) &&
+                                  systemload_config_get_enabled (config, monitor) &&
+                                  systemload_config_get_statistic (config, monitor) == STATISTIC_PEAK;
+        any = any || global->peak_enabled[i];
+    }
+
+    if (global->peak_timeout_id)
+        g_source_remove (global->peak_timeout_id);
+    global->peak_timeout_id = 0;
+    global->peak_valid = false;
+
+    if (!any)
+    {
+        systemload_peak_sampler_free (global->peak_sampler);
+        global->peak_sampler = NULL;
+        return;
+    }
+
+    if (!global->peak_sampler)
+        global->peak_sampler = systemload_peak_sampler_new ();
+    systemload_peak_sampler_set_policy (global->peak_sampler,
+                                        systemload_config_get_peak_interval (config),
+                                        interval,
+                                        systemload_config_get_peak_budget (config));
+    systemload_peak_sampler_set_network_filter (global->peak_sampler,
+                                                systemload_config_get_network_include (config),
+                                                systemload_config_get_network_exclude (config));
+
+    global->peak_interval = systemload_peak_sampler_sample (global->peak_sampler, global->peak_enabled);
+    global->peak_timeout_id = g_timeout_add (global->peak_interval, update_peaks_cb, global);
+}
+
+static void
+setup_timer(t_global_monitor *global)
+{
+    const SystemloadPowerState state = systemload_power_get_state (global->power);
+    guint multipliers[N_POWER_STATES];
+    GtkSettings *settings;
+
+    if (global->timeout_id)
+        g_source_remove(global->timeout_id);
+    global->timeout_id = 0;
+
+    for (gsize i = 0; i < G_N_ELEMENTS (multipliers); i++)
+        multipliers[i] = systemload_config_get_power_multiplier (global->config, (SystemloadPowerState) i);
+    const guint interval = systemload_power_get_interval (global->power, global->timeout,
+                                                          global->use_timeout_seconds ? 1000 * global->timeout_seconds : 0,
+                                                          multipliers,
+                                                          systemload_config_get_power_saver_multiplier (global->config));
+    if (interval == 0)
+    {
+        setup_peak (global, 0);
+        return;
+    }
+
+    /* A timer in whole seconds lets GLib batch the wakeup with those of other processes */
+    if ((state != POWER_STATE_AC || systemload_power_get_power_saver (global->power)) && interval % 1000 == 0)
+        global->timeout_id = g_timeout_add_seconds(interval / 1000, update_monitors_cb, global);
+    else
+        global->timeout_id = g_timeout_add(interval, update_monitors_cb, global);
+    setup_stats (global, interval);
+    setup_peak (global, interval);
+    /* reduce the default tooltip timeout to be smaller than the update interval otherwise
+     * we won't see tooltips on GTK 2.16 or newer */
+    settings = gtk_settings_get_default();
+    if (g_object_class_find_property(G_OBJECT_GET_CLASS(settings), "gtk-tooltip-timeout"))
+        g_object_set(settings, "gtk-tooltip-timeout",
+                     global->timeout - 10, NULL);
+
+}
+
+/* Applies the sampling policy of the current power state */
+static void
+setup_power(t_global_monitor *global)
+{
+    const bool on_battery = systemload_power_get_state (global->power) != POWER_STATE_AC;
+
+    /* update_monitors() skips these, until the next tick on AC overwrites the bar and the tooltip */
+    for (gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    {
+        if (on_battery && !systemload_config_get_on_battery (global->config, (SystemloadMonitor) i))
+        {
+            set_fraction (GTK_PROGRESS_BAR (global->monitor[i]->status), 0);
+            set_tooltip (global->monitor[i]->ebox, _("Paused while running on battery"));
+        }
+    }
 
-    update_monitors (global);
+    setup_timer (global);
 }
 
-static t_global_monitor *
-monitor_control_new(XfcePanelPlugin *plugin)
+static void
+power_changed_cb(gpointer user_data)
 {
-    t_global_monitor *global = g_new0 (t_global_monitor, 1);
-#ifdef HAVE_UPOWER_GLIB
-    global->upower = up_client_new();
-#endif
-    global->plugin = plugin;
+    setup_power ((t_global_monitor*) user_data);
+}
 
-    /* initialize xfconf */
-    global->config = systemload_config_new (xfce_panel_plugin_get_property_base (plugin));
+static gboolean
+update_filesystems_cb(gpointer user_data)
+{
+    auto global = (t_global_monitor*) user_data;
 
-    global->timeout = systemload_config_get_timeout (global->config);
-    if (global->timeout < MIN_TIMEOUT)
-        global->timeout = MIN_TIMEOUT;
-    global->timeout_seconds = systemload_config_get_timeout_seconds (global->config);
-    global->use_timeout_seconds = (global->timeout_seconds > 0);
+    systemload_filesystems_update (global->filesystems);
+    return TRUE;
+}
 
-    global->ebox = gtk_event_box_new();
-    gtk_widget_show(global->ebox);
+/*
+ * The free space changes slowly, so statvfs() runs on a timer of its own, and only while the monitor
+ * is shown. The mount table is watched only while the monitor is enabled as well.
+ */
+static void
+setup_filesystems(t_global_monitor *global, bool enabled)
+{
+    const SystemloadConfig *config = global->config;
+    const guint interval = systemload_config_get_filesystem_interval (config);
 
-    global->command.command_text = g_strdup (systemload_config_get_system_monitor_command (global->config));
-    if (strlen(global->command.command_text) > 0)
-        global->command.enabled = true;
+    if (!enabled)
+    {
+        if (global->filesystems_timeout_id)
+            g_source_remove (global->filesystems_timeout_id);
+        global->filesystems_timeout_id = 0;
+        systemload_filesystems_free (global->filesystems);
+        global->filesystems = NULL;
+        return;
+    }
 
-    xfce_panel_plugin_add_action_widget (plugin, global->ebox);
+    if (!global->filesystems)
+        global->filesystems = systemload_filesystems_new ();
 
-    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
-        global->monitor[i] = g_new0 (t_monitor, 1);
+    systemload_filesystems_set_mount_points (global->filesystems,
+                                             systemload_config_get_filesystem_mount_points (config));
+    systemload_filesystems_update (global->filesystems);
 
-    systemload_config_on_change (global->config, setup_monitor_cb, global);
+    if (global->filesystems_timeout_id && global->filesystems_interval == interval)
+        return;
 
-    return global;
+    if (global->filesystems_timeout_id)
+        g_source_remove (global->filesystems_timeout_id);
+    global->filesystems_interval = interval;
+    global->filesystems_timeout_id = g_timeout_add_seconds (interval, update_filesystems_cb, global);
 }
 
 static void
-monitor_free(XfcePanelPlugin *plugin, t_global_monitor *global)
+setup_cpu(t_global_monitor *global, bool enabled)
 {
-#ifdef HAVE_UPOWER_GLIB
-    if (global->upower) {
-        g_object_unref(global->upower);
-        global->upower = NULL;
+    const t_monitor *m = global->monitor[CPU_MONITOR];
+    const SystemloadCpuDisplay mode = systemload_config_get_cpu_display_mode (global->config);
+    const GdkRGBA *color = systemload_config_get_color (global->config, CPU_MONITOR);
+
+    if (!enabled)
+        return;
+
+    gtk_widget_set_visible (m->status, mode == CPU_DISPLAY_BAR);
+    gtk_widget_set_visible (m->stack, mode == CPU_DISPLAY_STACKED);
+    gtk_widget_set_visible (systemload_heatmap_get_widget (m->heatmap), mode == CPU_DISPLAY_HEATMAP);
+    if (mode == CPU_DISPLAY_HEATMAP)
+    {
+        if (G_LIKELY (color != NULL))
+            systemload_heatmap_set_color (m->heatmap, color);
+        if (systemload_heatmap_get_n_cells (m->heatmap) != 0)
+            setup_heatmap (global, systemload_heatmap_get_n_cells (m->heatmap));
     }
-#endif
+}
 
-    if (global->timeout_id)
-        g_source_remove(global->timeout_id);
+static void
+setup_memory(t_global_monitor *global, bool enabled)
+{
+    const t_monitor *m = global->monitor[MEM_MONITOR];
 
-    g_free(global->command.command_text);
+    if (enabled)
+    {
+        bool split = systemload_config_get_memory_numa_split (global->config) &&
+                     systemload_numa_get_n_nodes (global->numa) != 0;
+        gtk_widget_set_visible (m->status, !split);
+        gtk_widget_set_visible (m->stack, split);
+    }
+}
 
-    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
-        g_free (global->monitor[i]);
+static void
+setup_network(t_global_monitor *global, bool enabled)
+{
+    if (enabled)
+        set_netload_filter (global->net_sampler,
+                            systemload_config_get_network_include (global->config),
+                            systemload_config_get_network_exclude (global->config));
+}
 
-    g_free(global);
+static void
+setup_paging(t_global_monitor *global, bool enabled)
+{
+    if (enabled && !global->vmstat_sampler)
+        global->vmstat_sampler = systemload_vmstat_sampler_new ();
+    else if (!enabled && global->vmstat_sampler)
+    {
+        systemload_vmstat_sampler_free (global->vmstat_sampler);
+        global->vmstat_sampler = NULL;
+    }
 }
 
-static gboolean
-update_monitors_cb(gpointer user_data)
+static void
+setup_interrupts(t_global_monitor *global, bool enabled)
 {
-    auto global = (t_global_monitor*) user_data;
+    if (enabled && !global->irq_sampler)
+        global->irq_sampler = systemload_irq_sampler_new ();
+    else if (!enabled && global->irq_sampler)
+    {
+        systemload_irq_sampler_free (global->irq_sampler);
+        global->irq_sampler = NULL;
+    }
+}
 
-    update_monitors (global);
-    return TRUE;
+static void
+setup_tcp(t_global_monitor *global, bool enabled)
+{
+    if (enabled && !global->tcp_sampler)
+        global->tcp_sampler = systemload_tcp_sampler_new ();
+    else if (!enabled && global->tcp_sampler)
+    {
+        systemload_tcp_sampler_free (global->tcp_sampler);
+        global->tcp_sampler = NULL;
+    }
 }
 
 static void
-setup_timer(t_global_monitor *global)
+setup_compressed(t_global_monitor *global, bool enabled)
 {
-    GtkSettings *settings;
-    if (global->timeout_id)
-        g_source_remove(global->timeout_id);
-#ifdef HAVE_UPOWER_GLIB
-    if (global->upower && global->use_timeout_seconds) {
-        if (up_client_get_on_battery(global->upower)) {
-            if (!up_client_get_lid_is_closed(global->upower)) {
-                global->timeout_id = g_timeout_add_seconds(
-                                        global->timeout_seconds,
-                                        update_monitors_cb, global);
-            } else {
-                /* Don't do any timeout if the lid is closed on battery */
-                global->timeout_id = 0;
-            }
-            return;
-        }
+    if (enabled && !global->zram_sampler)
+        global->zram_sampler = systemload_zram_sampler_new ();
+    else if (!enabled && global->zram_sampler)
+    {
+        systemload_zram_sampler_free (global->zram_sampler);
+        global->zram_sampler = NULL;
     }
-#endif
-    global->timeout_id = g_timeout_add(global->timeout, update_monitors_cb, global);
-    /* reduce the default tooltip timeout to be smaller than the update interval otherwise
-     * we won't see tooltips on GTK 2.16 or newer */
-    settings = gtk_settings_get_default();
-    if (g_object_class_find_property(G_OBJECT_GET_CLASS(settings), "gtk-tooltip-timeout"))
-        g_object_set(settings, "gtk-tooltip-timeout",
-                     global->timeout - 10, NULL);
+}
 
+static void
+setup_latency(t_global_monitor *global, bool enabled)
+{
+    if (enabled && !global->schedstat_sampler)
+        global->schedstat_sampler = systemload_schedstat_sampler_new ();
+    else if (!enabled && global->schedstat_sampler)
+    {
+        systemload_schedstat_sampler_free (global->schedstat_sampler);
+        global->schedstat_sampler = NULL;
+    }
 }
 
 static void
@@ -474,6 +1698,45 @@ set_margin (const t_global_monitor *global, GtkWidget *w, gint margin)
     }
 }
 
+static void
+setup_exporter(t_global_monitor *global)
+{
+    const gchar *path = systemload_config_get_metrics_socket (global->config);
+
+    if (global->exporter && g_strcmp0 (systemload_exporter_get_path (global->exporter), path) == 0)
+        return;
+
+    systemload_exporter_free (global->exporter);
+    global->exporter = NULL;
+
+    if (path && *path)
+    {
+        global->exporter = systemload_exporter_new (path);
+        if (global->exporter)
+            systemload_exporter_update (global->exporter, &global->snapshot);
+    }
+}
+
+static void
+setup_history(t_global_monitor *global)
+{
+    if (systemload_config_get_history_enabled (global->config))
+    {
+        if (!global->history)
+        {
+            gchar *name = g_strdup_printf ("%s-%d", xfce_panel_plugin_get_name (global->plugin),
+                                           xfce_panel_plugin_get_unique_id (global->plugin));
+            global->history = systemload_history_open (name);
+            g_free (name);
+        }
+    }
+    else
+    {
+        systemload_history_close (global->history);
+        global->history = NULL;
+    }
+}
+
 static void
 setup_monitors(t_global_monitor *global)
 {
@@ -512,8 +1775,9 @@ setup_monitors(t_global_monitor *global)
             gchar *color_str = gdk_rgba_to_string(color);
             gchar *css;
 #if GTK_CHECK_VERSION (3, 20, 0)
-            css = g_strdup_printf("progressbar progress { background-color: %s; background-image: none; border-color: %s; }",
-                                  color_str, color_str);
+            css = g_strdup_printf("progressbar progress { background-color: %s; background-image: none; border-color: %s; }"
+                                  "progressbar.alert progress { background-color: %s; border-color: %s; }",
+                                  color_str, color_str, ALERT_COLOR, ALERT_COLOR);
 #else
             css = g_strdup_printf(".progressbar progress { background-color: %s; background-image: none; }", color);
 #endif
@@ -538,6 +1802,9 @@ setup_monitors(t_global_monitor *global)
             gtk_widget_set_visible (m->label, label_visible);
             set_margin (global, m->ebox, (n_enabled_labels == 0) ? 0 : 6);
         }
+
+        if (SOURCES[monitor].setup)
+            SOURCES[monitor].setup (global, systemload_config_get_enabled (config, monitor));
     }
 
     if (systemload_config_get_uptime_enabled (config))
@@ -546,7 +1813,9 @@ setup_monitors(t_global_monitor *global)
         set_margin (global, global->uptime.ebox, (n_enabled == 0) ? 0 : 6);
     }
 
-    setup_timer (global);
+    setup_exporter (global);
+    setup_history (global);
+    setup_power (global);
 }
 
 static gboolean
@@ -567,10 +1836,14 @@ monitor_set_size(XfcePanelPlugin *plugin, int size, t_global_monitor *global)
         if (xfce_panel_plugin_get_orientation (plugin) == GTK_ORIENTATION_HORIZONTAL)
         {
             gtk_widget_set_size_request(GTK_WIDGET(global->monitor[i]->status), 8, -1);
+            if (global->monitor[i]->stack)
+                gtk_widget_set_size_request(global->monitor[i]->stack, 8, -1);
         }
         else
         {
             gtk_widget_set_size_request(GTK_WIDGET(global->monitor[i]->status), -1, 8);
+            if (global->monitor[i]->stack)
+                gtk_widget_set_size_request(global->monitor[i]->stack, -1, 8);
         }
     }
 
@@ -597,18 +1870,6 @@ monitor_set_mode (XfcePanelPlugin *plugin, XfcePanelPluginMode mode, t_global_mo
   monitor_set_size (plugin, xfce_panel_plugin_get_size (plugin), global);
 }
 
-#ifdef HAVE_UPOWER_GLIB
-static void
-#if UP_CHECK_VERSION(0, 99, 0)
-upower_changed_cb(UpClient *client, GParamSpec *pspec, t_global_monitor *global)
-#else /* UP_CHECK_VERSION < 0.99 */
-upower_changed_cb(UpClient *client, t_global_monitor *global)
-#endif /* UP_CHECK_VERSION */
-{
-    setup_timer(global);
-}
-#endif /* HAVE_UPOWER_GLIB */
-
 static void
 command_entry_changed_cb(GtkEntry *entry, t_global_monitor *global)
 {
@@ -672,12 +1933,153 @@ static GtkWidget *new_label (GtkGrid *grid, guint row, const gchar *labeltext, G
     return label;
 }
 
+static void
+add_cpu_settings (t_global_monitor *global, GtkGrid *grid)
+{
+    GtkWidget *label;
+
+    /* Single bar or one segment per CPU state */
+    GtkWidget *combo = gtk_combo_box_text_new ();
+    gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Bar"));
+    gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Stacked bar"));
+    gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Heatmap"));
+    gtk_widget_set_tooltip_text (combo, _("The stacked bar shows user, system, IRQ, I/O wait and steal time, "
+                                          "the heatmap shows one cell per core"));
+    g_object_bind_property (G_OBJECT (global->config), "cpu-display-mode",
+                            G_OBJECT (combo), "active",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_grid_attach (grid, combo, 1, 3, 1, 1);
+
+    label = gtk_label_new_with_mnemonic (_("Display:"));
+    gtk_widget_set_halign (label, GTK_ALIGN_START);
+    gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+    gtk_widget_set_margin_start (label, 12);
+    gtk_label_set_mnemonic_widget (GTK_LABEL (label), combo);
+    gtk_grid_attach (grid, label, 0, 3, 1, 1);
+
+    GtkWidget *check = gtk_check_button_new_with_mnemonic (_("_Group cores by NUMA node and socket"));
+    g_object_bind_property (G_OBJECT (global->config), "cpu-heatmap-grouping",
+                            G_OBJECT (check), "active",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_grid_attach (grid, check, 1, 4, 2, 1);
+}
+
+static void
+add_memory_settings (t_global_monitor *global, GtkGrid *grid)
+{
+    GtkWidget *check = gtk_check_button_new_with_mnemonic (_("Split the bar by _NUMA node"));
+    g_object_bind_property (G_OBJECT (global->config), "memory-numa-split",
+                            G_OBJECT (check), "active",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    if (systemload_numa_get_n_nodes (global->numa) == 0)
+    {
+        gtk_widget_set_sensitive (check, FALSE);
+        gtk_widget_set_tooltip_text (check, _("This machine has a single NUMA node"));
+    }
+    gtk_grid_attach (grid, check, 1, 3, 2, 1);
+}
+
+static void
+add_network_settings (t_global_monitor *global, GtkGrid *grid)
+{
+    GtkWidget *label;
+
+    /* Interface filter */
+    GtkWidget *entry = gtk_entry_new ();
+    gtk_widget_set_tooltip_text (entry, _("Interfaces which are always counted, for example \"wg* tun0\""));
+    g_object_bind_property (G_OBJECT (global->config), "network-include",
+                            G_OBJECT (entry), "text",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_grid_attach (grid, entry, 1, 3, 2, 1);
+
+    label = gtk_label_new_with_mnemonic (_("_Include:"));
+    gtk_widget_set_halign (label, GTK_ALIGN_START);
+    gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+    gtk_widget_set_margin_start (label, 12);
+    gtk_label_set_mnemonic_widget (GTK_LABEL (label), entry);
+    gtk_grid_attach (grid, label, 0, 3, 1, 1);
+
+    entry = gtk_entry_new ();
+    gtk_widget_set_tooltip_text (entry, _("Interfaces which are never counted, for example \"docker* enp3s0\". "
+                                          "By default, loopback, virtual and slave interfaces are not counted."));
+    g_object_bind_property (G_OBJECT (global->config), "network-exclude",
+                            G_OBJECT (entry), "text",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_grid_attach (grid, entry, 1, 4, 2, 1);
+
+    label = gtk_label_new_with_mnemonic (_("E_xclude:"));
+    gtk_widget_set_halign (label, GTK_ALIGN_START);
+    gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+    gtk_widget_set_margin_start (label, 12);
+    gtk_label_set_mnemonic_widget (GTK_LABEL (label), entry);
+    gtk_grid_attach (grid, label, 0, 4, 1, 1);
+}
+
+static void
+add_filesystem_settings (t_global_monitor *global, GtkGrid *grid)
+{
+    GtkWidget *label;
+
+    GtkWidget *entry = gtk_entry_new ();
+    gtk_widget_set_tooltip_text (entry, _("Separated by semicolons, for example \"/;/home\". "
+                                          "Leave empty to monitor all local filesystems."));
+    g_object_bind_property (G_OBJECT (global->config), "filesystem-mount-points",
+                            G_OBJECT (entry), "text",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_grid_attach (grid, entry, 1, 3, 2, 1);
+
+    label = gtk_label_new_with_mnemonic (_("_Mount points:"));
+    gtk_widget_set_halign (label, GTK_ALIGN_START);
+    gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+    gtk_widget_set_margin_start (label, 12);
+    gtk_label_set_mnemonic_widget (GTK_LABEL (label), entry);
+    gtk_grid_attach (grid, label, 0, 3, 1, 1);
+
+    GtkWidget *box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+    GtkWidget *interval = gtk_spin_button_new_with_range (1, 3600, 1);
+    g_object_bind_property (G_OBJECT (global->config), "filesystem-interval",
+                            G_OBJECT (interval), "value",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_box_pack_start (GTK_BOX (box), interval, FALSE, TRUE, 0);
+    gtk_box_pack_start (GTK_BOX (box), gtk_label_new ("s"), FALSE, FALSE, 0);
+    gtk_grid_attach (grid, box, 1, 4, 2, 1);
+
+    label = gtk_label_new_with_mnemonic (_("Check _every:"));
+    gtk_widget_set_halign (label, GTK_ALIGN_START);
+    gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+    gtk_widget_set_margin_start (label, 12);
+    gtk_label_set_mnemonic_widget (GTK_LABEL (label), interval);
+    gtk_grid_attach (grid, label, 0, 4, 1, 1);
+}
+
+static void
+add_latency_settings (t_global_monitor *global, GtkGrid *grid)
+{
+    GtkWidget *box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+    GtkWidget *budget = gtk_spin_button_new_with_range (100, 1000000, 100);
+    gtk_widget_set_tooltip_text (budget, _("Average wait on a run queue per timeslice at which the bar is full"));
+    g_object_bind_property (G_OBJECT (global->config), "latency-budget",
+                            G_OBJECT (budget), "value",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_box_pack_start (GTK_BOX (box), budget, FALSE, TRUE, 0);
+    gtk_box_pack_start (GTK_BOX (box), gtk_label_new ("µs"), FALSE, FALSE, 0);
+    gtk_grid_attach (grid, box, 1, 3, 2, 1);
+
+    GtkWidget *label = gtk_label_new_with_mnemonic (_("Latency _budget:"));
+    gtk_widget_set_halign (label, GTK_ALIGN_START);
+    gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+    gtk_widget_set_margin_start (label, 12);
+    gtk_label_set_mnemonic_widget (GTK_LABEL (label), budget);
+    gtk_grid_attach (grid, label, 0, 3, 1, 1);
+}
+
 /* Create a new monitor setting  with gtkswitch, and eventually a color button and a checkbox + entry */
 static void
 new_monitor_setting (t_global_monitor *global,
                      GtkGrid *grid, int position,
                      const gchar *title, bool color,
-                     const gchar *setting)
+                     const gchar *setting,
+                     void (*add_settings)(t_global_monitor *global, GtkGrid *grid))
 {
     GtkWidget *sw, *label;
     gchar *markup, *setting_name;
@@ -750,6 +2152,72 @@ new_monitor_setting (t_global_monitor *global,
             g_free (setting_name);
             gtk_grid_attach(GTK_GRID(subgrid), button, 2, 0, 1, 1);
         }
+
+        /* Value shown by the bar */
+        GtkWidget *combo = gtk_combo_box_text_new ();
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Current value"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Average"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Minimum"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Maximum"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("95th percentile"));
+        gtk_combo_box_text_append_text (GTK_COMBO_BOX_TEXT (combo), _("Peak since the last update"));
+        setting_name = g_strconcat (setting, "-statistic", NULL);
+        g_object_bind_property (G_OBJECT (global->config), setting_name,
+                                G_OBJECT (combo), "active",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        g_free (setting_name);
+        gtk_grid_attach (GTK_GRID(subgrid), combo, 1, 1, 1, 1);
+
+        label = gtk_label_new_with_mnemonic (_("Show:"));
+        gtk_widget_set_halign (label, GTK_ALIGN_START);
+        gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+        gtk_widget_set_margin_start (label, 12);
+        gtk_label_set_mnemonic_widget (GTK_LABEL (label), combo);
+        gtk_grid_attach (GTK_GRID(subgrid), label, 0, 1, 1, 1);
+
+        /* Alert threshold and hold duration */
+        GtkWidget *box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+        GtkWidget *threshold = gtk_spin_button_new_with_range (0, 100, 1);
+        gtk_widget_set_tooltip_text (threshold, _("Set to zero to disable the alert"));
+        setting_name = g_strconcat (setting, "-alert-threshold", NULL);
+        g_object_bind_property (G_OBJECT (global->config), setting_name,
+                                G_OBJECT (threshold), "value",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        g_free (setting_name);
+        gtk_box_pack_start (GTK_BOX (box), threshold, FALSE, TRUE, 0);
+        gtk_box_pack_start (GTK_BOX (box), gtk_label_new ("%"), FALSE, FALSE, 0);
+        gtk_box_pack_start (GTK_BOX (box), gtk_label_new (_("for")), FALSE, FALSE, 0);
+        GtkWidget *hold = gtk_spin_button_new_with_range (0, 3600, 1);
+        setting_name = g_strconcat (setting, "-alert-hold", NULL);
+        g_object_bind_property (G_OBJECT (global->config), setting_name,
+                                G_OBJECT (hold), "value",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        g_free (setting_name);
+        gtk_box_pack_start (GTK_BOX (box), hold, FALSE, TRUE, 0);
+        gtk_box_pack_start (GTK_BOX (box), gtk_label_new ("s"), FALSE, FALSE, 0);
+        gtk_grid_attach (GTK_GRID(subgrid), box, 1, 2, 2, 1);
+
+        label = gtk_label_new_with_mnemonic (_("Alert above:"));
+        gtk_widget_set_halign (label, GTK_ALIGN_START);
+        gtk_widget_set_valign (label, GTK_ALIGN_CENTER);
+        gtk_widget_set_margin_start (label, 12);
+        gtk_label_set_mnemonic_widget (GTK_LABEL (label), threshold);
+        gtk_grid_attach (GTK_GRID(subgrid), label, 0, 2, 1, 1);
+
+        if (add_settings)
+            add_settings (global, GTK_GRID (subgrid));
+
+#ifdef HAVE_UPOWER_GLIB
+        GtkWidget *check = gtk_check_button_new_with_mnemonic (_("Update while on _battery"));
+        gtk_widget_set_margin_start (check, 12);
+        gtk_widget_set_tooltip_text (check, _("When unchecked, the monitor is paused while running on battery"));
+        setting_name = g_strconcat (setting, "-on-battery", NULL);
+        g_object_bind_property (G_OBJECT (global->config), setting_name,
+                                G_OBJECT (check), "active",
+                                GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+        g_free (setting_name);
+        gtk_grid_attach_next_to (GTK_GRID(subgrid), check, NULL, GTK_POS_BOTTOM, 3, 1);
+#endif
     }
 
     switch_cb (GTK_SWITCH (sw), enabled, global);
@@ -761,20 +2229,6 @@ monitor_create_options(XfcePanelPlugin *plugin, t_global_monitor *global)
     SystemloadConfig *config = global->config;
     GtkWidget *label, *entry, *button, *box;
 
-    static const gchar *FRAME_TEXT[] = {
-            N_ ("CPU monitor"),
-            N_ ("Memory monitor"),
-            N_ ("Network monitor"),
-            N_ ("Swap monitor"),
-            N_ ("Uptime monitor")
-    };
-    static const gchar *SETTING_TEXT[] = {
-            "cpu",
-            "memory",
-            "network",
-            "swap"
-    };
-
     xfce_panel_plugin_block_menu (plugin);
 
     GtkWidget *dlg;
@@ -852,19 +2306,121 @@ monitor_create_options(XfcePanelPlugin *plugin, t_global_monitor *global)
     gtk_grid_attach (GTK_GRID (grid), entry, 1, 3, 1, 1);
     label = new_label (GTK_GRID (grid), 3, _("System monitor:"), entry);
 
+    /* Metrics socket */
+    entry = gtk_entry_new ();
+    gtk_widget_set_hexpand (entry, TRUE);
+    gtk_widget_set_tooltip_text(GTK_WIDGET(entry), _("Serve the current values in OpenMetrics format on this Unix socket. "
+                                                     "Relative paths are created in the user's runtime directory. "
+                                                     "Leave empty to disable."));
+    g_object_bind_property (G_OBJECT (config), "metrics-socket",
+                            G_OBJECT (entry), "text",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_grid_attach (GTK_GRID (grid), entry, 1, 4, 1, 1);
+    new_label (GTK_GRID (grid), 4, _("Metrics socket:"), entry);
+
+    /* History */
+    button = gtk_switch_new ();
+    gtk_widget_set_halign (button, GTK_ALIGN_START);
+    gtk_widget_set_tooltip_text(GTK_WIDGET(button), _("Keep a record of recent values on disk, so that they are available after a restart"));
+    g_object_bind_property (G_OBJECT (config), "history-enabled",
+                            G_OBJECT (button), "active",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_grid_attach (GTK_GRID (grid), button, 1, 5, 1, 1);
+    new_label (GTK_GRID (grid), 5, _("Keep history:"), button);
+
+    /* Statistics window */
+    button = gtk_spin_button_new_with_range (10, 3600, 10);
+    gtk_widget_set_halign (button, GTK_ALIGN_START);
+    gtk_widget_set_tooltip_text(GTK_WIDGET(button), _("Time span of the minimum, maximum and percentile shown in the tooltips"));
+    g_object_bind_property (G_OBJECT (config), "statistics-window",
+                            G_OBJECT (button), "value",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+    label = gtk_label_new ("s");
+    gtk_box_pack_start (GTK_BOX (box), button, FALSE, TRUE, 0);
+    gtk_box_pack_start (GTK_BOX (box), label, FALSE, FALSE, 0);
+    gtk_grid_attach (GTK_GRID (grid), box, 1, 6, 1, 1);
+    new_label (GTK_GRID (grid), 6, _("Statistics window:"), button);
+
+    /* Half-life of the average */
+    button = gtk_spin_button_new_with_range (1, 600, 1);
+    gtk_widget_set_halign (button, GTK_ALIGN_START);
+    gtk_widget_set_tooltip_text(GTK_WIDGET(button), _("Time after which the weight of a value in the average is halved"));
+    g_object_bind_property (G_OBJECT (config), "statistics-half-life",
+                            G_OBJECT (button), "value",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+    label = gtk_label_new ("s");
+    gtk_box_pack_start (GTK_BOX (box), button, FALSE, TRUE, 0);
+    gtk_box_pack_start (GTK_BOX (box), label, FALSE, FALSE, 0);
+    gtk_grid_attach (GTK_GRID (grid), box, 1, 7, 1, 1);
+    new_label (GTK_GRID (grid), 7, _("Average half-life:"), button);
+
+    /* Alert command */
+    entry = gtk_entry_new ();
+    gtk_widget_set_hexpand (entry, TRUE);
+    gtk_widget_set_tooltip_text(GTK_WIDGET(entry), _("Run when a monitor goes above its alert threshold. "
+                                                     "%m is replaced by the name of the monitor and %v by its value. "
+                                                     "Leave empty to only highlight the bar."));
+    g_object_bind_property (G_OBJECT (config), "alert-command",
+                            G_OBJECT (entry), "text",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_grid_attach (GTK_GRID (grid), entry, 1, 8, 1, 1);
+    new_label (GTK_GRID (grid), 8, _("Alert command:"), entry);
+
+    /* High-resolution sampling of the monitors which show their peak */
+    button = gtk_spin_button_new_with_range (MIN_PEAK_INTERVAL, MAX_PEAK_INTERVAL, 10);
+    gtk_widget_set_tooltip_text(GTK_WIDGET(button), _("How often the monitors showing their peak are sampled between the updates"));
+    g_object_bind_property (G_OBJECT (config), "peak-interval",
+                            G_OBJECT (button), "value",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+    gtk_box_pack_start (GTK_BOX (box), button, FALSE, TRUE, 0);
+    gtk_box_pack_start (GTK_BOX (box), gtk_label_new (_("ms, using at most")), FALSE, FALSE, 0);
+    GtkWidget *budget = gtk_spin_button_new_with_range (1, 25, 1);
+    gtk_widget_set_tooltip_text(GTK_WIDGET(budget), _("When the sampling takes more CPU time, it slows down"));
+    g_object_bind_property (G_OBJECT (config), "peak-budget",
+                            G_OBJECT (budget), "value",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_box_pack_start (GTK_BOX (box), budget, FALSE, TRUE, 0);
+    gtk_box_pack_start (GTK_BOX (box), gtk_label_new (_("% of a CPU")), FALSE, FALSE, 0);
+    gtk_grid_attach (GTK_GRID (grid), box, 1, 9, 1, 1);
+    new_label (GTK_GRID (grid), 9, _("Peak sampling:"), button);
+
+    /* Cost of the plugin itself */
+    box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+    button = gtk_check_button_new_with_mnemonic (_("Show in the _tooltips"));
+    gtk_widget_set_tooltip_text(GTK_WIDGET(button), _("CPU time, wakeups and memory of the plugin process"));
+    g_object_bind_property (G_OBJECT (config), "self-metrics",
+                            G_OBJECT (button), "active",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_box_pack_start (GTK_BOX (box), button, FALSE, FALSE, 0);
+    gtk_box_pack_start (GTK_BOX (box), gtk_label_new (_("warn above")), FALSE, FALSE, 0);
+    GtkWidget *self_budget = gtk_spin_button_new_with_range (0, 100, 1);
+    gtk_widget_set_tooltip_text(GTK_WIDGET(self_budget), _("Log a warning when the plugin uses more CPU time over "
+                                                           "the statistics window. Set to zero to disable the check"));
+    g_object_bind_property (G_OBJECT (config), "self-budget",
+                            G_OBJECT (self_budget), "value",
+                            GBindingFlags (G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL));
+    gtk_box_pack_start (GTK_BOX (box), self_budget, FALSE, TRUE, 0);
+    gtk_box_pack_start (GTK_BOX (box), gtk_label_new (_("% of a CPU")), FALSE, FALSE, 0);
+    gtk_grid_attach (GTK_GRID (grid), box, 1, 10, 1, 1);
+    new_label (GTK_GRID (grid), 10, _("Plugin overhead:"), button);
+
     /* Add options for the monitors */
-    for(gsize i = 0; i < G_N_ELEMENTS (global->monitor); i++)
+    for(guint i = 0; i < systemload_registry_get_n_monitors (); i++)
     {
-        const SystemloadMonitor monitor = VISUAL_ORDER[i];
-        new_monitor_setting (global, GTK_GRID(grid), 4 + 2 * i,
-                             _(FRAME_TEXT[monitor]),
+        const SystemloadMonitorInfo *info = systemload_registry_get_nth (i);
+        new_monitor_setting (global, GTK_GRID(grid), 11 + 2 * i,
+                             _(info->title),
                              true,
-                             SETTING_TEXT[monitor]);
+                             info->name,
+                             SOURCES[info->id].add_settings);
     }
 
     /* Uptime monitor options */
-    new_monitor_setting (global, GTK_GRID(grid), 4 + 2*G_N_ELEMENTS (global->monitor),
-                         _(FRAME_TEXT[4]), FALSE, "uptime");
+    new_monitor_setting (global, GTK_GRID(grid), 11 + 2 * systemload_registry_get_n_monitors (),
+                         _("Uptime monitor"), FALSE, "uptime", NULL);
 
     gtk_widget_show_all (dlg);
 }
@@ -910,16 +2466,6 @@ systemload_construct (XfcePanelPlugin *plugin)
 
     update_monitors (global);
 
-#ifdef HAVE_UPOWER_GLIB
-    if (global->upower) {
-#if UP_CHECK_VERSION(0, 99, 0)
-        g_signal_connect (global->upower, "notify", G_CALLBACK(upower_changed_cb), global);
-#else /* UP_CHECK_VERSION < 0.99 */
-        g_signal_connect (global->upower, "changed", G_CALLBACK(upower_changed_cb), global);
-#endif /* UP_CHECK_VERSION */
-    }
-#endif /* HAVE_UPOWER_GLIB */
-
     g_signal_connect (plugin, "free-data", G_CALLBACK (monitor_free), global);
     g_signal_connect (plugin, "size-changed", G_CALLBACK (monitor_set_size), global);
     g_signal_connect (plugin, "mode-changed", G_CALLBACK (monitor_set_mode), global);
@@ -0,0 +1,398 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+
+#include <glib.h>
+
+#include "tcpstat.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+
+#include "procfile.h"
+#include "procparse.h"
+
+#define PROC_NET_SNMP     "/proc/net/snmp"
+#define PROC_NET_NETSTAT  "/proc/net/netstat"
+#define PROC_NET_SOCKSTAT "/proc/net/sockstat"
+
+/* Size of the receive buffer of the sock_diag dump, the kernel fills it with as many records as fit */
+#define DIAG_BUFFER_SIZE (32 * 1024)
+
+/* The counters, each read from a column of the "Tcp:" line of snmp or the "TcpExt:" line of netstat */
+enum { COUNTER_OUT_SEGS, COUNTER_RETRANS_SEGS, COUNTER_LISTEN_OVERFLOWS, COUNTER_TIMEOUTS, N_COUNTERS };
+
+struct t_counter_source {
+    const gchar *prefix;
+    const gchar *name;
+};
+
+/* Indexed by the counters */
+static const t_counter_source COUNTERS[] = {
+    { "Tcp:",    "OutSegs" },
+    { "Tcp:",    "RetransSegs" },
+    { "TcpExt:", "ListenOverflows" },
+    { "TcpExt:", "TCPTimeouts" },
+};
+G_STATIC_ASSERT (G_N_ELEMENTS (COUNTERS) == N_COUNTERS);
+
+/*
+ * Each of the files has a pair of lines per protocol: a header naming the columns,
+ * then the values. The columns are looked up in the header once.
+ */
+struct t_table_file {
+    SystemloadProcFile *file;
+    bool      indexed;
+    guint     n_values;  /* Values to parse, up to the last column which is read */
+    guint64  *values;
+};
+
+struct SystemloadTcpSampler {
+    t_table_file snmp, netstat;
+    gint      column[N_COUNTERS];  /* Column of the counter, -1 if the kernel does not have it */
+    guint64   counters[N_COUNTERS];
+    guint     found;               /* Bit mask of the counters which were read in the previous reading */
+    gint64    time;                /* Of the previous reading, 0 before the first one */
+    SystemloadProcFile *sockstat;
+    gulong    page_size;
+    gint      diag_fd;
+    bool      diag_failed;
+    guint32   diag_seq;
+    gchar    *diag_buf;
+};
+
+SystemloadTcpSampler *
+systemload_tcp_sampler_new (void)
+{
+    SystemloadTcpSampler *sampler = g_new0 (SystemloadTcpSampler, 1);
+    sampler->diag_fd = -1;
+    sampler->page_size = sysconf (_SC_PAGESIZE);
+    return sampler;
+}
+
+void
+systemload_tcp_sampler_free (SystemloadTcpSampler *sampler)
+{
+    if (!sampler)
+        return;
+    t_table_file *tables[] = { &sampler->snmp, &sampler->netstat };
+    for (t_table_file *table : tables)
+    {
+        if (table->file)
+            systemload_procfile_close (table->file);
+        g_free (table->values);
+    }
+    if (sampler->sockstat)
+        systemload_procfile_close (sampler->sockstat);
+    if (sampler->diag_fd >= 0)
+        close (sampler->diag_fd);
+    g_free (sampler->diag_buf);
+    g_free (sampler);
+}
+
+/* Returns the n-th line, counting from 0, which starts with the prefix, or NULL */
+static const gchar *
+find_prefixed_line (const gchar *buf, const gchar *prefix, guint n)
+{
+    const gsize len = strlen (prefix);
+
+    for (const gchar *line = buf; *line; )
+    {
+        if (strncmp (line, prefix, len) == 0 && n-- == 0)
+            return line;
+        line = systemload_find_eol (line);
+        if (*line == '\n')
+            line++;
+    }
+    return NULL;
+}
+
+/* Finds the columns of the counters of the file in its header lines */
+static void
+table_index (SystemloadTcpSampler *sampler, t_table_file *table, const gchar *buf, const gchar *path)
+{
+    guint n_values = 0;
+
+    for (guint i = 0; i < N_COUNTERS; i++)
+    {
+        if ((strcmp (COUNTERS[i].prefix, "Tcp:") == 0) != (table == &sampler->snmp))
+            continue;
+
+        sampler->column[i] = -1;
+        const gchar *header = find_prefixed_line (buf, COUNTERS[i].prefix, 0);
+        if (!header)
+            continue;
+
+        const gchar *eol = systemload_find_eol (header);
+        const gsize len = strlen (COUNTERS[i].name);
+        gint column = 0;
+        for (const gchar *s = header + strlen (COUNTERS[i].prefix); s < eol; column++)
+        {
+            while (*s == ' ')
+                s++;
+            const gchar *end = s;
+            while (end < eol && *end != ' ')
+                end++;
+            if ((gsize) (end - s) == len && strncmp (s, COUNTERS[i].name, len) == 0)
+            {
+                sampler->column[i] = column;
+                n_values = MAX (n_values, (guint) column + 1);
+                break;
+            }
+            s = end;
+        }
+        if (sampler->column[i] < 0)
+            g_warning ("%s has no %s counter", path, COUNTERS[i].name);
+    }
+
+    table->n_values = n_values;
+    table->values = g_renew (guint64, table->values, MAX (n_values, 1));
+    table->indexed = true;
+}
+
+/*
+ * Reads the counters of one of the files into counters[] and sets their bits in found,
+ * returns false if the file cannot be read
+ */
+static bool
+table_read (SystemloadTcpSampler *sampler, t_table_file *table, const gchar *path, guint64 counters[N_COUNTERS], guint *found)
+{
+    if (!table->file && (table->file = systemload_procfile_open (path)) == NULL)
+        return false;
+    const gchar *buf = systemload_procfile_read (table->file, NULL);
+    if (!buf)
+        return false;
+
+    if (!table->indexed)
+        table_index (sampler, table, buf, path);
+
+    const gchar *prefix = (table == &sampler->snmp) ? "Tcp:" : "TcpExt:";
+    const gchar *line = find_prefixed_line (buf, prefix, 1);
+    if (!line)
+        return table->n_values == 0;
+
+    /* MaxConn of snmp is -1: the '-' separates like a space, so the columns stay aligned */
+    const guint n = systemload_parse_uints (line + strlen (prefix), table->values, table->n_values, NULL);
+    for (guint i = 0; i < N_COUNTERS; i++)
+        if (strcmp (COUNTERS[i].prefix, prefix) == 0 && sampler->column[i] >= 0 && (guint) sampler->column[i] < n)
+        {
+            counters[i] = table->values[sampler->column[i]];
+            *found |= 1u << i;
+        }
+    return true;
+}
+
+/* "TCP: inuse 10 orphan 0 tw 5 alloc 12 mem 3", the memory is in pages */
+static void
+read_sockstat (SystemloadTcpSampler *sampler, SystemloadTcpStat *tcp)
+{
+    if (!sampler->sockstat && (sampler->sockstat = systemload_procfile_open (PROC_NET_SOCKSTAT)) == NULL)
+        return;
+    const gchar *buf = systemload_procfile_read (sampler->sockstat, NULL);
+    const gchar *line = buf ? find_prefixed_line (buf, "TCP:", 0) : NULL;
+    if (!line)
+        return;
+
+    guint64 fields[5];
+    if (systemload_parse_uints (line, fields, G_N_ELEMENTS (fields), NULL) == G_N_ELEMENTS (fields))
+    {
+        tcp->sockets = fields[0];
+        tcp->orphans = fields[1];
+        tcp->memory = fields[4] * sampler->page_size;
+    }
+}
+
+static gint
+diag_state (guint8 state)
+{
+    switch (state)
+    {
+        case TCP_ESTABLISHED: return TCP_STATE_ESTABLISHED;
+        case TCP_SYN_SENT:    return TCP_STATE_SYN_SENT;
+        case TCP_SYN_RECV:    return TCP_STATE_SYN_RECV;
+        case TCP_FIN_WAIT1:
+        case TCP_FIN_WAIT2:
+        case TCP_CLOSING:     return TCP_STATE_FIN_WAIT;
+        case TCP_TIME_WAIT:   return TCP_STATE_TIME_WAIT;
+        case TCP_CLOSE_WAIT:
+        case TCP_LAST_ACK:    return TCP_STATE_CLOSE_WAIT;
+        case TCP_LISTEN:      return TCP_STATE_LISTEN;
+        default:              return -1;
+    }
+}
+
+/* Counts the sockets of one address family, returns false if the dump failed */
+static bool
+diag_dump (SystemloadTcpSampler *sampler, guint8 family, guint states[N_TCP_STATES])
+{
+    struct {
+        struct nlmsghdr nlh;
+        struct inet_diag_req_v2 req;
+    } request;
+    memset (&request, 0, sizeof (request));
+    request.nlh.nlmsg_len = sizeof (request);
+    request.nlh.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    request.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.nlh.nlmsg_seq = ++sampler->diag_seq;
+    request.req.sdiag_family = family;
+    request.req.sdiag_protocol = IPPROTO_TCP;
+    request.req.idiag_states = ~0U;
+
+    struct sockaddr_nl addr;
+    memset (&addr, 0, sizeof (addr));
+    addr.nl_family = AF_NETLINK;
+    if (sendto (sampler->diag_fd, &request, sizeof (request), 0, (struct sockaddr*) &addr, sizeof (addr)) < 0)
+        return false;
+
+    for (;;)
+    {
+        ssize_t n = recv (sampler->diag_fd, sampler->diag_buf, DIAG_BUFFER_SIZE, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+
+        for (auto nlh = (struct nlmsghdr*) sampler->diag_buf; NLMSG_OK (nlh, n); nlh = NLMSG_NEXT (nlh, n))
+        {
+            if (nlh->nlmsg_seq != sampler->diag_seq)
+                continue;
+            if (nlh->nlmsg_type == NLMSG_DONE)
+                return true;
+            if (nlh->nlmsg_type == NLMSG_ERROR)
+                /* Also the answer for IPv6 on a kernel without it */
+                return family == AF_INET6;
+            if (nlh->nlmsg_type == SOCK_DIAG_BY_FAMILY)
+            {
+                auto msg = (const struct inet_diag_msg*) NLMSG_DATA (nlh);
+                gint state = diag_state (msg->idiag_state);
+                if (state >= 0)
+                    states[state]++;
+            }
+        }
+    }
+}
+
+static bool
+read_tcp_states (SystemloadTcpSampler *sampler, guint states[N_TCP_STATES])
+{
+    if (sampler->diag_fd < 0)
+    {
+        if (sampler->diag_failed)
+            return false;
+        sampler->diag_fd = socket (AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+        if (sampler->diag_fd < 0)
+        {
+            g_warning ("Cannot open a sock_diag socket: %s", g_strerror (errno));
+            sampler->diag_failed = true;
+            return false;
+        }
+        sampler->diag_buf = (gchar*) g_malloc (DIAG_BUFFER_SIZE);
+    }
+
+    if (diag_dump (sampler, AF_INET, states) && diag_dump (sampler, AF_INET6, states))
+        return true;
+
+    /* Drop what is left of an interrupted dump */
+    close (sampler->diag_fd);
+    sampler->diag_fd = -1;
+    memset (states, 0, N_TCP_STATES * sizeof (*states));
+    return false;
+}
+
+gint
+read_tcpstat (SystemloadTcpSampler *sampler, SystemloadTcpStat *tcp)
+{
+    memset (tcp, 0, sizeof (*tcp));
+
+    guint64 counters[N_COUNTERS] = { 0 };
+    guint found = 0;
+    if (!table_read (sampler, &sampler->snmp, PROC_NET_SNMP, counters, &found))
+        return -1;
+    /* Without netstat, the overflows and timeouts have no rate */
+    table_read (sampler, &sampler->netstat, PROC_NET_NETSTAT, counters, &found);
+
+    const gint64 time = systemload_procfile_get_time ();
+    if (sampler->time != 0 && time > sampler->time)
+    {
+        const gdouble seconds = (time - sampler->time) / 1e6;
+        gdouble rate[N_COUNTERS];
+        for (guint i = 0; i < N_COUNTERS; i++)
+        {
+            /* A counter which could not be read is missing, not 0 */
+            const bool compared = (found & sampler->found & (1u << i)) != 0;
+            rate[i] = (compared && counters[i] >= sampler->counters[i]) ? (counters[i] - sampler->counters[i]) / seconds : 0;
+        }
+        tcp->out_segments = rate[COUNTER_OUT_SEGS];
+        tcp->retransmits = rate[COUNTER_RETRANS_SEGS];
+        tcp->listen_overflows = rate[COUNTER_LISTEN_OVERFLOWS];
+        tcp->timeouts = rate[COUNTER_TIMEOUTS];
+    }
+    memcpy (sampler->counters, counters, sizeof (counters));
+    sampler->found = found;
+    sampler->time = time;
+
+    read_sockstat (sampler, tcp);
+    tcp->states_valid = read_tcp_states (sampler, tcp->states);
+
+    return 0;
+}
+
+#else
+
+SystemloadTcpSampler *
+systemload_tcp_sampler_new (void)
+{
+    return NULL;
+}
+
+void
+systemload_tcp_sampler_free (SystemloadTcpSampler *sampler)
+{
+}
+
+gint
+read_tcpstat (SystemloadTcpSampler *sampler, SystemloadTcpStat *tcp)
+{
+    memset (tcp, 0, sizeof (*tcp));
+    return -1;
+}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_TCPSTAT_H_
+#define _XFCE_SYSTEMLOAD_TCPSTAT_H_
+
+#include <glib.h>
+
+/* Full scale of the bar of the TCP monitor: the share of the sent segments which were retransmissions */
+#define MAX_RETRANSMIT_PERCENT 5
+
+/* Connection states, the kernel states which are rarely seen for long are folded into their neighbours */
+enum SystemloadTcpState {
+    TCP_STATE_ESTABLISHED,
+    TCP_STATE_SYN_SENT,
+    TCP_STATE_SYN_RECV,
+    TCP_STATE_FIN_WAIT,    /* FIN_WAIT1, FIN_WAIT2 and CLOSING */
+    TCP_STATE_TIME_WAIT,
+    TCP_STATE_CLOSE_WAIT,  /* CLOSE_WAIT and LAST_ACK */
+    TCP_STATE_LISTEN,
+    N_TCP_STATES,
+};
+
+/*
+ * Rates are per second since the previous reading, and 0 for the first one and for a counter
+ * which could not be read in this or the previous reading
+ */
+struct SystemloadTcpStat {
+    gdouble  out_segments;
+    gdouble  retransmits;       /* Retransmitted segments */
+    gdouble  listen_overflows;  /* Connections dropped because the accept queue of a listener was full */
+    gdouble  timeouts;          /* Retransmission timeouts */
+    guint    sockets;           /* In use */
+    guint    orphans;           /* Closed by their process, still sending */
+    guint64  memory;            /* Bytes of the socket buffers */
+    bool     states_valid;      /* The connections could be counted with sock_diag */
+    guint    states[N_TCP_STATES];  /* IPv4 and IPv6 connections by state */
+};
+
+/* The column indexes and previous counters of one consumer of read_tcpstat() */
+struct SystemloadTcpSampler;
+
+SystemloadTcpSampler *systemload_tcp_sampler_new  (void);
+void                  systemload_tcp_sampler_free (SystemloadTcpSampler *sampler);
+
+/*
+ * The counters come from /proc/net/snmp, /proc/net/netstat and /proc/net/sockstat. The connections
+ * are counted from a NETLINK_SOCK_DIAG dump, which only transfers a fixed-size record per socket,
+ * instead of parsing /proc/net/tcp; unlike the files, the dump is not recorded or replayed.
+ * Returns -1 if the counters cannot be read, which is always the case on platforms other than Linux.
+ */
+gint read_tcpstat (SystemloadTcpSampler *sampler, SystemloadTcpStat *tcp);
+
+#endif /* _XFCE_SYSTEMLOAD_TCPSTAT_H_ */
@@ -0,0 +1,50 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_TOPLIST_H_
+#define _XFCE_SYSTEMLOAD_TOPLIST_H_
+
+#include <glib.h>
+
+/*
+ * Insertion into the short lists of the busiest entries which the samplers fill in a single pass.
+ *
+ * top is an array of max_n structs which is sorted by descending field, n the number of entries
+ * in it. position is set to the index at which an entry with the given value belongs, after the
+ * entries behind it were moved down and the last one dropped if the list was full, or to max_n
+ * if the entry does not belong in the list. The caller then fills in top[position].
+ */
+#define SYSTEMLOAD_TOP_INSERT_POSITION(top, n, max_n, field, value, position) \
+    G_STMT_START { \
+        position = ((n) < (max_n)) ? (n)++ : (max_n); \
+        for (; position > 0 && (top)[position - 1].field < (value); position--) \
+            if (position < (max_n)) \
+                (top)[position] = (top)[position - 1]; \
+    } G_STMT_END
+
+#endif /* _XFCE_SYSTEMLOAD_TOPLIST_H_ */
@@ -0,0 +1,160 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdlib.h>
+
+#include <glib.h>
+
+#include "topology.h"
+
+bool
+systemload_cpulist_apply (const gchar *list, gint *array, guint n, gint value)
+{
+    const gchar *s = list;
+
+    while (*s && *s != '\n')
+    {
+        gchar *end;
+        gulong first = strtoul (s, &end, 10), last;
+        if (end == s)
+            return false;
+        s = end;
+
+        if (*s == '-')
+        {
+            s++;
+            last = strtoul (s, &end, 10);
+            if (end == s || last < first)
+                return false;
+            s = end;
+        }
+        else
+        {
+            last = first;
+        }
+
+        for (gulong cpu = first; cpu <= last && cpu < n; cpu++)
+            array[cpu] = value;
+
+        if (*s == ',')
+            s++;
+        else if (*s && *s != '\n')
+            return false;
+    }
+
+    return true;
+}
+
+#ifdef __linux__
+
+#define SYSFS_CPU "/sys/devices/system/cpu"
+#define SYSFS_NODE "/sys/devices/system/node"
+
+static void
+read_packages (SystemloadCpuTopology *topology)
+{
+    for (guint cpu = 0; cpu < topology->n_cpus; cpu++)
+    {
+        gchar *path = g_strdup_printf (SYSFS_CPU "/cpu%u/topology/physical_package_id", cpu);
+        gchar *contents;
+        if (g_file_get_contents (path, &contents, NULL, NULL))
+        {
+            topology->package[cpu] = atoi (contents);
+            g_free (contents);
+        }
+        g_free (path);
+    }
+}
+
+static void
+read_nodes (SystemloadCpuTopology *topology)
+{
+    GDir *dir = g_dir_open (SYSFS_NODE, 0, NULL);
+    if (!dir)
+        return;
+
+    const gchar *name;
+    while ((name = g_dir_read_name (dir)) != NULL)
+    {
+        guint64 node;
+        if (!g_str_has_prefix (name, "node") ||
+            !g_ascii_string_to_unsigned (name + 4, 10, 0, G_MAXINT, &node, NULL))
+            continue;
+
+        gchar *path = g_strdup_printf (SYSFS_NODE "/%s/cpulist", name);
+        gchar *contents;
+        if (g_file_get_contents (path, &contents, NULL, NULL))
+        {
+            if (!systemload_cpulist_apply (contents, topology->node, topology->n_cpus, node))
+                g_warning ("Cannot parse '%s'", path);
+            g_free (contents);
+        }
+        g_free (path);
+    }
+
+    g_dir_close (dir);
+}
+
+#endif
+
+SystemloadCpuTopology *
+systemload_cpu_topology_read (guint n_cpus)
+{
+    SystemloadCpuTopology *topology = g_new0 (SystemloadCpuTopology, 1);
+
+    topology->n_cpus = n_cpus;
+    topology->node = g_new (gint, MAX (n_cpus, 1));
+    topology->package = g_new (gint, MAX (n_cpus, 1));
+    for (guint cpu = 0; cpu < n_cpus; cpu++)
+    {
+        topology->node[cpu] = -1;
+        topology->package[cpu] = -1;
+    }
+
+#ifdef __linux__
+    read_packages (topology);
+    read_nodes (topology);
+#endif
+
+    return topology;
+}
+
+void
+systemload_cpu_topology_free (SystemloadCpuTopology *topology)
+{
+    if (topology == NULL)
+        return;
+
+    g_free (topology->node);
+    g_free (topology->package);
+    g_free (topology);
+}
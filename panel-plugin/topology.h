@@ -0,0 +1,55 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_TOPOLOGY_H_
+#define _XFCE_SYSTEMLOAD_TOPOLOGY_H_
+
+#include <glib.h>
+
+/* The NUMA node and the physical package (socket) of every CPU, read once from sysfs */
+struct SystemloadCpuTopology {
+    guint  n_cpus;
+    gint  *node;     /* -1 if unknown */
+    gint  *package;  /* -1 if unknown */
+};
+
+/* On platforms other than Linux, every CPU is reported as unknown */
+SystemloadCpuTopology *systemload_cpu_topology_read (guint                  n_cpus);
+void                   systemload_cpu_topology_free (SystemloadCpuTopology *topology);
+
+/*
+ * Parses a list of CPUs in the sysfs format, for example "0-3,8,10-11",
+ * and sets array[cpu] to value for each CPU which is smaller than n.
+ * Returns false if the list is malformed.
+ */
+bool                   systemload_cpulist_apply     (const gchar           *list,
+                                                     gint                  *array,
+                                                     guint                  n,
+                                                     gint                   value);
+
+#endif /* _XFCE_SYSTEMLOAD_TOPOLOGY_H_ */
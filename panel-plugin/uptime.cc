@@ -33,6 +33,8 @@
 
 #include "uptime.h"
 
+#include <time.h>
+
 #if defined(__linux__) || defined(__FreeBSD_kernel__)
 
 #include <fcntl.h>
@@ -40,22 +42,26 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "procfile.h"
 
 #define PROC_UPTIME "/proc/uptime"
 
+static SystemloadProcFile *proc_uptime;
+
 gulong read_uptime()
 {
-    FILE *fd = fopen(PROC_UPTIME, "r");
-    if (!fd) {
+    if (!proc_uptime)
+        proc_uptime = systemload_procfile_open(PROC_UPTIME);
+    const gchar *buf = proc_uptime ? systemload_procfile_read(proc_uptime, NULL) : NULL;
+    if (!buf) {
         g_warning("%s", _("File /proc/uptime not found!"));
         return 0;
     }
 
     gulong uptime;
-    if (!fscanf(fd, "%lu", &uptime))
+    if (sscanf(buf, "%lu", &uptime) != 1)
        uptime = 0;
 
-    fclose(fd);
     return uptime;
 }
 
@@ -138,3 +144,23 @@ gulong read_uptime()
 #else
 #error "Your platform is not yet supported"
 #endif
+
+#ifdef CLOCK_BOOTTIME
+
+gulong read_uptime_clock()
+{
+    /* Served from the vDSO, this does not enter the kernel */
+    struct timespec ts;
+    if (clock_gettime(CLOCK_BOOTTIME, &ts) != 0)
+        return read_uptime();
+    return ts.tv_sec;
+}
+
+#else
+
+gulong read_uptime_clock()
+{
+    return read_uptime();
+}
+
+#endif
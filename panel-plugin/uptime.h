@@ -33,4 +33,7 @@
 
 gulong read_uptime();
 
+/* Uses clock_gettime() where the boot time clock is available, read_uptime() elsewhere */
+gulong read_uptime_clock();
+
 #endif /* _XFCE_SYSTEMLOAD_UPTIME_H_ */
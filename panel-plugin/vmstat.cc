@@ -0,0 +1,188 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+
+#include "procfile.h"
+#include "procparse.h"
+#include "vmstat.h"
+
+#define PROC_VMSTAT "/proc/vmstat"
+
+/* Indexed by SystemloadVmstatCounter */
+static const gchar *const VMSTAT_KEYS[] = {
+    "pswpin",
+    "pswpout",
+    "pgmajfault",
+    "pgscan_kswapd",
+    "pgscan_direct",
+    "pgsteal_kswapd",
+    "pgsteal_direct",
+    "oom_kill",
+};
+G_STATIC_ASSERT (G_N_ELEMENTS (VMSTAT_KEYS) == N_VMSTAT_COUNTERS);
+
+/* oom_kill was added in Linux 4.13, the other counters are required */
+#define VMSTAT_OPTIONAL (1u << VMSTAT_OOM_KILL)
+
+struct SystemloadVmstatSampler {
+    SystemloadProcFile *proc_vmstat;
+    bool     indexed;
+    bool     complete;                  /* All the required counters are in the index */
+    guint    order[N_VMSTAT_COUNTERS];  /* The counters which were found, by their line */
+    guint    line[N_VMSTAT_COUNTERS];   /* Line of the counter in /proc/vmstat */
+    guint    n_found;
+    guint64  counters[N_VMSTAT_COUNTERS];
+    gint64   time;                      /* Of the previous reading, 0 before the first one */
+    gulong   page_size;
+};
+
+SystemloadVmstatSampler *
+systemload_vmstat_sampler_new (void)
+{
+    SystemloadVmstatSampler *sampler = g_new0 (SystemloadVmstatSampler, 1);
+    sampler->page_size = sysconf (_SC_PAGESIZE);
+    return sampler;
+}
+
+void
+systemload_vmstat_sampler_free (SystemloadVmstatSampler *sampler)
+{
+    if (!sampler)
+        return;
+    if (sampler->proc_vmstat)
+        systemload_procfile_close (sampler->proc_vmstat);
+    g_free (sampler);
+}
+
+/* Whether the line is "<key> <value>" */
+static bool
+match_key (const gchar *line, const gchar *key)
+{
+    const gsize len = strlen (key);
+    return strncmp (line, key, len) == 0 && line[len] == ' ';
+}
+
+static void
+build_index (SystemloadVmstatSampler *sampler, const gchar *buf)
+{
+    guint n = 0, found = 0;
+
+    sampler->n_found = 0;
+    for (const gchar *s = buf; *s; n++)
+    {
+        for (guint i = 0; i < N_VMSTAT_COUNTERS; i++)
+        {
+            if (match_key (s, VMSTAT_KEYS[i]))
+            {
+                sampler->line[i] = n;
+                sampler->order[sampler->n_found++] = i;
+                found |= 1u << i;
+                break;
+            }
+        }
+        s = systemload_find_eol (s);
+        if (*s == '\n')
+            s++;
+    }
+    sampler->indexed = true;
+
+    const guint required = ((1u << N_VMSTAT_COUNTERS) - 1) & ~VMSTAT_OPTIONAL;
+    sampler->complete = (found & required) == required;
+    if (!sampler->complete)
+        g_warning ("'%s' lacks some of the paging counters", PROC_VMSTAT);
+}
+
+gint
+read_vmstat (SystemloadVmstatSampler *sampler, SystemloadVmstat *vmstat)
+{
+    memset (vmstat, 0, sizeof (*vmstat));
+    vmstat->page_size = sampler->page_size;
+
+    if (!sampler->proc_vmstat && (sampler->proc_vmstat = systemload_procfile_open (PROC_VMSTAT)) == NULL)
+        return -1;
+    const gchar *buf = systemload_procfile_read (sampler->proc_vmstat, NULL);
+    if (!buf || systemload_procfile_is_truncated (sampler->proc_vmstat))
+        return -1;
+
+    if (!sampler->indexed)
+        build_index (sampler, buf);
+    if (!sampler->complete)
+        return -1;
+
+    guint64 counters[N_VMSTAT_COUNTERS] = { 0 };
+    guint n = 0, next = 0;
+    for (const gchar *s = buf; *s && next < sampler->n_found; n++)
+    {
+        const guint i = sampler->order[next];
+        if (n == sampler->line[i])
+        {
+            /* Lines are only added by kernel updates, but do not trust the index blindly */
+            if (!match_key (s, VMSTAT_KEYS[i]))
+            {
+                sampler->indexed = false;
+                sampler->time = 0;
+                return -1;
+            }
+            systemload_parse_uints (s + strlen (VMSTAT_KEYS[i]), &counters[i], 1, NULL);
+            next++;
+        }
+        s = systemload_find_eol (s);
+        if (*s == '\n')
+            s++;
+    }
+
+    /* The file ended before the last indexed line */
+    if (next < sampler->n_found)
+    {
+        sampler->indexed = false;
+        sampler->time = 0;
+        return -1;
+    }
+
+    const gint64 time = systemload_procfile_get_time ();
+    if (sampler->time != 0 && time > sampler->time)
+    {
+        const gdouble seconds = (time - sampler->time) / 1e6;
+        for (guint i = 0; i < N_VMSTAT_COUNTERS; i++)
+            if (counters[i] >= sampler->counters[i])
+                vmstat->rate[i] = (counters[i] - sampler->counters[i]) / seconds;
+    }
+    vmstat->oom_kills = counters[VMSTAT_OOM_KILL];
+
+    memcpy (sampler->counters, counters, sizeof (counters));
+    sampler->time = time;
+    return 0;
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_VMSTAT_H_
+#define _XFCE_SYSTEMLOAD_VMSTAT_H_
+
+#include <glib.h>
+
+/* Full scale of the bar of the paging monitor: swap-in plus swap-out, in bytes per second */
+#define MAX_SWAP_IO_BYTES (50 * 1024 * 1024)
+
+/* The counters of /proc/vmstat which are read */
+enum SystemloadVmstatCounter {
+    VMSTAT_PSWPIN,          /* Pages */
+    VMSTAT_PSWPOUT,         /* Pages */
+    VMSTAT_PGMAJFAULT,
+    VMSTAT_PGSCAN_KSWAPD,   /* Pages scanned for reclaim by kswapd */
+    VMSTAT_PGSCAN_DIRECT,   /* Pages scanned by allocations which had to reclaim themselves */
+    VMSTAT_PGSTEAL_KSWAPD,  /* Pages reclaimed */
+    VMSTAT_PGSTEAL_DIRECT,
+    VMSTAT_OOM_KILL,
+    N_VMSTAT_COUNTERS,
+};
+
+struct SystemloadVmstat {
+    gdouble  rate[N_VMSTAT_COUNTERS];  /* Per second since the previous reading, 0 for the first one */
+    guint64  oom_kills;                /* Since boot */
+    gulong   page_size;                /* Bytes */
+};
+
+/* The field index and the previous counters of one consumer of read_vmstat() */
+struct SystemloadVmstatSampler;
+
+SystemloadVmstatSampler *systemload_vmstat_sampler_new  (void);
+void                     systemload_vmstat_sampler_free (SystemloadVmstatSampler *sampler);
+
+/*
+ * The lines of the counters are looked up once, after that a reading only parses those lines.
+ * Only oom_kill may be missing, it is then 0. Returns -1 if /proc/vmstat cannot be read, which is
+ * always the case on platforms other than Linux, if it is truncated or if it lacks any other counter.
+ */
+gint read_vmstat (SystemloadVmstatSampler *sampler, SystemloadVmstat *vmstat);
+
+#endif /* _XFCE_SYSTEMLOAD_VMSTAT_H_ */
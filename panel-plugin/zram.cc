@@ -0,0 +1,179 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+
+#include <glib.h>
+
+#include "memswap.h"
+#include "procfile.h"
+#include "procparse.h"
+#include "zram.h"
+
+/* The tests list their own directory */
+#ifndef SYSFS_BLOCK
+#define SYSFS_BLOCK  "/sys/block"
+#endif
+
+/* Look for added or removed zram devices this often */
+#define ZRAM_REFRESH_INTERVAL (60 * G_USEC_PER_SEC)
+
+struct SystemloadZramSampler {
+    GPtrArray *mm_stats;      /* SystemloadProcFile, the mm_stat of every zram device */
+    gint64     zram_time;     /* When /sys/block was last listed, 0 to list it on the next reading */
+};
+
+SystemloadZramSampler *
+systemload_zram_sampler_new (void)
+{
+    SystemloadZramSampler *sampler = g_new0 (SystemloadZramSampler, 1);
+    sampler->mm_stats = g_ptr_array_new_with_free_func ((GDestroyNotify) systemload_procfile_close);
+    return sampler;
+}
+
+void
+systemload_zram_sampler_free (SystemloadZramSampler *sampler)
+{
+    if (!sampler)
+        return;
+    g_ptr_array_unref (sampler->mm_stats);
+    g_free (sampler);
+}
+
+/* Keeps the open mm_stat of the zram devices which are still there, opens those of the new ones */
+static void
+update_zram_devices (SystemloadZramSampler *sampler)
+{
+    GHashTable *paths = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+    GDir *dir = g_dir_open (SYSFS_BLOCK, 0, NULL);
+    if (dir)
+    {
+        const gchar *name;
+        while ((name = g_dir_read_name (dir)) != NULL)
+            if (g_str_has_prefix (name, "zram"))
+                g_hash_table_add (paths, g_build_filename (SYSFS_BLOCK, name, "mm_stat", NULL));
+        g_dir_close (dir);
+    }
+
+    /* What is left in paths afterwards are the added devices */
+    for (guint i = 0; i < sampler->mm_stats->len; )
+    {
+        auto file = (SystemloadProcFile*) g_ptr_array_index (sampler->mm_stats, i);
+        if (g_hash_table_remove (paths, systemload_procfile_get_path (file)))
+            i++;
+        else
+            g_ptr_array_remove_index_fast (sampler->mm_stats, i);
+    }
+
+    GHashTableIter iter;
+    gpointer path;
+    g_hash_table_iter_init (&iter, paths);
+    while (g_hash_table_iter_next (&iter, &path, NULL))
+    {
+        SystemloadProcFile *file = systemload_procfile_open ((const gchar*) path);
+        if (file)
+            g_ptr_array_add (sampler->mm_stats, file);
+    }
+    g_hash_table_unref (paths);
+}
+
+/* Whether the line is "<key>  <value> kB", the value is stored in bytes */
+static bool
+parse_meminfo_line (const gchar *line, const gchar *key, gsize key_len, guint64 *bytes)
+{
+    guint64 kib;
+    if (strncmp (line, key, key_len) != 0 || systemload_parse_uints (line + key_len, &kib, 1, NULL) != 1)
+        return false;
+    *bytes = kib * 1024;
+    return true;
+}
+
+gint
+read_compressed_memory (SystemloadZramSampler *sampler, SystemloadMemSampler *mem_sampler,
+                        SystemloadCompressedMemory *compressed)
+{
+    memset (compressed, 0, sizeof (*compressed));
+
+    const gchar *buf = read_meminfo (mem_sampler);
+    if (!buf)
+        return -1;
+
+    /* Zswapped follows Zswap, the lines after it are not needed */
+    bool zswapped = false;
+    for (const gchar *line = buf; *line && !zswapped; )
+    {
+        switch (line[0])
+        {
+            case 'M':
+                parse_meminfo_line (line, "MemTotal:", 9, &compressed->mem_total);
+                break;
+            case 'Z':
+                if (parse_meminfo_line (line, "Zswap:", 6, &compressed->zswap_used))
+                    compressed->zswap = true;
+                else
+                    zswapped = parse_meminfo_line (line, "Zswapped:", 9, &compressed->zswap_stored);
+                break;
+        }
+        line = systemload_find_eol (line);
+        if (*line == '\n')
+            line++;
+    }
+
+    const gint64 time = systemload_procfile_get_time ();
+    if (sampler->zram_time == 0 || time - sampler->zram_time >= ZRAM_REFRESH_INTERVAL)
+    {
+        update_zram_devices (sampler);
+        sampler->zram_time = time;
+    }
+
+    for (guint i = 0; i < sampler->mm_stats->len; i++)
+    {
+        /* orig_data_size compr_data_size mem_used_total mem_limit ..., in bytes */
+        auto file = (SystemloadProcFile*) g_ptr_array_index (sampler->mm_stats, i);
+        const gchar *mm_stat = systemload_procfile_read (file, NULL);
+        guint64 fields[3];
+        if (mm_stat && systemload_parse_uints (mm_stat, fields, G_N_ELEMENTS (fields), NULL) == G_N_ELEMENTS (fields))
+        {
+            compressed->n_zram++;
+            compressed->zram_stored += fields[0];
+            compressed->zram_used += fields[2];
+        }
+        else
+        {
+            /* The device was removed, look for the others on the next reading */
+            sampler->zram_time = 0;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef _XFCE_SYSTEMLOAD_ZRAM_H_
+#define _XFCE_SYSTEMLOAD_ZRAM_H_
+
+#include <glib.h>
+
+#include "memswap.h"
+
+/* Memory held compressed in RAM by zram devices and by the zswap cache, in bytes */
+struct SystemloadCompressedMemory {
+    guint64  mem_total;     /* RAM of the system */
+    guint    n_zram;        /* zram devices */
+    guint64  zram_stored;   /* Data in the zram devices, before compression */
+    guint64  zram_used;     /* RAM used by the zram devices, including fragmentation and metadata */
+    bool     zswap;         /* The kernel has zswap */
+    guint64  zswap_stored;  /* Pages in the zswap cache, before compression */
+    guint64  zswap_used;    /* RAM used by the zswap cache */
+};
+
+/* The files of the zram devices */
+struct SystemloadZramSampler;
+
+SystemloadZramSampler *systemload_zram_sampler_new  (void);
+void                   systemload_zram_sampler_free (SystemloadZramSampler *sampler);
+
+/*
+ * Reads mm_stat of every zram device in /sys/block, and Zswap and Zswapped of the /proc/meminfo
+ * of the memory sampler, which is shared with read_memswap(). The files of the devices stay open,
+ * new devices are found within a minute. Returns -1 if /proc/meminfo cannot be read,
+ * which is always the case on platforms other than Linux.
+ */
+gint read_compressed_memory (SystemloadZramSampler *sampler, SystemloadMemSampler *mem_sampler,
+                             SystemloadCompressedMemory *compressed);
+
+#endif /* _XFCE_SYSTEMLOAD_ZRAM_H_ */
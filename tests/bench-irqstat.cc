@@ -0,0 +1,164 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Measures read_irqstat() on generated /proc/interrupts and /proc/softirqs files of 8, 64, 256
+ * and 1024 CPUs, which are read from a temporary directory: the parsing of both files alone,
+ * and the whole reading with the files read. The files do not change between the readings.
+ * irqstat.cc is included, so that the parsing can be measured on its own.
+ *
+ *   bench-irqstat [iterations]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "panel-plugin/irqstat.cc"
+
+#define DEFAULT_ITERATIONS 2000
+#define N_IRQS 40
+
+static const guint CPU_COUNTS[] = { 8, 64, 256, 1024 };
+static const gchar *const SOFTIRQS[] = { "HI", "TIMER", "NET_TX", "NET_RX", "BLOCK", "IRQ_POLL", "TASKLET", "SCHED", "HRTIMER", "RCU" };
+
+static void
+append_header (GString *text, guint n_cpus)
+{
+    for (guint cpu = 0; cpu < n_cpus; cpu++)
+    {
+        gchar label[16];
+        g_snprintf (label, sizeof (label), "CPU%u", cpu);
+        g_string_append_printf (text, " %10s", label);
+    }
+}
+
+/* The columns are padded to a width of 10, a row of /proc/interrupts ends with its device */
+static gchar *
+generate_interrupts (guint n_cpus)
+{
+    GString *text = g_string_new ("     ");
+    append_header (text, n_cpus);
+    g_string_append_c (text, '\n');
+    for (guint irq = 0; irq < N_IRQS; irq++)
+    {
+        g_string_append_printf (text, "%4u:", irq);
+        for (guint cpu = 0; cpu < n_cpus; cpu++)
+            g_string_append_printf (text, " %10u", g_random_int () >> g_random_int_range (4, 32));
+        g_string_append_printf (text, "  IR-PCI-MSI %u-edge      nvme0q%u\n", 1000 + irq, irq);
+    }
+    g_string_append (text, "ERR:          0\nMIS:          0\n");
+    return g_string_free (text, FALSE);
+}
+
+static gchar *
+generate_softirqs (guint n_cpus)
+{
+    GString *text = g_string_new ("          ");
+    append_header (text, n_cpus);
+    g_string_append_c (text, '\n');
+    for (guint i = 0; i < G_N_ELEMENTS (SOFTIRQS); i++)
+    {
+        g_string_append_printf (text, "%10s:", SOFTIRQS[i]);
+        for (guint cpu = 0; cpu < n_cpus; cpu++)
+            g_string_append_printf (text, " %10u", g_random_int () >> g_random_int_range (4, 32));
+        g_string_append_c (text, '\n');
+    }
+    return g_string_free (text, FALSE);
+}
+
+int
+main (int argc, char **argv)
+{
+    const guint iterations = argc > 1 ? MAX (atoi (argv[1]), 1) : DEFAULT_ITERATIONS;
+    gchar *dir = g_dir_make_tmp ("systemload-irqstat-XXXXXX", NULL);
+    gchar *interrupts = g_build_filename (dir, "interrupts", NULL);
+    gchar *softirqs = g_build_filename (dir, "softirqs", NULL);
+    gdouble checksum = 0;
+
+    printf ("%5s %8s %10s %10s\n", "cpus", "bytes", "parse µs", "read µs");
+    for (guint c = 0; c < G_N_ELEMENTS (CPU_COUNTS); c++)
+    {
+        gchar *texts[] = { generate_interrupts (CPU_COUNTS[c]), generate_softirqs (CPU_COUNTS[c]) };
+        g_file_set_contents (interrupts, texts[0], -1, NULL);
+        g_file_set_contents (softirqs, texts[1], -1, NULL);
+
+        SystemloadIrqSampler *sampler = systemload_irq_sampler_new ();
+        sampler->interrupts.file = systemload_procfile_open (interrupts);
+        sampler->softirqs.file = systemload_procfile_open (softirqs);
+        SystemloadIrqStat stat;
+        systemload_procfile_begin_tick ();
+        read_irqstat (sampler, &stat);
+
+        t_irq_table *tables[] = { &sampler->interrupts, &sampler->softirqs };
+        gsize bytes = 0;
+        gint64 parse_time = 0;
+        for (guint t = 0; t < G_N_ELEMENTS (tables); t++)
+        {
+            const gchar *buf = systemload_procfile_read (tables[t]->file, NULL);
+            bytes += strlen (buf);
+            const gint64 start = g_get_monotonic_time ();
+            for (guint i = 0; i < iterations; i++)
+                table_parse (tables[t], buf, false);
+            parse_time += g_get_monotonic_time () - start;
+        }
+
+        const gint64 start = g_get_monotonic_time ();
+        for (guint i = 0; i < iterations; i++)
+        {
+            systemload_procfile_begin_tick ();
+            read_irqstat (sampler, &stat);
+            checksum += stat.rate;
+        }
+        const gint64 read_time = g_get_monotonic_time () - start;
+
+        printf ("%5u %8" G_GSIZE_FORMAT " %10.2f %10.2f\n", CPU_COUNTS[c], bytes,
+                (gdouble) parse_time / iterations, (gdouble) read_time / iterations);
+
+        systemload_irq_sampler_free (sampler);
+        g_free (texts[0]);
+        g_free (texts[1]);
+    }
+
+    g_unlink (interrupts);
+    g_unlink (softirqs);
+    g_rmdir (dir);
+    g_free (interrupts);
+    g_free (softirqs);
+    g_free (dir);
+
+    /* Keeps the checksum alive */
+    return checksum == 42 ? 2 : 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Reads the files of a typical update and reports the read system calls and the time per tick:
+ *
+ *   baseline   How the plugin read its files before SystemloadProcFile: fopen() and fscanf()
+ *              of the cpu line of /proc/stat as in cpu.cc, open(), read() of a page and close()
+ *              of every other file as in memswap.cc.
+ *   single     One pread() of a page per file on a file descriptor which stays open.
+ *   procfile   Through SystemloadProcFile, which reads every file to its end. The backend is
+ *              io_uring when built with liburing and run with SYSTEMLOAD_IO_URING=1, the batched
+ *              reads are then made by io_uring_enter() and are not counted as read system calls.
+ *
+ *   [SYSTEMLOAD_IO_URING=1] bench-procfile [ticks] [path...]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+
+#include "panel-plugin/procfile.h"
+
+#define DEFAULT_TICKS 10000
+#define PAGE_BUFFER_SIZE 4096
+
+static const gchar *const DEFAULT_PATHS[] = {
+    "/proc/stat",
+    "/proc/meminfo",
+    "/proc/uptime",
+    "/proc/net/dev",
+    "/proc/vmstat",
+    "/proc/interrupts",
+    "/proc/softirqs",
+    "/proc/schedstat",
+    "/proc/swaps",
+    "/proc/net/snmp",
+    "/proc/net/netstat",
+    "/proc/net/sockstat",
+};
+
+/* The number of read system calls made by the process so far */
+static guint64
+count_reads (void)
+{
+    guint64 reads = 0;
+    gchar line[128];
+
+    FILE *f = fopen ("/proc/self/io", "r");
+    if (!f)
+        return 0;
+    while (fgets (line, sizeof (line), f))
+        if (sscanf (line, "syscr: %" G_GUINT64_FORMAT, &reads) == 1)
+            break;
+    fclose (f);
+    return reads;
+}
+
+/* Reads the file as the plugin did before, returns the number of bytes read */
+static gsize
+read_baseline (const gchar *path, gchar *buf, gsize size)
+{
+    if (strcmp (path, "/proc/stat") == 0)
+    {
+        unsigned long long values[8];
+        FILE *f = fopen (path, "r");
+        if (!f)
+            return 0;
+        gint n = fscanf (f, "%*s %llu %llu %llu %llu %llu %llu %llu %*u %llu", &values[0], &values[1],
+                         &values[2], &values[3], &values[4], &values[5], &values[6], &values[7]);
+        fclose (f);
+        return MAX (n, 0) * sizeof (values[0]);
+    }
+
+    gint fd = open (path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+    ssize_t n = read (fd, buf, size - 1);
+    close (fd);
+    return MAX (n, 0);
+}
+
+static void
+report (const gchar *mode, guint ticks, guint64 reads, gint64 time, gsize bytes)
+{
+    printf ("%-10s %10.2f %10.2f %12" G_GSIZE_FORMAT "\n",
+            mode, (gdouble) reads / ticks, (gdouble) time / ticks, bytes);
+}
+
+int
+main (int argc, char **argv)
+{
+    const guint ticks = argc > 1 ? MAX (atoi (argv[1]), 1) : DEFAULT_TICKS;
+    const gchar *const *paths = argc > 2 ? (const gchar *const *) argv + 2 : DEFAULT_PATHS;
+    const guint n_paths = argc > 2 ? argc - 2 : G_N_ELEMENTS (DEFAULT_PATHS);
+
+    gint *fds = g_new (gint, n_paths);
+    SystemloadProcFile **files = g_new0 (SystemloadProcFile*, n_paths);
+    for (guint i = 0; i < n_paths; i++)
+    {
+        fds[i] = open (paths[i], O_RDONLY | O_CLOEXEC);
+        files[i] = systemload_procfile_open (paths[i]);
+    }
+
+#ifdef HAVE_LIBURING
+    if (g_strcmp0 (g_getenv ("SYSTEMLOAD_IO_URING"), "1") == 0)
+        printf ("procfile backend: io_uring\n");
+    else
+#endif
+        printf ("procfile backend: pread()\n");
+    printf ("%-10s %10s %10s %12s\n", "mode", "reads/tick", "µs/tick", "bytes/tick");
+
+    /* For /proc/stat, the bytes are those of the parsed values */
+    gchar buf[PAGE_BUFFER_SIZE];
+    gsize bytes = 0;
+    guint64 reads = count_reads ();
+    gint64 start = g_get_monotonic_time ();
+    for (guint t = 0; t < ticks; t++)
+    {
+        bytes = 0;
+        for (guint i = 0; i < n_paths; i++)
+            bytes += read_baseline (paths[i], buf, sizeof (buf));
+    }
+    report ("baseline", ticks, count_reads () - reads - 1, g_get_monotonic_time () - start, bytes);
+
+    /* One read, which returns at most a page of a seq_file */
+    reads = count_reads ();
+    start = g_get_monotonic_time ();
+    for (guint t = 0; t < ticks; t++)
+    {
+        bytes = 0;
+        for (guint i = 0; i < n_paths; i++)
+        {
+            ssize_t n = fds[i] >= 0 ? pread (fds[i], buf, sizeof (buf) - 1, 0) : -1;
+            if (n > 0)
+                bytes += n;
+        }
+    }
+    report ("single", ticks, count_reads () - reads - 1, g_get_monotonic_time () - start, bytes);
+
+    reads = count_reads ();
+    start = g_get_monotonic_time ();
+    for (guint t = 0; t < ticks; t++)
+    {
+        systemload_procfile_begin_tick ();
+        bytes = 0;
+        for (guint i = 0; i < n_paths; i++)
+        {
+            gsize length;
+            if (files[i] && systemload_procfile_read (files[i], &length))
+                bytes += length;
+        }
+    }
+    report ("procfile", ticks, count_reads () - reads - 1, g_get_monotonic_time () - start, bytes);
+
+    for (guint i = 0; i < n_paths; i++)
+    {
+        if (fds[i] >= 0)
+            close (fds[i]);
+        systemload_procfile_close (files[i]);
+    }
+    g_free (files);
+    g_free (fds);
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Measures the parsing of generated /proc/stat and /proc/interrupts files of 8, 64, 256 and
+ * 1024 CPUs, with sscanf() as the plugin parsed /proc/stat before, with strtoull(), and with
+ * every implementation of systemload_parse_uints() the CPU supports. "auto" is the selection
+ * made at runtime, which parses /proc/interrupts with systemload_parse_uints_wide().
+ *
+ *   bench-procparse [iterations]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include "panel-plugin/procfile.h"
+#include "panel-plugin/procparse.h"
+
+#define DEFAULT_ITERATIONS 2000
+#define N_IRQS 40
+#define MAX_FIELDS 1100
+
+static const guint CPU_COUNTS[] = { 8, 64, 256, 1024 };
+static const gchar *const IMPLS[] = { "scalar", "sse2", "avx2", "auto" };
+
+/* Sums the values, so that the parsing cannot be optimized away */
+static guint64 checksum;
+
+typedef void (*ParseFunc) (const gchar *buf);
+
+static void
+parse_sscanf (const gchar *buf)
+{
+    for (const gchar *line = buf; *line; )
+    {
+        gulong v[8] = { 0 };
+        if (sscanf (line, "%*s %lu %lu %lu %lu %lu %lu %lu %lu", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]) > 0)
+            checksum += v[0] + v[7];
+        const gchar *eol = strchr (line, '\n');
+        line = eol ? eol + 1 : line + strlen (line);
+    }
+}
+
+static void
+parse_strtoull (const gchar *buf)
+{
+    for (const gchar *s = buf; *s; )
+    {
+        if ((guchar) (*s - '0') > 9)
+        {
+            s++;
+            continue;
+        }
+        gchar *end;
+        checksum += strtoull (s, &end, 10);
+        s = end;
+    }
+}
+
+static void
+parse_uints (const gchar *buf)
+{
+    static guint64 fields[MAX_FIELDS];
+
+    for (const gchar *line = buf; *line; )
+    {
+        const guint n = systemload_parse_uints (line, fields, MAX_FIELDS, &line);
+        if (n > 0)
+            checksum += fields[0] + fields[n - 1];
+    }
+}
+
+static void
+parse_uints_wide (const gchar *buf)
+{
+    static guint64 fields[MAX_FIELDS];
+
+    for (const gchar *line = buf; *line; )
+    {
+        const guint n = systemload_parse_uints_wide (line, fields, MAX_FIELDS, &line);
+        if (n > 0)
+            checksum += fields[0] + fields[n - 1];
+    }
+}
+
+static gchar *
+generate_stat (guint n_cpus)
+{
+    GString *text = g_string_new (NULL);
+    for (gint cpu = -1; cpu < (gint) n_cpus; cpu++)
+    {
+        if (cpu < 0)
+            g_string_append (text, "cpu ");
+        else
+            g_string_append_printf (text, "cpu%d", cpu);
+        for (guint i = 0; i < 10; i++)
+            g_string_append_printf (text, " %u", i == 3 ? g_random_int () >> 4 : g_random_int () >> 12);
+        g_string_append_c (text, '\n');
+    }
+    g_string_append (text, "ctxt 987654321\nbtime 1700000000\nprocesses 123456\n");
+
+    const gsize length = text->len;
+    g_string_set_size (text, length + SYSTEMLOAD_PROCFILE_PADDING);
+    return g_string_free (text, FALSE);
+}
+
+/* The columns of /proc/interrupts are padded to a width of 10 and a row ends with its name */
+static gchar *
+generate_interrupts (guint n_cpus)
+{
+    GString *text = g_string_new ("     ");
+    for (guint cpu = 0; cpu < n_cpus; cpu++)
+        g_string_append_printf (text, " %10s", "");
+    g_string_append_c (text, '\n');
+    for (guint irq = 0; irq < N_IRQS; irq++)
+    {
+        g_string_append_printf (text, "%4u:", irq);
+        for (guint cpu = 0; cpu < n_cpus; cpu++)
+            g_string_append_printf (text, " %10u", g_random_int () >> g_random_int_range (4, 32));
+        g_string_append (text, "  IR-PCI-MSI 1234-edge      nvme0q1\n");
+    }
+
+    const gsize length = text->len;
+    g_string_set_size (text, length + SYSTEMLOAD_PROCFILE_PADDING);
+    return g_string_free (text, FALSE);
+}
+
+static void
+run (const gchar *file, guint n_cpus, const gchar *name, ParseFunc parse, const gchar *buf, guint iterations)
+{
+    const gsize length = strlen (buf);
+    const gint64 start = g_get_monotonic_time ();
+    for (guint i = 0; i < iterations; i++)
+        parse (buf);
+    const gdouble us = (gdouble) (g_get_monotonic_time () - start) / iterations;
+    printf ("%-11s %5u %-8s %10.2f %10.0f\n", file, n_cpus, name, us, length / us);
+}
+
+int
+main (int argc, char **argv)
+{
+    const guint iterations = argc > 1 ? MAX (atoi (argv[1]), 1) : DEFAULT_ITERATIONS;
+
+    printf ("%-11s %5s %-8s %10s %10s\n", "file", "cpus", "parser", "µs", "MB/s");
+    for (guint c = 0; c < G_N_ELEMENTS (CPU_COUNTS); c++)
+    {
+        gchar *files[] = { generate_stat (CPU_COUNTS[c]), generate_interrupts (CPU_COUNTS[c]) };
+        const gchar *names[] = { "stat", "interrupts" };
+        const ParseFunc parsers[] = { parse_uints, parse_uints_wide };
+
+        for (guint f = 0; f < G_N_ELEMENTS (files); f++)
+        {
+            /* sscanf() stops at the 8th field, it is only a baseline for /proc/stat */
+            if (f == 0)
+                run (names[f], CPU_COUNTS[c], "sscanf", parse_sscanf, files[f], iterations);
+            run (names[f], CPU_COUNTS[c], "strtoull", parse_strtoull, files[f], iterations);
+            for (guint i = 0; i < G_N_ELEMENTS (IMPLS); i++)
+                if (systemload_parse_set_impl (IMPLS[i]))
+                    run (names[f], CPU_COUNTS[c], IMPLS[i], parsers[f], files[f], iterations);
+            g_free (files[f]);
+        }
+    }
+
+    /* Keeps the checksum alive */
+    return checksum == 42 ? 2 : 0;
+}
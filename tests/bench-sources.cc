@@ -0,0 +1,113 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Measures the memory, swap and uptime sources against each other: parsing /proc/meminfo and
+ * /proc/uptime, which are read again in every tick, and the sysinfo() and clock_gettime() calls.
+ *
+ *   bench-sources [iterations]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glib.h>
+
+#include "panel-plugin/memswap.h"
+#include "panel-plugin/procfile.h"
+#include "panel-plugin/uptime.h"
+
+#define DEFAULT_ITERATIONS 100000
+
+/* Sums the results, so that the calls cannot be optimized away */
+static gulong checksum;
+
+typedef void (*SourceFunc) (SystemloadMemSampler *sampler);
+
+static void
+memory_procfs (SystemloadMemSampler *sampler)
+{
+    gulong mem, swap, MT, MU, ST, SU;
+    if (read_memswap (sampler, &mem, &swap, &MT, &MU, &ST, &SU) == 0)
+        checksum += MU;
+}
+
+static void
+memory_syscall (SystemloadMemSampler *sampler)
+{
+    gulong mem, swap, MT, MU, ST, SU;
+    if (read_memswap_syscall (sampler, &mem, &swap, &MT, &MU, &ST, &SU) == 0)
+        checksum += MU;
+}
+
+static void
+uptime_procfs (SystemloadMemSampler *sampler)
+{
+    checksum += read_uptime ();
+}
+
+static void
+uptime_clock (SystemloadMemSampler *sampler)
+{
+    checksum += read_uptime_clock ();
+}
+
+static void
+run (const gchar *name, SourceFunc source, SystemloadMemSampler *sampler, guint iterations)
+{
+    /* Every update starts a tick, so the files are read again each time */
+    const gint64 start = g_get_monotonic_time ();
+    for (guint i = 0; i < iterations; i++)
+    {
+        systemload_procfile_begin_tick ();
+        source (sampler);
+    }
+    printf ("%-16s %10.3f\n", name, (gdouble) (g_get_monotonic_time () - start) / iterations);
+}
+
+int
+main (int argc, char **argv)
+{
+    const guint iterations = argc > 1 ? MAX (atoi (argv[1]), 1) : DEFAULT_ITERATIONS;
+    SystemloadMemSampler *sampler = systemload_mem_sampler_new (NULL);
+
+    printf ("%-16s %10s\n", "source", "µs/update");
+    run ("memory procfs", memory_procfs, sampler, iterations);
+    run ("memory syscall", memory_syscall, sampler, iterations);
+    run ("uptime procfs", uptime_procfs, sampler, iterations);
+    run ("uptime clock", uptime_clock, sampler, iterations);
+
+    systemload_mem_sampler_free (sampler);
+
+    /* Keeps the checksum alive */
+    return checksum == 42 ? 2 : 0;
+}
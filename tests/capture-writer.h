@@ -0,0 +1,124 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Builds capture files in the format read by SYSTEMLOAD_REPLAY, see procfile.cc, so that the
+ * tests can feed chosen contents of /proc and /sys to the samplers. The capture is replayed
+ * from the first call into procfile.cc, so a test sets it up before it creates a sampler.
+ */
+
+#ifndef _XFCE_SYSTEMLOAD_CAPTURE_WRITER_H_
+#define _XFCE_SYSTEMLOAD_CAPTURE_WRITER_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+enum { CAPTURE_WRITER_PATH = 1, CAPTURE_WRITER_TICK, CAPTURE_WRITER_CONTENTS, CAPTURE_WRITER_UNCHANGED };
+
+/* Starts a recording session, a capture may hold several */
+static inline void
+capture_writer_begin_session (GString *capture)
+{
+    g_string_append_len (capture, "SLCAPT01", 8);
+}
+
+static inline void
+capture_writer_path (GString *capture, guint16 id, const gchar *path)
+{
+    const guint8 type = CAPTURE_WRITER_PATH;
+    const guint16 length = strlen (path);
+    g_string_append_len (capture, (const gchar*) &type, sizeof (type));
+    g_string_append_len (capture, (const gchar*) &id, sizeof (id));
+    g_string_append_len (capture, (const gchar*) &length, sizeof (length));
+    g_string_append_len (capture, path, length);
+}
+
+static inline void
+capture_writer_tick (GString *capture, gint64 time)
+{
+    const guint8 type = CAPTURE_WRITER_TICK;
+    g_string_append_len (capture, (const gchar*) &type, sizeof (type));
+    g_string_append_len (capture, (const gchar*) &time, sizeof (time));
+}
+
+static inline void
+capture_writer_contents (GString *capture, guint16 id, const gchar *contents)
+{
+    const guint8 type = CAPTURE_WRITER_CONTENTS;
+    const guint32 length = strlen (contents);
+    g_string_append_len (capture, (const gchar*) &type, sizeof (type));
+    g_string_append_len (capture, (const gchar*) &id, sizeof (id));
+    g_string_append_len (capture, (const gchar*) &length, sizeof (length));
+    g_string_append_len (capture, contents, length);
+}
+
+static inline void
+capture_writer_unchanged (GString *capture, guint16 id)
+{
+    const guint8 type = CAPTURE_WRITER_UNCHANGED;
+    g_string_append_len (capture, (const gchar*) &type, sizeof (type));
+    g_string_append_len (capture, (const gchar*) &id, sizeof (id));
+}
+
+/*
+ * Writes the capture to a temporary file and replays it tick by tick from now on.
+ * Returns the name of the file, which the caller removes with capture_writer_remove().
+ */
+static inline gchar *
+capture_writer_replay (GString *capture)
+{
+    GError *error = NULL;
+    gchar *filename = NULL;
+
+    gint fd = g_file_open_tmp ("systemload-capture-XXXXXX", &filename, &error);
+    if (fd < 0 || !g_file_set_contents (filename, capture->str, capture->len, &error))
+    {
+        g_printerr ("Cannot write the capture: %s\n", error->message);
+        g_error_free (error);
+        exit (1);
+    }
+    close (fd);
+
+    g_setenv ("SYSTEMLOAD_REPLAY", filename, TRUE);
+    g_setenv ("SYSTEMLOAD_REPLAY_SPEED", "0", TRUE);
+    return filename;
+}
+
+static inline void
+capture_writer_remove (gchar *filename)
+{
+    g_unlink (filename);
+    g_free (filename);
+}
+
+#endif /* !_XFCE_SYSTEMLOAD_CAPTURE_WRITER_H_ */
@@ -0,0 +1,176 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Tests the transitions of SystemloadAlert: an alert is raised once the value stayed at or
+ * above the threshold for the hold time and cleared when it drops below the threshold minus
+ * the hysteresis, and its command is not run again while it runs or within the interval.
+ * Includes alert.cc to test the expansion of the command and to see when the command exited.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "panel-plugin/alert.cc"
+
+#define SECOND G_USEC_PER_SEC
+
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+static void
+test_hold (void)
+{
+    const SystemloadAlertRule rule = { 80, 5, 10 };
+    SystemloadAlert *alert = systemload_alert_new ();
+
+    CHECK (systemload_alert_evaluate (alert, &rule, 79, 1 * SECOND) == ALERT_UNCHANGED);
+    CHECK (systemload_alert_evaluate (alert, &rule, 80, 2 * SECOND) == ALERT_UNCHANGED);
+    CHECK (systemload_alert_evaluate (alert, &rule, 95, 6 * SECOND) == ALERT_UNCHANGED);
+    CHECK (!systemload_alert_is_active (alert));
+
+    /* A dip below the threshold restarts the hold time */
+    CHECK (systemload_alert_evaluate (alert, &rule, 79, 7 * SECOND) == ALERT_UNCHANGED);
+    CHECK (systemload_alert_evaluate (alert, &rule, 90, 8 * SECOND) == ALERT_UNCHANGED);
+    CHECK (systemload_alert_evaluate (alert, &rule, 90, 12 * SECOND) == ALERT_UNCHANGED);
+    CHECK (systemload_alert_evaluate (alert, &rule, 90, 13 * SECOND) == ALERT_RAISED);
+    CHECK (systemload_alert_is_active (alert));
+    CHECK (systemload_alert_evaluate (alert, &rule, 100, 14 * SECOND) == ALERT_UNCHANGED);
+
+    systemload_alert_free (alert);
+}
+
+static void
+test_hysteresis (void)
+{
+    const SystemloadAlertRule rule = { 80, 0, 10 };
+    SystemloadAlert *alert = systemload_alert_new ();
+
+    /* Without a hold time, the first value at the threshold raises the alert */
+    CHECK (systemload_alert_evaluate (alert, &rule, 80, 1 * SECOND) == ALERT_RAISED);
+    CHECK (systemload_alert_evaluate (alert, &rule, 75, 2 * SECOND) == ALERT_UNCHANGED);
+    CHECK (systemload_alert_evaluate (alert, &rule, 70, 3 * SECOND) == ALERT_UNCHANGED);
+    CHECK (systemload_alert_is_active (alert));
+    CHECK (systemload_alert_evaluate (alert, &rule, 69, 4 * SECOND) == ALERT_CLEARED);
+    CHECK (!systemload_alert_is_active (alert));
+    CHECK (systemload_alert_evaluate (alert, &rule, 79, 5 * SECOND) == ALERT_UNCHANGED);
+    CHECK (systemload_alert_evaluate (alert, &rule, 80, 6 * SECOND) == ALERT_RAISED);
+
+    /* With a hysteresis above the threshold, the alert stays until the rule is disabled */
+    const SystemloadAlertRule wide = { 5, 0, 20 };
+    CHECK (systemload_alert_evaluate (alert, &wide, 0, 7 * SECOND) == ALERT_UNCHANGED);
+
+    /* Disabling the rule clears the alert */
+    const SystemloadAlertRule disabled = { 0, 0, 0 };
+    CHECK (systemload_alert_evaluate (alert, &disabled, 100, 8 * SECOND) == ALERT_CLEARED);
+    CHECK (systemload_alert_evaluate (alert, &disabled, 100, 9 * SECOND) == ALERT_UNCHANGED);
+    CHECK (!systemload_alert_is_active (alert));
+
+    systemload_alert_free (alert);
+}
+
+static void
+test_expand (void)
+{
+    gchar *expanded = expand_command ("notify %m=%v%% %x %", "cpu", 42);
+    CHECK (g_strcmp0 (expanded, "notify cpu=42% %x %") == 0);
+    g_free (expanded);
+}
+
+/* Runs the main loop until the command which was started has exited and was reaped */
+static void
+wait_for_command (SystemloadAlert *alert)
+{
+    const gint64 end = g_get_monotonic_time () + 10 * SECOND;
+    while (alert->child && g_get_monotonic_time () < end)
+    {
+        while (g_main_context_iteration (NULL, FALSE))
+            ;
+        g_usleep (1000);
+    }
+    CHECK (alert->child == NULL);
+}
+
+static void
+test_run (void)
+{
+    SystemloadAlert *alert = systemload_alert_new ();
+    gchar *dir = g_dir_make_tmp ("systemload-alert-XXXXXX", NULL);
+    gchar *command = g_strdup_printf ("sh -c 'echo %%m %%v %%%% >> %s/runs'", dir);
+    gchar *runs = g_build_filename (dir, "runs", NULL);
+    gchar *contents = NULL;
+
+    systemload_alert_run (alert, command, "cpu", 90, 10, 100 * SECOND);
+
+    /* The command still runs */
+    systemload_alert_run (alert, command, "cpu", 91, 0, 200 * SECOND);
+    wait_for_command (alert);
+
+    /* Within the interval */
+    systemload_alert_run (alert, command, "cpu", 92, 10, 109 * SECOND);
+    systemload_alert_run (alert, command, "cpu", 93, 10, 110 * SECOND);
+    wait_for_command (alert);
+
+    CHECK (g_file_get_contents (runs, &contents, NULL, NULL));
+    CHECK (g_strcmp0 (contents, "cpu 90 %\ncpu 93 %\n") == 0);
+
+    systemload_alert_free (alert);
+    g_unlink (runs);
+    g_rmdir (dir);
+    g_free (contents);
+    g_free (runs);
+    g_free (command);
+    g_free (dir);
+}
+
+int
+main (int argc, char **argv)
+{
+    test_hold ();
+    test_hysteresis ();
+    test_expand ();
+    test_run ();
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Replays /proc/stat files to read_cpu_activity(): a reading which lacks some of the counters
+ * fails, and the rates of the next one are taken over the time since the last complete reading.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <glib.h>
+
+#include "panel-plugin/cpu.h"
+#include "panel-plugin/procfile.h"
+#include "tests/capture-writer.h"
+
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+#define CPU_LINES "cpu  100 0 50 1000 5 0 2 0 0 0\ncpu0 100 0 50 1000 5 0 2 0 0 0\n"
+
+int
+main (int argc, char **argv)
+{
+    GString *capture = g_string_new (NULL);
+    capture_writer_begin_session (capture);
+    capture_writer_path (capture, 0, "/proc/stat");
+    capture_writer_tick (capture, 1000000);
+    capture_writer_contents (capture, 0, CPU_LINES "intr 1000 5 6\nctxt 2000\nbtime 1700000000\nprocesses 300\nprocs_running 2\nprocs_blocked 1\n");
+    capture_writer_tick (capture, 2000000);
+    capture_writer_contents (capture, 0, CPU_LINES "intr 1500 5 6\nctxt 2500\nbtime 1700000000\nprocesses 305\nprocs_running 2\n");
+    capture_writer_tick (capture, 3000000);
+    capture_writer_contents (capture, 0, CPU_LINES "intr 3000 5 6\nctxt 4000\nbtime 1700000000\nprocesses 320\nprocs_running 3\nprocs_blocked 0\n");
+    capture_writer_tick (capture, 4000000);
+    capture_writer_contents (capture, 0, CPU_LINES);
+    gchar *filename = capture_writer_replay (capture);
+    g_string_free (capture, TRUE);
+
+    SystemloadCpuSampler *sampler = systemload_cpu_sampler_new (NULL);
+    SystemloadCpuActivity activity;
+
+    systemload_procfile_begin_tick ();
+    CHECK (read_cpu_activity (sampler, &activity) == 0);
+    CHECK (activity.context_switches == 0 && activity.running == 2 && activity.blocked == 1);
+
+    /* procs_blocked is missing */
+    systemload_procfile_begin_tick ();
+    CHECK (read_cpu_activity (sampler, &activity) == -1);
+    CHECK (activity.context_switches == 0 && activity.running == 0);
+
+    /* Over the 2 seconds since the first reading */
+    systemload_procfile_begin_tick ();
+    CHECK (read_cpu_activity (sampler, &activity) == 0);
+    CHECK (activity.context_switches == 1000 && activity.interrupts == 1000 && activity.forks == 10);
+    CHECK (activity.running == 3 && activity.blocked == 0);
+
+    /* Only the cpu lines */
+    systemload_procfile_begin_tick ();
+    CHECK (read_cpu_activity (sampler, &activity) == -1);
+
+    systemload_cpu_sampler_free (sampler);
+    capture_writer_remove (filename);
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,221 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Tests SystemloadHistory in a temporary state directory: the records returned by age before
+ * and after the ring buffer wrapped around, the rejection of torn and stale records, and the
+ * reuse of the file by the next process. Includes history.cc to reach the records.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "panel-plugin/history.cc"
+
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+/* The snapshot with the number i */
+static void
+make_snapshot (guint64 i, SystemloadSnapshot *snapshot)
+{
+    memset (snapshot, 0, sizeof (*snapshot));
+    snapshot->time = 1000000 * i;
+    snapshot->mem_total = 16 << 20;
+    snapshot->mem_used = i;
+    snapshot->net_bits = 3 * i;
+    snapshot->uptime = i % 1000000;
+    snapshot->uptime_enabled = i % 2;
+    for (gsize m = 0; m < N_MONITORS; m++)
+    {
+        snapshot->enabled[m] = (i + m) % 3 != 0;
+        snapshot->value[m] = (i + m) % 101;
+    }
+}
+
+/* Whether the record of the given age holds the snapshot with the number i */
+static bool
+check_record (const SystemloadHistory *history, guint age, guint64 i)
+{
+    SystemloadSnapshot expected, snapshot;
+
+    make_snapshot (i, &expected);
+    if (!systemload_history_get (history, age, &snapshot))
+        return false;
+
+    bool equal = snapshot.time == expected.time &&
+                 snapshot.mem_total == expected.mem_total &&
+                 snapshot.mem_used == expected.mem_used &&
+                 snapshot.net_bits == expected.net_bits &&
+                 snapshot.uptime == expected.uptime &&
+                 snapshot.uptime_enabled == expected.uptime_enabled;
+    for (gsize m = 0; m < N_MONITORS; m++)
+        equal = equal && snapshot.enabled[m] == expected.enabled[m] && snapshot.value[m] == expected.value[m];
+    return equal;
+}
+
+static void
+append (SystemloadHistory *history, guint64 i)
+{
+    SystemloadSnapshot snapshot;
+    make_snapshot (i, &snapshot);
+    systemload_history_append (history, &snapshot);
+}
+
+static void
+test_append (void)
+{
+    SystemloadHistory *history = systemload_history_open ("test");
+    SystemloadSnapshot snapshot;
+
+    CHECK (history != NULL);
+    if (history == NULL)
+        return;
+    CHECK (systemload_history_get_length (history) == 0);
+    CHECK (!systemload_history_get (history, 0, &snapshot));
+
+    for (guint64 i = 0; i < 3; i++)
+        append (history, i);
+    CHECK (systemload_history_get_length (history) == 3);
+    CHECK (check_record (history, 0, 2));
+    CHECK (check_record (history, 2, 0));
+    CHECK (!systemload_history_get (history, 3, &snapshot));
+
+    /* Values above 100% are clamped */
+    make_snapshot (3, &snapshot);
+    snapshot.value[0] = 150;
+    systemload_history_append (history, &snapshot);
+    CHECK (systemload_history_get (history, 0, &snapshot) && snapshot.value[0] == 100);
+
+    /* Wrap around, the oldest records are overwritten */
+    const guint64 n = HISTORY_CAPACITY + 100;
+    for (guint64 i = 4; i < n; i++)
+        append (history, i);
+    CHECK (systemload_history_get_length (history) == HISTORY_CAPACITY);
+    CHECK (check_record (history, 0, n - 1));
+    CHECK (check_record (history, 99, n - 100));
+    CHECK (check_record (history, 100, n - 101));
+    CHECK (check_record (history, HISTORY_CAPACITY - 1, n - HISTORY_CAPACITY));
+    CHECK (!systemload_history_get (history, HISTORY_CAPACITY, &snapshot));
+
+    /* A record whose append did not finish, and a record left from the previous round */
+    t_history_record *torn = &history->records[(n - 1 - 5) % HISTORY_CAPACITY];
+    t_history_record *stale = &history->records[(n - 1 - 7) % HISTORY_CAPACITY];
+    torn->seq = 0;
+    stale->seq -= HISTORY_CAPACITY;
+    CHECK (check_record (history, 4, n - 5));
+    CHECK (!systemload_history_get (history, 5, &snapshot));
+    CHECK (check_record (history, 6, n - 7));
+    CHECK (!systemload_history_get (history, 7, &snapshot));
+
+    /* The slots are valid again once they are overwritten */
+    for (guint64 i = n; i < n + HISTORY_CAPACITY; i++)
+        append (history, i);
+    CHECK (check_record (history, 5, n + HISTORY_CAPACITY - 1 - 5));
+    CHECK (check_record (history, 7, n + HISTORY_CAPACITY - 1 - 7));
+    for (guint age = 0; age < HISTORY_CAPACITY; age += 997)
+        CHECK (check_record (history, age, n + HISTORY_CAPACITY - 1 - age));
+
+    systemload_history_close (history);
+}
+
+static void
+test_reopen (void)
+{
+    const guint64 n = 2 * HISTORY_CAPACITY + 100;
+    SystemloadSnapshot snapshot;
+
+    /* The records written by the previous process */
+    SystemloadHistory *history = systemload_history_open ("test");
+    CHECK (history != NULL);
+    if (history == NULL)
+        return;
+    CHECK (systemload_history_get_length (history) == HISTORY_CAPACITY);
+    CHECK (check_record (history, 0, n - 1));
+    CHECK (check_record (history, HISTORY_CAPACITY - 1, n - HISTORY_CAPACITY));
+
+    /* The cursor is 64 bits wide, ages are not cut to 32 bits */
+    const guint64 start = ((guint64) 1 << 32) - 3;
+    history->header->count = start;
+    for (guint64 i = start; i < start + 10; i++)
+        append (history, i);
+    for (guint age = 0; age < 10; age++)
+        CHECK (check_record (history, age, start + 9 - age));
+    CHECK (!systemload_history_get (history, 10, &snapshot));
+
+    /* A file of another version is started afresh */
+    history->header->version = HISTORY_VERSION + 1;
+    systemload_history_close (history);
+    history = systemload_history_open ("test");
+    CHECK (history != NULL);
+    if (history == NULL)
+        return;
+    CHECK (systemload_history_get_length (history) == 0);
+    CHECK (header_valid (history->header));
+    systemload_history_close (history);
+}
+
+int
+main (int argc, char **argv)
+{
+    gchar *state = g_dir_make_tmp ("systemload-history-XXXXXX", NULL);
+    g_setenv ("XDG_STATE_HOME", state, TRUE);
+
+    test_append ();
+    test_reopen ();
+
+    gchar *dir = history_dir ();
+    gchar *path = g_build_filename (dir, "test.history", NULL);
+    g_unlink (path);
+    g_rmdir (dir);
+    g_free (dir);
+    dir = g_build_filename (state, "xfce4", NULL);
+    g_rmdir (dir);
+    g_rmdir (state);
+    g_free (dir);
+    g_free (path);
+    g_free (state);
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
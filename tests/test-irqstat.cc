@@ -0,0 +1,293 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Tests the parsing of /proc/interrupts and /proc/softirqs against fixtures: rows which are
+ * added and removed, the "ERR" and "MIS" rows with a single total, files truncated at the
+ * buffer size, and a file which cannot be read on a tick. irqstat.cc is included, so that its
+ * static functions are tested directly.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "panel-plugin/irqstat.cc"
+
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+#define INTERRUPTS_HEADER "           CPU0       CPU1       CPU3\n"
+
+static const gchar INTERRUPTS_1[] =
+    INTERRUPTS_HEADER
+    "  0:         40          0          0  IR-IO-APIC    2-edge      timer\n"
+    " 24:       1000        200         10  IR-PCI-MSI 1234-edge      nvme0q1\n"
+    "NMI:          5          6          7   Non-maskable interrupts\n"
+    "ERR:          0\n"
+    "MIS:          0\n";
+
+static const gchar INTERRUPTS_2[] =
+    INTERRUPTS_HEADER
+    "  0:         41          0          0  IR-IO-APIC    2-edge      timer\n"
+    " 24:       1100        260         10  IR-PCI-MSI 1234-edge      nvme0q1\n"
+    "NMI:          5          6          9   Non-maskable interrupts\n"
+    "ERR:          3\n"
+    "MIS:          1\n";
+
+/* A driver registered interrupt line 25 */
+static const gchar INTERRUPTS_ADDED[] =
+    INTERRUPTS_HEADER
+    "  0:         41          0          0  IR-IO-APIC    2-edge      timer\n"
+    " 24:       1100        260         10  IR-PCI-MSI 1234-edge      nvme0q1\n"
+    " 25:          1          0          0  IR-PCI-MSI 5678-edge      eth0\n"
+    "NMI:          5          6          9   Non-maskable interrupts\n"
+    "ERR:          3\n"
+    "MIS:          1\n";
+
+/* The driver of interrupt line 24 released it */
+static const gchar INTERRUPTS_REMOVED[] =
+    INTERRUPTS_HEADER
+    "  0:         41          0          0  IR-IO-APIC    2-edge      timer\n"
+    "NMI:          5          6          9   Non-maskable interrupts\n"
+    "ERR:          3\n"
+    "MIS:          1\n";
+
+/* Copies the text into a buffer which is padded like the ones of procfile.h */
+static gchar *
+padded_copy (const gchar *text, gsize length)
+{
+    gchar *buf = (gchar*) g_malloc0 (length + 1 + SYSTEMLOAD_PROCFILE_PADDING);
+    memcpy (buf, text, length);
+    return buf;
+}
+
+static bool
+parse (t_irq_table *table, const gchar *text, gsize length, bool truncated)
+{
+    gchar *buf = padded_copy (text, length);
+    bool parsed = table_parse (table, buf, truncated);
+    if (parsed)
+        table->primed = true;
+    g_free (buf);
+    return parsed;
+}
+
+static bool
+parse_text (t_irq_table *table, const gchar *text)
+{
+    return parse (table, text, strlen (text), false);
+}
+
+static guint64
+delta (const t_irq_table *table, guint row, guint col)
+{
+    return table->delta[(gsize) row * table->n_cols + col];
+}
+
+static void
+test_layout (void)
+{
+    t_irq_table table = {};
+    gchar *buf = padded_copy (INTERRUPTS_1, strlen (INTERRUPTS_1));
+    table_build (&table, buf);
+    g_free (buf);
+
+    CHECK (table.n_cols == 3);
+    CHECK (table.col_cpu[0] == 0 && table.col_cpu[1] == 1 && table.col_cpu[2] == 3);
+    CHECK (table.n_rows == 5);
+    CHECK (strcmp ((const gchar*) g_ptr_array_index (table.labels, 1), "24") == 0);
+    CHECK (strcmp ((const gchar*) g_ptr_array_index (table.names, 1), "24 nvme0q1") == 0);
+    CHECK (strcmp ((const gchar*) g_ptr_array_index (table.names, 2), "NMI") == 0);
+    CHECK (strcmp ((const gchar*) g_ptr_array_index (table.names, 3), "ERR") == 0);
+
+    /* The first reading has no deltas */
+    CHECK (parse_text (&table, INTERRUPTS_1));
+    CHECK (table.per_cpu[0] && table.per_cpu[1] && table.per_cpu[2]);
+    CHECK (delta (&table, 1, 0) == 0);
+
+    CHECK (parse_text (&table, INTERRUPTS_2));
+    CHECK (delta (&table, 0, 0) == 1);
+    CHECK (delta (&table, 1, 0) == 100 && delta (&table, 1, 1) == 60 && delta (&table, 1, 2) == 0);
+    CHECK (delta (&table, 2, 2) == 2);
+
+    /* A single total is not a count per CPU */
+    CHECK (!table.per_cpu[3] && !table.per_cpu[4]);
+    CHECK (delta (&table, 3, 0) == 0 && delta (&table, 4, 0) == 0);
+
+    /* Rows which were added or removed change the layout */
+    CHECK (!parse_text (&table, INTERRUPTS_ADDED));
+    CHECK (!parse_text (&table, INTERRUPTS_REMOVED));
+
+    buf = padded_copy (INTERRUPTS_REMOVED, strlen (INTERRUPTS_REMOVED));
+    table_build (&table, buf);
+    g_free (buf);
+    CHECK (table.n_rows == 4);
+    CHECK (parse_text (&table, INTERRUPTS_REMOVED));
+    CHECK (delta (&table, 0, 0) == 0);
+
+    table_clear (&table);
+}
+
+static void
+test_truncated (void)
+{
+    t_irq_table table = {};
+    gchar *buf = padded_copy (INTERRUPTS_1, strlen (INTERRUPTS_1));
+    table_build (&table, buf);
+    g_free (buf);
+    CHECK (parse_text (&table, INTERRUPTS_1));
+
+    /* The read stopped in the counts of line 24: its counts and the rows after it are missing */
+    const gchar *cut = strstr (INTERRUPTS_2, "260");
+    CHECK (parse (&table, INTERRUPTS_2, cut - INTERRUPTS_2, true));
+    CHECK (table.per_cpu[0] && delta (&table, 0, 0) == 1);
+    CHECK (!table.per_cpu[1] && !table.per_cpu[2]);
+    CHECK (delta (&table, 1, 0) == 0 && delta (&table, 2, 2) == 0);
+
+    /* The same truncation without the flag is a changed layout */
+    CHECK (!parse (&table, INTERRUPTS_2, cut - INTERRUPTS_2, false));
+
+    /* Rows which were missing are compared with the next reading only */
+    CHECK (parse (&table, INTERRUPTS_2, cut - INTERRUPTS_2, true));
+    CHECK (parse_text (&table, INTERRUPTS_2));
+    CHECK (table.per_cpu[1] && delta (&table, 1, 0) == 0 && delta (&table, 0, 0) == 0);
+
+    /* A layout built from a truncated file holds the rows which fit, the rows after them are ignored */
+    const gchar *end = strstr (INTERRUPTS_1, " 24:");
+    buf = padded_copy (INTERRUPTS_1, end - INTERRUPTS_1);
+    table_build (&table, buf);
+    g_free (buf);
+    CHECK (table.n_rows == 1);
+    end = strstr (INTERRUPTS_2, "NMI");
+    CHECK (parse (&table, INTERRUPTS_2, end - INTERRUPTS_2, true));
+    CHECK (!parse (&table, INTERRUPTS_2, end - INTERRUPTS_2, false));
+
+    table_clear (&table);
+}
+
+#define SOFTIRQS_HEADER "                    CPU0       CPU1       CPU3\n"
+
+static void
+write_file (const gchar *path, const gchar *text)
+{
+    /* In place, as the file stays open in procfile.cc */
+    FILE *f = fopen (path, "w");
+    fputs (text, f);
+    fclose (f);
+}
+
+static bool
+has_source (const SystemloadIrqStat *stat, const gchar *name)
+{
+    for (guint i = 0; i < stat->n_sources; i++)
+        if (strcmp (stat->sources[i].name, name) == 0)
+            return true;
+    return false;
+}
+
+static gint
+next_reading (SystemloadIrqSampler *sampler, SystemloadIrqStat *stat)
+{
+    g_usleep (1000);
+    systemload_procfile_begin_tick ();
+    return read_irqstat (sampler, stat);
+}
+
+/* When a file cannot be read on a tick, the deltas of its previous reading are not counted again */
+static void
+test_unreadable (void)
+{
+    gchar *dir = g_dir_make_tmp ("systemload-irqstat-XXXXXX", NULL);
+    gchar *interrupts = g_build_filename (dir, "interrupts", NULL);
+    gchar *softirqs = g_build_filename (dir, "softirqs", NULL);
+    SystemloadIrqStat stat;
+
+    write_file (interrupts, INTERRUPTS_1);
+    write_file (softirqs, SOFTIRQS_HEADER "          HI:          0          0          0\n      NET_RX:        100         50         10\n");
+    SystemloadIrqSampler *sampler = systemload_irq_sampler_new ();
+    sampler->interrupts.file = systemload_procfile_open (interrupts);
+    sampler->softirqs.file = systemload_procfile_open (softirqs);
+    CHECK (next_reading (sampler, &stat) == 0 && stat.rate == 0);
+
+    write_file (interrupts, INTERRUPTS_2);
+    write_file (softirqs, SOFTIRQS_HEADER "          HI:          0          0          0\n      NET_RX:        200         50         10\n");
+    CHECK (next_reading (sampler, &stat) == 0);
+    CHECK (has_source (&stat, "24 nvme0q1") && has_source (&stat, "NET_RX"));
+
+    /* A directory cannot be read */
+    systemload_procfile_close (sampler->softirqs.file);
+    sampler->softirqs.file = systemload_procfile_open (dir);
+    write_file (interrupts, INTERRUPTS_1);
+    CHECK (next_reading (sampler, &stat) == 0);
+    CHECK (!has_source (&stat, "NET_RX"));
+
+    /* The counts from before are too old to be compared with */
+    systemload_procfile_close (sampler->softirqs.file);
+    sampler->softirqs.file = systemload_procfile_open (softirqs);
+    write_file (softirqs, SOFTIRQS_HEADER "          HI:          0          0          0\n      NET_RX:        300         50         10\n");
+    CHECK (next_reading (sampler, &stat) == 0);
+    CHECK (!has_source (&stat, "NET_RX"));
+
+    write_file (softirqs, SOFTIRQS_HEADER "          HI:          0          0          0\n      NET_RX:        400         50         10\n");
+    CHECK (next_reading (sampler, &stat) == 0);
+    CHECK (has_source (&stat, "NET_RX"));
+
+    systemload_irq_sampler_free (sampler);
+    g_unlink (interrupts);
+    g_unlink (softirqs);
+    g_rmdir (dir);
+    g_free (interrupts);
+    g_free (softirqs);
+    g_free (dir);
+}
+
+int
+main (int argc, char **argv)
+{
+    test_layout ();
+    test_truncated ();
+    test_unreadable ();
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Soak test of the libgtop path of read_netload(): the interface list used to be leaked on every
+ * update, so many updates must not grow the heap. The procfs path is disabled by replaying a capture
+ * without any files, so that /proc/net/dev cannot be opened.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "panel-plugin/network.h"
+#include "panel-plugin/procfile.h"
+
+#define N_TICKS 100000
+#define WARMUP_TICKS 1000
+
+/* Leaking the list of a loopback and one other interface costs more than a hundred bytes per update */
+#define MAX_HEAP_GROWTH (64 * 1024)
+
+/* The exit status of a skipped automake test */
+#define EXIT_SKIP 77
+
+int
+main (int argc, char **argv)
+{
+#ifdef HAVE_MALLINFO2
+    gchar *capture = g_build_filename (g_get_tmp_dir (), "test-netload-soak.capture", NULL);
+    if (!g_file_set_contents (capture, "SLCAPT01", 8, NULL))
+    {
+        g_printerr ("Cannot write '%s'\n", capture);
+        return 1;
+    }
+    g_setenv ("SYSTEMLOAD_REPLAY", capture, TRUE);
+    g_setenv ("SYSTEMLOAD_REPLAY_SPEED", "0", TRUE);
+
+    SystemloadNetSampler *sampler = systemload_net_sampler_new (NULL);
+    set_netload_filter (sampler, "*", NULL);
+
+    gsize heap = 0;
+    for (guint tick = 0; tick < WARMUP_TICKS + N_TICKS; tick++)
+    {
+        gulong net, bits;
+
+        if (tick == WARMUP_TICKS)
+            heap = mallinfo2 ().uordblks;
+
+        systemload_procfile_begin_tick ();
+        if (read_netload (sampler, &net, &bits) != 0)
+        {
+            g_printerr ("read_netload() failed in tick %u\n", tick);
+            return 1;
+        }
+    }
+
+    const gssize growth = (gssize) mallinfo2 ().uordblks - (gssize) heap;
+    printf ("heap growth after %u updates: %" G_GSSIZE_FORMAT " bytes\n", N_TICKS, growth);
+
+    systemload_net_sampler_free (sampler);
+    g_unlink (capture);
+    g_free (capture);
+
+    return growth > MAX_HEAP_GROWTH ? 1 : 0;
+#else
+    printf ("mallinfo2() is not available, skipped\n");
+    return EXIT_SKIP;
+#endif
+}
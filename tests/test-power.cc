@@ -0,0 +1,368 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Tests the state transitions of SystemloadPower and the update interval derived from them.
+ * Stand-ins of power-profiles-daemon and, when built with UPower, of the UPower daemon run on
+ * a private bus which is used as the system bus. They run in their own thread, so that the
+ * synchronous calls made by upower-glib are answered while the test waits for them.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <gio/gio.h>
+
+#include "panel-plugin/power.h"
+
+/* How long to wait for a notification which is expected, and for one which is not */
+#define TIMEOUT (5 * G_USEC_PER_SEC)
+#define QUIET_TIME (200 * 1000)
+
+/* The exit status of a skipped automake test */
+#define EXIT_SKIP 77
+
+#define PROFILES_NAME "net.hadess.PowerProfiles"
+#define PROFILES_PATH "/net/hadess/PowerProfiles"
+
+#define UPOWER_NAME "org.freedesktop.UPower"
+#define UPOWER_PATH "/org/freedesktop/UPower"
+#define DISPLAY_DEVICE_PATH "/org/freedesktop/UPower/devices/DisplayDevice"
+
+/* UP_DEVICE_LEVEL_LOW */
+#define WARNING_LEVEL_LOW 3
+
+static const gchar SERVICES_XML[] =
+    "<node>"
+    "  <interface name='net.hadess.PowerProfiles'>"
+    "    <property name='ActiveProfile' type='s' access='readwrite'/>"
+    "    <property name='PerformanceDegraded' type='s' access='read'/>"
+    "  </interface>"
+    "  <interface name='org.freedesktop.UPower'>"
+    "    <method name='GetDisplayDevice'><arg name='device' type='o' direction='out'/></method>"
+    "    <method name='EnumerateDevices'><arg name='devices' type='ao' direction='out'/></method>"
+    "    <method name='GetCriticalAction'><arg name='action' type='s' direction='out'/></method>"
+    "    <property name='DaemonVersion' type='s' access='read'/>"
+    "    <property name='OnBattery' type='b' access='read'/>"
+    "    <property name='LidIsClosed' type='b' access='read'/>"
+    "    <property name='LidIsPresent' type='b' access='read'/>"
+    "  </interface>"
+    "  <interface name='org.freedesktop.UPower.Device'>"
+    "    <property name='Type' type='u' access='read'/>"
+    "    <property name='IsPresent' type='b' access='read'/>"
+    "    <property name='Percentage' type='d' access='read'/>"
+    "    <property name='WarningLevel' type='u' access='read'/>"
+    "  </interface>"
+    "</node>";
+
+/* The properties of the stand-ins, by name. They are only accessed with the lock held. */
+struct t_services {
+    const gchar     *address;
+    GDBusConnection *connection;
+    GDBusNodeInfo   *info;
+    GMainContext    *context;
+    GMainLoop       *loop;
+    GThread         *thread;
+    GMutex           lock;
+    GHashTable      *properties;
+    gint             ready;
+};
+
+static guint notifications;
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+static GVariant *
+get_property_cb (GDBusConnection *connection, const gchar *sender, const gchar *path, const gchar *interface,
+                 const gchar *name, GError **error, gpointer user_data)
+{
+    auto services = (t_services*) user_data;
+
+    g_mutex_lock (&services->lock);
+    auto value = (GVariant*) g_hash_table_lookup (services->properties, name);
+    if (value)
+        g_variant_ref (value);
+    g_mutex_unlock (&services->lock);
+
+    if (!value)
+        g_set_error (error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_PROPERTY, "No property %s", name);
+    return value;
+}
+
+static void
+method_call_cb (GDBusConnection *connection, const gchar *sender, const gchar *path, const gchar *interface,
+                const gchar *method, GVariant *parameters, GDBusMethodInvocation *invocation, gpointer user_data)
+{
+    if (g_strcmp0 (method, "GetDisplayDevice") == 0)
+        g_dbus_method_invocation_return_value (invocation, g_variant_new ("(o)", DISPLAY_DEVICE_PATH));
+    else if (g_strcmp0 (method, "EnumerateDevices") == 0)
+        g_dbus_method_invocation_return_value (invocation, g_variant_new_parsed ("(@ao [],)"));
+    else if (g_strcmp0 (method, "GetCriticalAction") == 0)
+        g_dbus_method_invocation_return_value (invocation, g_variant_new ("(s)", "PowerOff"));
+    else
+        g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD, "No method %s", method);
+}
+
+static const GDBusInterfaceVTable VTABLE = { method_call_cb, get_property_cb, NULL, { NULL } };
+
+static void
+register_object (t_services *services, const gchar *path, const gchar *interface)
+{
+    GError *error = NULL;
+    if (!g_dbus_connection_register_object (services->connection, path,
+                                            g_dbus_node_info_lookup_interface (services->info, interface),
+                                            &VTABLE, services, NULL, &error))
+    {
+        g_printerr ("Cannot register %s: %s\n", path, error->message);
+        g_error_free (error);
+        failures++;
+    }
+}
+
+static void
+request_name (t_services *services, const gchar *name)
+{
+    GVariant *reply = g_dbus_connection_call_sync (services->connection, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+                                                   "org.freedesktop.DBus", "RequestName", g_variant_new ("(su)", name, 4),
+                                                   NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL);
+    if (reply)
+        g_variant_unref (reply);
+    else
+        failures++;
+}
+
+static void
+release_name (t_services *services, const gchar *name)
+{
+    GVariant *reply = g_dbus_connection_call_sync (services->connection, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+                                                   "org.freedesktop.DBus", "ReleaseName", g_variant_new ("(s)", name),
+                                                   NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL);
+    if (reply)
+        g_variant_unref (reply);
+}
+
+static gpointer
+services_thread (gpointer user_data)
+{
+    auto services = (t_services*) user_data;
+
+    g_main_context_push_thread_default (services->context);
+    services->connection = g_dbus_connection_new_for_address_sync (
+        services->address,
+        (GDBusConnectionFlags) (G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION),
+        NULL, NULL, NULL);
+    if (services->connection)
+    {
+        register_object (services, PROFILES_PATH, PROFILES_NAME);
+        register_object (services, UPOWER_PATH, UPOWER_NAME);
+        register_object (services, DISPLAY_DEVICE_PATH, "org.freedesktop.UPower.Device");
+        request_name (services, PROFILES_NAME);
+        request_name (services, UPOWER_NAME);
+    }
+    else
+        failures++;
+
+    g_atomic_int_set (&services->ready, 1);
+    g_main_loop_run (services->loop);
+    g_main_context_pop_thread_default (services->context);
+    return NULL;
+}
+
+static void
+set_property (t_services *services, const gchar *path, const gchar *interface, const gchar *name, GVariant *value)
+{
+    g_variant_ref_sink (value);
+    g_mutex_lock (&services->lock);
+    g_hash_table_replace (services->properties, g_strdup (name), g_variant_ref (value));
+    g_mutex_unlock (&services->lock);
+
+    GVariantBuilder changed;
+    g_variant_builder_init (&changed, G_VARIANT_TYPE ("a{sv}"));
+    g_variant_builder_add (&changed, "{sv}", name, value);
+    g_dbus_connection_emit_signal (services->connection, NULL, path, "org.freedesktop.DBus.Properties", "PropertiesChanged",
+                                   g_variant_new ("(sa{sv}as)", interface, &changed, NULL), NULL);
+    g_variant_unref (value);
+}
+
+static void
+power_changed_cb (gpointer user_data)
+{
+    notifications++;
+}
+
+/* Runs the main loop until there were the given number of notifications, and then a little longer to catch extra ones */
+static void
+wait_for_notifications (guint expected)
+{
+    const gint64 end = g_get_monotonic_time () + TIMEOUT;
+
+    while (notifications < expected && g_get_monotonic_time () < end)
+        if (!g_main_context_iteration (NULL, FALSE))
+            g_usleep (1000);
+
+    const gint64 quiet_end = g_get_monotonic_time () + QUIET_TIME;
+    while (g_get_monotonic_time () < quiet_end)
+        if (!g_main_context_iteration (NULL, FALSE))
+            g_usleep (1000);
+
+    if (notifications != expected)
+    {
+        g_printerr ("%u notifications instead of %u\n", notifications, expected);
+        failures++;
+    }
+}
+
+/* The interval of a policy with a 1 s interval on AC, 5 s on battery, the default multipliers and a power-saver multiplier of 2 */
+static guint
+get_interval (const SystemloadPower *power, bool battery_interval)
+{
+    static const guint multipliers[N_POWER_STATES] = { 1, 1, 4 };
+    return systemload_power_get_interval (power, 1000, battery_interval ? 5000 : 0, multipliers, 2);
+}
+
+int
+main (int argc, char **argv)
+{
+    GTestDBus *bus = g_test_dbus_new (G_TEST_DBUS_NONE);
+    g_test_dbus_up (bus);
+    if (!g_test_dbus_get_bus_address (bus))
+    {
+        printf ("Cannot start a private bus, skipped\n");
+        return EXIT_SKIP;
+    }
+
+    t_services services = {};
+    services.address = g_test_dbus_get_bus_address (bus);
+    services.context = g_main_context_new ();
+    services.loop = g_main_loop_new (services.context, FALSE);
+    services.info = g_dbus_node_info_new_for_xml (SERVICES_XML, NULL);
+    services.properties = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_variant_unref);
+    g_mutex_init (&services.lock);
+
+    const struct { const gchar *name; GVariant *value; } initial[] = {
+        { "ActiveProfile", g_variant_new_string ("balanced") },
+        { "PerformanceDegraded", g_variant_new_string ("") },
+        { "DaemonVersion", g_variant_new_string ("1.90.0") },
+        { "OnBattery", g_variant_new_boolean (FALSE) },
+        { "LidIsClosed", g_variant_new_boolean (FALSE) },
+        { "LidIsPresent", g_variant_new_boolean (TRUE) },
+        { "Type", g_variant_new_uint32 (2) },
+        { "IsPresent", g_variant_new_boolean (TRUE) },
+        { "Percentage", g_variant_new_double (80) },
+        { "WarningLevel", g_variant_new_uint32 (1) },
+    };
+    for (gsize i = 0; i < G_N_ELEMENTS (initial); i++)
+        g_hash_table_insert (services.properties, g_strdup (initial[i].name), g_variant_ref_sink (initial[i].value));
+
+    /* The plugin uses the system bus */
+    g_setenv ("DBUS_SYSTEM_BUS_ADDRESS", services.address, TRUE);
+    services.thread = g_thread_new ("services", services_thread, &services);
+    while (!g_atomic_int_get (&services.ready))
+        g_usleep (1000);
+
+    SystemloadPower *power = systemload_power_new (power_changed_cb, NULL);
+    CHECK (systemload_power_get_state (power) == POWER_STATE_AC);
+    CHECK (get_interval (power, true) == 1000);
+
+    /* The profile proxy is created asynchronously, a change is noticed either way */
+    set_property (&services, PROFILES_PATH, PROFILES_NAME, "ActiveProfile", g_variant_new_string ("power-saver"));
+    wait_for_notifications (1);
+    CHECK (systemload_power_get_power_saver (power));
+    CHECK (get_interval (power, true) == 2000);
+
+    /* Properties which do not change the state are not notified */
+    set_property (&services, PROFILES_PATH, PROFILES_NAME, "PerformanceDegraded", g_variant_new_string ("lap-detected"));
+    wait_for_notifications (1);
+
+    set_property (&services, PROFILES_PATH, PROFILES_NAME, "ActiveProfile", g_variant_new_string ("balanced"));
+    wait_for_notifications (2);
+    CHECK (!systemload_power_get_power_saver (power));
+    CHECK (get_interval (power, true) == 1000);
+
+#ifdef HAVE_UPOWER_GLIB
+    set_property (&services, UPOWER_PATH, UPOWER_NAME, "OnBattery", g_variant_new_boolean (TRUE));
+    wait_for_notifications (3);
+    CHECK (systemload_power_get_state (power) == POWER_STATE_BATTERY);
+    CHECK (get_interval (power, true) == 5000);
+    CHECK (get_interval (power, false) == 1000);
+
+    set_property (&services, DISPLAY_DEVICE_PATH, "org.freedesktop.UPower.Device", "Percentage", g_variant_new_double (79));
+    wait_for_notifications (3);
+
+    /* With the lid closed, the updates only stop if the battery interval is used */
+    set_property (&services, UPOWER_PATH, UPOWER_NAME, "LidIsClosed", g_variant_new_boolean (TRUE));
+    wait_for_notifications (4);
+    CHECK (systemload_power_get_lid_closed (power));
+    CHECK (get_interval (power, true) == 0);
+    CHECK (get_interval (power, false) == 1000);
+
+    set_property (&services, UPOWER_PATH, UPOWER_NAME, "LidIsClosed", g_variant_new_boolean (FALSE));
+    wait_for_notifications (5);
+
+    set_property (&services, DISPLAY_DEVICE_PATH, "org.freedesktop.UPower.Device", "WarningLevel", g_variant_new_uint32 (WARNING_LEVEL_LOW));
+    wait_for_notifications (6);
+    CHECK (systemload_power_get_state (power) == POWER_STATE_LOW_BATTERY);
+    CHECK (get_interval (power, true) == 20000);
+
+    set_property (&services, UPOWER_PATH, UPOWER_NAME, "OnBattery", g_variant_new_boolean (FALSE));
+    wait_for_notifications (7);
+    CHECK (systemload_power_get_state (power) == POWER_STATE_AC);
+    CHECK (get_interval (power, true) == 1000);
+    const guint n = 7;
+#else
+    const guint n = 2;
+#endif
+
+    /* When the daemon exits while the power-saver profile is active, the profile is forgotten */
+    set_property (&services, PROFILES_PATH, PROFILES_NAME, "ActiveProfile", g_variant_new_string ("power-saver"));
+    wait_for_notifications (n + 1);
+    release_name (&services, PROFILES_NAME);
+    wait_for_notifications (n + 2);
+    CHECK (!systemload_power_get_power_saver (power));
+
+    systemload_power_free (power);
+    g_main_loop_quit (services.loop);
+    g_thread_join (services.thread);
+    g_object_unref (services.connection);
+    g_test_dbus_down (bus);
+    g_object_unref (bus);
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
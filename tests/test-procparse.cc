@@ -0,0 +1,237 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Differential test of systemload_parse_uints(), systemload_parse_uints_wide() and
+ * systemload_find_eol() against a parser built on strtoull(), for every implementation the CPU
+ * supports and for the one selected at runtime. The inputs are random lines with numbers and
+ * separators of all kinds, and /proc/stat files of 0 to 1024 CPUs.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include "panel-plugin/procfile.h"
+#include "panel-plugin/procparse.h"
+
+#define N_RANDOM_LINES 50000
+#define MAX_FIELDS 256
+
+static const gchar *const IMPLS[] = { "scalar", "sse2", "avx2", "auto" };
+
+static guint failures;
+
+/* The reference: every maximal run of digits is a number */
+static guint
+reference_parse_uints (const gchar *s, guint64 *fields, guint max, const gchar **next)
+{
+    guint n = 0;
+
+    while (*s != '\n' && *s != '\0')
+    {
+        if ((guchar) (*s - '0') > 9)
+        {
+            s++;
+            continue;
+        }
+        gchar *end;
+        const guint64 value = strtoull (s, &end, 10);
+        if (n < max)
+            fields[n++] = value;
+        s = end;
+    }
+
+    if (next)
+        *next = (*s == '\n') ? s + 1 : s;
+    return n;
+}
+
+/* Copies the text into a buffer which is padded like the ones of procfile.h, with digits and line ends */
+static gchar *
+padded_copy (const gchar *text, gsize length)
+{
+    gchar *buf = (gchar*) g_malloc (length + 1 + SYSTEMLOAD_PROCFILE_PADDING);
+    memcpy (buf, text, length);
+    buf[length] = '\0';
+    for (guint i = 0; i < SYSTEMLOAD_PROCFILE_PADDING; i++)
+        buf[length + 1 + i] = "1\n 9"[i % 4];
+    return buf;
+}
+
+/* Parses every line of buf with both parsers and reports the first difference */
+static void
+compare (const gchar *impl, const gchar *buf, guint max)
+{
+    guint64 fields[MAX_FIELDS], expected[MAX_FIELDS];
+    const gchar *line = buf;
+
+    while (*line)
+    {
+        const gchar *next, *expected_next;
+        const guint n = systemload_parse_uints (line, fields, max, &next);
+        const guint expected_n = reference_parse_uints (line, expected, max, &expected_next);
+        const gchar *eol = systemload_find_eol (line);
+
+        bool equal = n == expected_n && next == expected_next && eol + (*eol == '\n') == expected_next;
+        for (guint i = 0; equal && i < n; i++)
+            equal = fields[i] == expected[i];
+
+        const gchar *wide_next;
+        equal = equal && systemload_parse_uints_wide (line, fields, max, &wide_next) == expected_n && wide_next == expected_next;
+        for (guint i = 0; equal && i < n; i++)
+            equal = fields[i] == expected[i];
+        if (!equal)
+        {
+            g_printerr ("%s: line at offset %ld, max %u: %u fields instead of %u or different values, next at %ld instead of %ld\n",
+                        impl, (glong) (line - buf), max, n, expected_n,
+                        (glong) (next - buf), (glong) (expected_next - buf));
+            failures++;
+            return;
+        }
+        line = next;
+    }
+}
+
+/* A number of up to 19 digits, which cannot overflow, sometimes with leading zeros */
+static void
+append_number (GString *text)
+{
+    switch (g_random_int_range (0, 4))
+    {
+        case 0:
+            g_string_append_printf (text, "%u", g_random_int_range (0, 10));
+            break;
+        case 1:
+            g_string_append_printf (text, "%u", g_random_int ());
+            break;
+        case 2:
+            g_string_append_printf (text, "%" G_GUINT64_FORMAT,
+                                    (((guint64) g_random_int () << 32) | g_random_int ()) % G_GUINT64_CONSTANT (10000000000000000000));
+            break;
+        default:
+            for (gint i = g_random_int_range (1, 100); i > 0; i--)
+                g_string_append_c (text, '0');
+            g_string_append_printf (text, "%u", g_random_int ());
+            break;
+    }
+}
+
+static void
+append_separator (GString *text)
+{
+    static const gchar SEPARATORS[] = " \t:-.abcxyz/\x7f\x80\xb9\xff";
+
+    for (gint i = g_random_int_range (1, 4); i > 0; i--)
+        g_string_append_c (text, SEPARATORS[g_random_int_range (0, sizeof (SEPARATORS) - 1)]);
+    /* Long runs of separators span the 64-byte blocks */
+    if (g_random_int_range (0, 20) == 0)
+        for (gint i = g_random_int_range (1, 200); i > 0; i--)
+            g_string_append_c (text, ' ');
+}
+
+static void
+test_random_lines (const gchar *impl)
+{
+    GString *text = g_string_new (NULL);
+
+    for (guint line = 0; line < N_RANDOM_LINES; line++)
+    {
+        if (g_random_boolean ())
+            append_separator (text);
+        for (gint i = g_random_int_range (0, 40); i > 0; i--)
+        {
+            append_number (text);
+            if (i > 1 || g_random_boolean ())
+                append_separator (text);
+        }
+        /* The last line is sometimes not terminated */
+        if (line + 1 < N_RANDOM_LINES || g_random_boolean ())
+            g_string_append_c (text, '\n');
+    }
+
+    const guint maxima[] = { 0, 1, 3, 8, MAX_FIELDS };
+    gchar *buf = padded_copy (text->str, text->len);
+    for (guint i = 0; i < G_N_ELEMENTS (maxima); i++)
+        compare (impl, buf, maxima[i]);
+    g_free (buf);
+    g_string_free (text, TRUE);
+}
+
+static void
+test_proc_stat (const gchar *impl)
+{
+    for (guint n_cpus = 0; n_cpus <= 1024; n_cpus = n_cpus < 16 ? n_cpus + 1 : n_cpus * 2)
+    {
+        GString *text = g_string_new (NULL);
+        for (gint cpu = -1; cpu < (gint) n_cpus; cpu++)
+        {
+            if (cpu < 0)
+                g_string_append (text, "cpu ");
+            else
+                g_string_append_printf (text, "cpu%d", cpu);
+            for (guint i = 0; i < 10; i++)
+                g_string_append_printf (text, " %u", g_random_int () >> g_random_int_range (0, 32));
+            g_string_append_c (text, '\n');
+        }
+        g_string_append (text, "intr 123456789 0 9 0 0\nctxt 987654321\nbtime 1700000000\n");
+
+        gchar *buf = padded_copy (text->str, text->len);
+        compare (impl, buf, MAX_FIELDS);
+        compare (impl, buf, 4);
+        g_free (buf);
+        g_string_free (text, TRUE);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    guint tested = 0;
+
+    for (guint i = 0; i < G_N_ELEMENTS (IMPLS); i++)
+    {
+        if (!systemload_parse_set_impl (IMPLS[i]))
+        {
+            printf ("%s: not supported, skipped\n", IMPLS[i]);
+            continue;
+        }
+        test_random_lines (IMPLS[i]);
+        test_proc_stat (IMPLS[i]);
+        printf ("%s: %s\n", IMPLS[i], failures ? "FAILED" : "ok");
+        tested++;
+    }
+
+    return (failures || tested == 0) ? 1 : 0;
+}
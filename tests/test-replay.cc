@@ -0,0 +1,139 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Replays a capture of three appended recording sessions. Each session numbers its paths
+ * from 0 in the order the files were first read, so the same id names different files in
+ * different sessions, and a file which a session does not read has no contents in it.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <glib.h>
+
+#include "panel-plugin/procfile.h"
+#include "tests/capture-writer.h"
+
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+static bool
+read_equals (SystemloadProcFile *file, const gchar *expected)
+{
+    const gchar *contents = systemload_procfile_read (file, NULL);
+    if (expected == NULL)
+        return contents == NULL;
+    return contents != NULL && strcmp (contents, expected) == 0;
+}
+
+int
+main (int argc, char **argv)
+{
+    GString *capture = g_string_new (NULL);
+
+    capture_writer_begin_session (capture);
+    capture_writer_path (capture, 0, "/proc/stat");
+    capture_writer_path (capture, 1, "/proc/meminfo");
+    capture_writer_tick (capture, 1000);
+    capture_writer_contents (capture, 0, "stat 1\n");
+    capture_writer_contents (capture, 1, "meminfo 1\n");
+    capture_writer_tick (capture, 2000);
+    capture_writer_unchanged (capture, 0);
+    capture_writer_contents (capture, 1, "meminfo 2\n");
+
+    /* Another run of the plugin, which read the files in the other order */
+    capture_writer_begin_session (capture);
+    capture_writer_path (capture, 0, "/proc/meminfo");
+    capture_writer_path (capture, 1, "/proc/stat");
+    capture_writer_tick (capture, 50);
+    capture_writer_contents (capture, 0, "meminfo 3\n");
+    capture_writer_contents (capture, 1, "stat 3\n");
+    capture_writer_tick (capture, 60);
+    capture_writer_contents (capture, 0, "meminfo 4\n");
+    capture_writer_unchanged (capture, 1);
+
+    /* A run which did not read /proc/meminfo */
+    capture_writer_begin_session (capture);
+    capture_writer_path (capture, 0, "/proc/stat");
+    capture_writer_tick (capture, 10);
+    capture_writer_contents (capture, 0, "stat 5\n");
+
+    gchar *filename = capture_writer_replay (capture);
+    g_string_free (capture, TRUE);
+
+    SystemloadProcFile *stat = systemload_procfile_open ("/proc/stat");
+    SystemloadProcFile *meminfo = systemload_procfile_open ("/proc/meminfo");
+    CHECK (systemload_procfile_is_replaying ());
+    CHECK (stat != NULL && meminfo != NULL);
+    CHECK (systemload_procfile_open ("/proc/vmstat") == NULL);
+    if (stat == NULL || meminfo == NULL)
+    {
+        capture_writer_remove (filename);
+        printf ("FAILED\n");
+        return 1;
+    }
+
+    static const struct {
+        gint64       time;
+        const gchar *stat;
+        const gchar *meminfo;
+    } ticks[] = {
+        { 1000, "stat 1\n", "meminfo 1\n" },
+        { 2000, "stat 1\n", "meminfo 2\n" },
+        {   50, "stat 3\n", "meminfo 3\n" },
+        {   60, "stat 3\n", "meminfo 4\n" },
+        {   10, "stat 5\n", NULL },
+    };
+    for (guint i = 0; i < G_N_ELEMENTS (ticks); i++)
+    {
+        systemload_procfile_begin_tick ();
+        CHECK (systemload_procfile_get_time () == ticks[i].time);
+        CHECK (read_equals (stat, ticks[i].stat));
+        CHECK (read_equals (meminfo, ticks[i].meminfo));
+    }
+
+    systemload_procfile_close (stat);
+    systemload_procfile_close (meminfo);
+    capture_writer_remove (filename);
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Replays /proc/schedstat files to read_schedstat(): run_delay and pcount are taken from their
+ * columns of the cpu lines, the domain lines are skipped, the busiest CPUs are sorted, and the
+ * versions before 15 are refused while later ones, which append columns, are read.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <glib.h>
+
+#include "panel-plugin/procfile.h"
+#include "panel-plugin/schedstat.h"
+#include "tests/capture-writer.h"
+
+#define N_CPUS 6
+
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+/*
+ * CPU c has waited n × (c + 1) ms in n × 100 timeslices, and the other columns hold
+ * numbers which would be taken for them if the columns were shifted
+ */
+static gchar *
+schedstat_text (guint version, guint n, const gchar *extra_columns)
+{
+    GString *text = g_string_new (NULL);
+    g_string_append_printf (text, "version %u\ntimestamp 4295000000\n", version);
+    for (guint cpu = 0; cpu < N_CPUS; cpu++)
+    {
+        g_string_append_printf (text, "cpu%u 0 0 %u %u %u %u %u %" G_GUINT64_FORMAT " %u%s\n",
+                                cpu, 7777 * n, 3333 * n, 5555 * n, 1111 * n, 999999 * n,
+                                (guint64) n * (cpu + 1) * 1000000, n * 100, extra_columns);
+        g_string_append (text, "domain0 00000000,00000003 4 3 2 1 0 0 0 0 9 8 7 6 5 4 3 2 1 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0\n");
+    }
+    return g_string_free (text, FALSE);
+}
+
+static void
+add_tick (GString *capture, gint64 seconds, guint version, guint n, const gchar *extra_columns)
+{
+    gchar *text = schedstat_text (version, n, extra_columns);
+    capture_writer_tick (capture, seconds * G_USEC_PER_SEC);
+    capture_writer_contents (capture, 0, text);
+    g_free (text);
+}
+
+static gint
+next_reading (SystemloadSchedstatSampler *sampler, SystemloadSchedstat *stat)
+{
+    systemload_procfile_begin_tick ();
+    return read_schedstat (sampler, stat);
+}
+
+int
+main (int argc, char **argv)
+{
+    GString *capture = g_string_new (NULL);
+    capture_writer_begin_session (capture);
+    capture_writer_path (capture, 0, "/proc/schedstat");
+    add_tick (capture, 1, 15, 1, "");
+    add_tick (capture, 2, 15, 2, "");
+    add_tick (capture, 3, 15, 2, "");
+
+    capture_writer_begin_session (capture);
+    capture_writer_path (capture, 0, "/proc/schedstat");
+    add_tick (capture, 1, 14, 1, "");
+    add_tick (capture, 2, 14, 2, "");
+
+    capture_writer_begin_session (capture);
+    capture_writer_path (capture, 0, "/proc/schedstat");
+    add_tick (capture, 1, 17, 1, " 123 456");
+    add_tick (capture, 3, 17, 3, " 123 456");
+    gchar *filename = capture_writer_replay (capture);
+    g_string_free (capture, TRUE);
+
+    SystemloadSchedstatSampler *sampler = systemload_schedstat_sampler_new ();
+    SystemloadSchedstat stat;
+
+    CHECK (next_reading (sampler, &stat) == 0);
+    CHECK (stat.n_cpus == 0 && stat.wait == 0);
+
+    /* 21 ms in 600 timeslices */
+    CHECK (next_reading (sampler, &stat) == 0);
+    CHECK (stat.wait == 35 && stat.wait_rate == 21);
+    CHECK (stat.n_cpus == SCHEDSTAT_TOP_N);
+    for (guint i = 0; i < stat.n_cpus; i++)
+    {
+        CHECK (stat.cpus[i].cpu == N_CPUS - 1 - i);
+        CHECK (stat.cpus[i].wait == 10 * (N_CPUS - i) && stat.cpus[i].wait_rate == N_CPUS - i);
+    }
+
+    /* No timeslices */
+    CHECK (next_reading (sampler, &stat) == 0);
+    CHECK (stat.n_cpus == 0 && stat.wait == 0 && stat.wait_rate == 0);
+    systemload_schedstat_sampler_free (sampler);
+
+    sampler = systemload_schedstat_sampler_new ();
+    CHECK (next_reading (sampler, &stat) == -1);
+    CHECK (next_reading (sampler, &stat) == -1);
+    systemload_schedstat_sampler_free (sampler);
+
+    /* Over 2 seconds */
+    sampler = systemload_schedstat_sampler_new ();
+    CHECK (next_reading (sampler, &stat) == 0);
+    CHECK (next_reading (sampler, &stat) == 0);
+    CHECK (stat.wait == 35 && stat.wait_rate == 21);
+    CHECK (stat.n_cpus == SCHEDSTAT_TOP_N && stat.cpus[0].cpu == N_CPUS - 1 && stat.cpus[0].wait == 10 * N_CPUS);
+    systemload_schedstat_sampler_free (sampler);
+
+    capture_writer_remove (filename);
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
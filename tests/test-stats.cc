@@ -0,0 +1,176 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Differential test of SystemloadStats against a copy of the window which is searched and
+ * sorted on every sample: the minimum and maximum as samples leave the window, and the
+ * nearest-rank percentiles including 0, 1, 99 and 100, for windows of 1 to 300 samples.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include "panel-plugin/stats.h"
+
+#define N_SAMPLES 2000
+
+static const guint WINDOWS[] = { 1, 2, 3, 7, 60, 300 };
+static const guint PERCENTILES[] = { 0, 1, 2, 25, 50, 75, 98, 99, 100, 150 };
+
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+static gint
+compare_values (gconstpointer a, gconstpointer b)
+{
+    return (gint) *(const gulong*) a - (gint) *(const gulong*) b;
+}
+
+/* The smallest value which at least percentile% of the samples do not exceed */
+static gulong
+reference_percentile (const gulong *sorted, guint count, guint percentile)
+{
+    guint rank = (count * MIN (percentile, 100) + 99) / 100;
+    return sorted[MAX (rank, 1) - 1];
+}
+
+/* Runs of rising and falling values, so that the minimum and the maximum leave the window often */
+static gulong
+next_value (guint i)
+{
+    switch (g_random_int_range (0, 4))
+    {
+        case 0:  return g_random_int_range (0, 101);
+        case 1:  return i % 101;
+        case 2:  return 100 - i % 101;
+        default: return g_random_int_range (95, 200);  /* Clamped to 100 */
+    }
+}
+
+static void
+test_window (guint window)
+{
+    SystemloadStats *stats = systemload_stats_new (window, 0);
+    gulong *recent = g_new (gulong, window);
+    gulong *sorted = g_new (gulong, window);
+
+    CHECK (systemload_stats_get_window (stats) == window);
+    CHECK (systemload_stats_get_min (stats) == 0 && systemload_stats_get_max (stats) == 0);
+    CHECK (systemload_stats_get_percentile (stats, 50) == 0);
+
+    for (guint i = 0; i < N_SAMPLES; i++)
+    {
+        const gulong value = next_value (i);
+        systemload_stats_add (stats, value);
+        recent[i % window] = MIN (value, 100);
+
+        const guint count = MIN (i + 1, window);
+        memcpy (sorted, recent, count * sizeof (*sorted));
+        qsort (sorted, count, sizeof (*sorted), compare_values);
+
+        bool equal = systemload_stats_get_min (stats) == sorted[0] && systemload_stats_get_max (stats) == sorted[count - 1];
+        for (guint p = 0; equal && p < G_N_ELEMENTS (PERCENTILES); p++)
+            equal = systemload_stats_get_percentile (stats, PERCENTILES[p]) == reference_percentile (sorted, count, PERCENTILES[p]);
+
+        /* Without a half-life, the average is the last sample */
+        equal = equal && systemload_stats_get_average (stats) == MIN (value, 100);
+        if (!equal)
+        {
+            g_printerr ("window %u, sample %u: min %lu, max %lu, median %lu instead of %lu, %lu, %lu\n", window, i,
+                        systemload_stats_get_min (stats), systemload_stats_get_max (stats),
+                        systemload_stats_get_percentile (stats, 50),
+                        sorted[0], sorted[count - 1], reference_percentile (sorted, count, 50));
+            failures++;
+            break;
+        }
+    }
+
+    g_free (sorted);
+    g_free (recent);
+    systemload_stats_free (stats);
+}
+
+static void
+test_edges (void)
+{
+    SystemloadStats *stats = systemload_stats_new (4, 1);
+
+    /* 0th and 1st percentiles are the minimum, the 100th is the maximum */
+    const gulong values[] = { 40, 10, 30, 20 };
+    for (guint i = 0; i < G_N_ELEMENTS (values); i++)
+        systemload_stats_add (stats, values[i]);
+    CHECK (systemload_stats_get_percentile (stats, 0) == 10);
+    CHECK (systemload_stats_get_percentile (stats, 1) == 10);
+    CHECK (systemload_stats_get_percentile (stats, 25) == 10);
+    CHECK (systemload_stats_get_percentile (stats, 26) == 20);
+    CHECK (systemload_stats_get_percentile (stats, 50) == 20);
+    CHECK (systemload_stats_get_percentile (stats, 51) == 30);
+    CHECK (systemload_stats_get_percentile (stats, 100) == 40);
+
+    /* 40 and 10 leave the window */
+    systemload_stats_add (stats, 25);
+    systemload_stats_add (stats, 35);
+    CHECK (systemload_stats_get_min (stats) == 20 && systemload_stats_get_max (stats) == 35);
+
+    /* The weight of a sample is halved with every sample after it */
+    systemload_stats_free (stats);
+    stats = systemload_stats_new (4, 1);
+    systemload_stats_add (stats, 0);
+    systemload_stats_add (stats, 100);
+    CHECK (systemload_stats_get_average (stats) == 50);
+    systemload_stats_add (stats, 100);
+    CHECK (systemload_stats_get_average (stats) == 75);
+    systemload_stats_free (stats);
+}
+
+int
+main (int argc, char **argv)
+{
+    for (guint i = 0; i < G_N_ELEMENTS (WINDOWS); i++)
+        test_window (WINDOWS[i]);
+    test_edges ();
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,190 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Tests the lookup of the columns of /proc/net/snmp and /proc/net/netstat and the reading of
+ * the counters against captured files, and the rates when netstat cannot be read on a tick.
+ * tcpstat.cc is included, so that its static functions are tested directly.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "panel-plugin/tcpstat.cc"
+
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+/* MaxConn is -1 */
+static const gchar SNMP_HEADERS[] =
+    "Ip: Forwarding DefaultTTL InReceives InHdrErrors InAddrErrors ForwDatagrams InUnknownProtos InDiscards InDelivers OutRequests OutDiscards OutNoRoutes ReasmTimeout ReasmReqds ReasmOKs ReasmFails FragOKs FragFails FragCreates OutTransmits\n"
+    "Ip: 2 64 18491 0 0 0 0 0 18491 18453 258 0 0 0 0 0 0 0 0 18453\n"
+    "IcmpMsg: InType3 OutType3\n"
+    "IcmpMsg: 585 580\n"
+    "Tcp: RtoAlgorithm RtoMin RtoMax MaxConn ActiveOpens PassiveOpens AttemptFails EstabResets CurrEstab InSegs OutSegs RetransSegs InErrs OutRsts InCsumErrors\n";
+
+static const gchar SNMP_UDP[] =
+    "Udp: InDatagrams NoPorts InErrors OutDatagrams RcvbufErrors SndbufErrors InCsumErrors IgnoredMulti MemErrors\n"
+    "Udp: 0 580 0 580 0 0 0 0 0\n";
+
+static const gchar NETSTAT_HEADERS[] =
+    "TcpExt: SyncookiesSent SyncookiesRecv SyncookiesFailed EmbryonicRsts DelayedACKs DelayedACKLocked DelayedACKLost ListenOverflows ListenDrops TCPHPHits TCPTimeouts TCPLossProbes\n";
+
+static const gchar NETSTAT_IPEXT[] =
+    "IpExt: InNoRoutes InTruncatedPkts InMcastPkts OutMcastPkts InOctets OutOctets\n"
+    "IpExt: 0 0 0 0 180216466 180214350\n"
+    "MPTcpExt: MPCapableSYNRX MPCapableSYNTX ListenOverflows\n"
+    "MPTcpExt: 0 0 77\n";
+
+static void
+write_file (const gchar *path, const gchar *text)
+{
+    /* In place, as the file stays open in procfile.cc */
+    FILE *f = fopen (path, "w");
+    fputs (text, f);
+    fclose (f);
+}
+
+static void
+write_snmp (const gchar *path, guint64 out_segs, guint64 retrans_segs)
+{
+    gchar *text = g_strdup_printf ("%sTcp: 1 200 120000 -1 40 37 5 40 2 17326 %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT " 0 20 0\n%s",
+                                   SNMP_HEADERS, out_segs, retrans_segs, SNMP_UDP);
+    write_file (path, text);
+    g_free (text);
+}
+
+static void
+write_netstat (const gchar *path, guint64 listen_overflows, guint64 timeouts)
+{
+    gchar *text = g_strdup_printf ("%sTcpExt: 0 0 0 0 15 0 0 %" G_GUINT64_FORMAT " 3 47 %" G_GUINT64_FORMAT " 90\n%s",
+                                   NETSTAT_HEADERS, listen_overflows, timeouts, NETSTAT_IPEXT);
+    write_file (path, text);
+    g_free (text);
+}
+
+static gint
+next_reading (SystemloadTcpSampler *sampler, SystemloadTcpStat *tcp)
+{
+    g_usleep (1000);
+    systemload_procfile_begin_tick ();
+    return read_tcpstat (sampler, tcp);
+}
+
+int
+main (int argc, char **argv)
+{
+    gchar *dir = g_dir_make_tmp ("systemload-tcpstat-XXXXXX", NULL);
+    gchar *snmp = g_build_filename (dir, "snmp", NULL);
+    gchar *netstat = g_build_filename (dir, "netstat", NULL);
+    SystemloadTcpStat tcp;
+
+    write_snmp (snmp, 17331, 12);
+    write_netstat (netstat, 4, 100);
+    SystemloadTcpSampler *sampler = systemload_tcp_sampler_new ();
+    sampler->snmp.file = systemload_procfile_open (snmp);
+    sampler->netstat.file = systemload_procfile_open (netstat);
+
+    /* The columns are looked up in the first reading */
+    systemload_procfile_begin_tick ();
+    guint64 counters[N_COUNTERS] = { 0 };
+    guint found = 0;
+    CHECK (table_read (sampler, &sampler->snmp, snmp, counters, &found));
+    CHECK (table_read (sampler, &sampler->netstat, netstat, counters, &found));
+    CHECK (sampler->column[COUNTER_OUT_SEGS] == 10 && sampler->column[COUNTER_RETRANS_SEGS] == 11);
+    CHECK (sampler->snmp.n_values == 12);
+    CHECK (sampler->column[COUNTER_LISTEN_OVERFLOWS] == 7 && sampler->column[COUNTER_TIMEOUTS] == 10);
+    CHECK (sampler->netstat.n_values == 11);
+
+    /* The '-' of MaxConn does not shift the columns after it */
+    CHECK (found == (1u << N_COUNTERS) - 1);
+    CHECK (counters[COUNTER_OUT_SEGS] == 17331 && counters[COUNTER_RETRANS_SEGS] == 12);
+    CHECK (counters[COUNTER_LISTEN_OVERFLOWS] == 4 && counters[COUNTER_TIMEOUTS] == 100);
+
+    CHECK (read_tcpstat (sampler, &tcp) == 0);
+    CHECK (tcp.out_segments == 0);
+
+    write_snmp (snmp, 18331, 22);
+    write_netstat (netstat, 6, 110);
+    CHECK (next_reading (sampler, &tcp) == 0);
+    CHECK (tcp.out_segments > 0 && tcp.retransmits > 0 && tcp.listen_overflows > 0 && tcp.timeouts > 0);
+
+    /* Without netstat, the overflows and timeouts have no rate, in this reading and the next one */
+    systemload_procfile_close (sampler->netstat.file);
+    sampler->netstat.file = systemload_procfile_open (dir);
+    write_snmp (snmp, 19331, 32);
+    CHECK (next_reading (sampler, &tcp) == 0);
+    CHECK (tcp.out_segments > 0 && tcp.listen_overflows == 0 && tcp.timeouts == 0);
+
+    systemload_procfile_close (sampler->netstat.file);
+    sampler->netstat.file = systemload_procfile_open (netstat);
+    write_netstat (netstat, 8, 120);
+    CHECK (next_reading (sampler, &tcp) == 0);
+    CHECK (tcp.listen_overflows == 0 && tcp.timeouts == 0);
+
+    write_netstat (netstat, 10, 130);
+    CHECK (next_reading (sampler, &tcp) == 0);
+    CHECK (tcp.listen_overflows > 0 && tcp.timeouts > 0);
+    systemload_tcp_sampler_free (sampler);
+
+    /* A kernel without TCPTimeouts */
+    write_file (netstat, "TcpExt: SyncookiesSent ListenOverflows ListenDrops\nTcpExt: 0 4 4\n");
+    sampler = systemload_tcp_sampler_new ();
+    sampler->netstat.file = systemload_procfile_open (netstat);
+    systemload_procfile_begin_tick ();
+    found = 0;
+    CHECK (table_read (sampler, &sampler->netstat, netstat, counters, &found));
+    CHECK (sampler->column[COUNTER_LISTEN_OVERFLOWS] == 1 && sampler->column[COUNTER_TIMEOUTS] == -1);
+    CHECK (found == 1u << COUNTER_LISTEN_OVERFLOWS && counters[COUNTER_LISTEN_OVERFLOWS] == 4);
+    systemload_tcp_sampler_free (sampler);
+
+    g_unlink (snmp);
+    g_unlink (netstat);
+    g_rmdir (dir);
+    g_free (snmp);
+    g_free (netstat);
+    g_free (dir);
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
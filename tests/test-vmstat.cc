@@ -0,0 +1,173 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Replays /proc/vmstat files to read_vmstat(): the index of the lines is rebuilt when a line
+ * moves or the file ends early, oom_kill may be missing, and the other counters may not.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <glib.h>
+
+#include "panel-plugin/procfile.h"
+#include "panel-plugin/vmstat.h"
+#include "tests/capture-writer.h"
+
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+enum {
+    WITHOUT_OOM_KILL = 1 << 0,
+    WITHOUT_PGSCAN_DIRECT = 1 << 1,
+    EXTRA_LINE = 1 << 2,    /* A kernel update added a counter before pgscan_kswapd */
+    CUT = 1 << 3,           /* The file ends before pgscan_kswapd */
+};
+
+/* A /proc/vmstat in the order of the kernel, every counter is n times its base value */
+static gchar *
+vmstat_text (guint n, guint flags)
+{
+    GString *text = g_string_new (NULL);
+    g_string_append (text, "nr_free_pages 123456\nnr_zone_inactive_anon 2000\npgpgin 5000\npgpgout 6000\n");
+    g_string_append_printf (text, "pswpin %u\npswpout %u\npgalloc_normal 77777\npgfault 99999\npgmajfault %u\n",
+                            10 * n, 20 * n, 30 * n);
+    g_string_append_printf (text, "pgsteal_kswapd %u\npgsteal_direct %u\npgsteal_khugepaged 0\n", 40 * n, 50 * n);
+    if (flags & CUT)
+        return g_string_free (text, FALSE);
+    if (flags & EXTRA_LINE)
+        g_string_append (text, "pgdemote_kswapd 0\n");
+    g_string_append_printf (text, "pgscan_kswapd %u\n", 60 * n);
+    if (!(flags & WITHOUT_PGSCAN_DIRECT))
+        g_string_append_printf (text, "pgscan_direct %u\n", 70 * n);
+    g_string_append (text, "pgscan_khugepaged 0\nslabs_scanned 0\n");
+    if (!(flags & WITHOUT_OOM_KILL))
+        g_string_append_printf (text, "oom_kill %u\n", n);
+    g_string_append (text, "numa_pte_updates 0\nthp_fault_alloc 12\n");
+    return g_string_free (text, FALSE);
+}
+
+static void
+add_tick (GString *capture, gint64 seconds, guint n, guint flags)
+{
+    gchar *text = vmstat_text (n, flags);
+    capture_writer_tick (capture, seconds * G_USEC_PER_SEC);
+    capture_writer_contents (capture, 0, text);
+    g_free (text);
+}
+
+static gint
+next_reading (SystemloadVmstatSampler *sampler, SystemloadVmstat *vmstat)
+{
+    systemload_procfile_begin_tick ();
+    return read_vmstat (sampler, vmstat);
+}
+
+int
+main (int argc, char **argv)
+{
+    GString *capture = g_string_new (NULL);
+    capture_writer_begin_session (capture);
+    capture_writer_path (capture, 0, "/proc/vmstat");
+    add_tick (capture, 1, 1, 0);
+    add_tick (capture, 2, 2, 0);
+    add_tick (capture, 3, 3, EXTRA_LINE);
+    add_tick (capture, 4, 4, EXTRA_LINE);
+    add_tick (capture, 5, 5, EXTRA_LINE);
+    add_tick (capture, 6, 6, CUT);
+    add_tick (capture, 7, 7, 0);
+
+    capture_writer_begin_session (capture);
+    capture_writer_path (capture, 0, "/proc/vmstat");
+    add_tick (capture, 1, 1, WITHOUT_OOM_KILL);
+    add_tick (capture, 2, 3, WITHOUT_OOM_KILL);
+
+    capture_writer_begin_session (capture);
+    capture_writer_path (capture, 0, "/proc/vmstat");
+    add_tick (capture, 1, 1, WITHOUT_PGSCAN_DIRECT);
+    add_tick (capture, 2, 2, WITHOUT_PGSCAN_DIRECT);
+    gchar *filename = capture_writer_replay (capture);
+    g_string_free (capture, TRUE);
+
+    SystemloadVmstatSampler *sampler = systemload_vmstat_sampler_new ();
+    SystemloadVmstat vmstat;
+
+    CHECK (next_reading (sampler, &vmstat) == 0);
+    CHECK (vmstat.rate[VMSTAT_PSWPIN] == 0 && vmstat.oom_kills == 1 && vmstat.page_size > 0);
+
+    CHECK (next_reading (sampler, &vmstat) == 0);
+    CHECK (vmstat.rate[VMSTAT_PSWPIN] == 10 && vmstat.rate[VMSTAT_PSWPOUT] == 20 && vmstat.rate[VMSTAT_PGMAJFAULT] == 30);
+    CHECK (vmstat.rate[VMSTAT_PGSTEAL_KSWAPD] == 40 && vmstat.rate[VMSTAT_PGSTEAL_DIRECT] == 50);
+    CHECK (vmstat.rate[VMSTAT_PGSCAN_KSWAPD] == 60 && vmstat.rate[VMSTAT_PGSCAN_DIRECT] == 70);
+    CHECK (vmstat.rate[VMSTAT_OOM_KILL] == 1 && vmstat.oom_kills == 2);
+
+    /* The moved lines invalidate the index, the next reading rebuilds it and has no rates */
+    CHECK (next_reading (sampler, &vmstat) == -1);
+    CHECK (next_reading (sampler, &vmstat) == 0);
+    CHECK (vmstat.rate[VMSTAT_PSWPIN] == 0 && vmstat.oom_kills == 4);
+    CHECK (next_reading (sampler, &vmstat) == 0);
+    CHECK (vmstat.rate[VMSTAT_PGSCAN_KSWAPD] == 60 && vmstat.rate[VMSTAT_PGSCAN_DIRECT] == 70);
+
+    /* So does a file which ends before the last indexed line */
+    CHECK (next_reading (sampler, &vmstat) == -1);
+    CHECK (next_reading (sampler, &vmstat) == 0);
+    CHECK (vmstat.rate[VMSTAT_PSWPIN] == 0 && vmstat.oom_kills == 7);
+    systemload_vmstat_sampler_free (sampler);
+
+    /* A kernel before 4.13 */
+    sampler = systemload_vmstat_sampler_new ();
+    CHECK (next_reading (sampler, &vmstat) == 0);
+    CHECK (next_reading (sampler, &vmstat) == 0);
+    CHECK (vmstat.rate[VMSTAT_PSWPIN] == 20 && vmstat.rate[VMSTAT_PGSCAN_DIRECT] == 140);
+    CHECK (vmstat.rate[VMSTAT_OOM_KILL] == 0 && vmstat.oom_kills == 0);
+    systemload_vmstat_sampler_free (sampler);
+
+    /* A required counter is missing */
+    sampler = systemload_vmstat_sampler_new ();
+    CHECK (next_reading (sampler, &vmstat) == -1);
+    CHECK (next_reading (sampler, &vmstat) == -1);
+    systemload_vmstat_sampler_free (sampler);
+
+    capture_writer_remove (filename);
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
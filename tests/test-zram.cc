@@ -0,0 +1,219 @@
+/*
+ * This file is part of Xfce (https://gitlab.xfce.org).
+ *
+ * Copyright (c) 2026 The Xfce development team
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Tests read_compressed_memory() and read_swap_devices() against fixtures of /proc/meminfo,
+ * /proc/swaps and the mm_stat files of zram devices in a temporary directory, which stands in
+ * for /sys/block. memswap.cc and zram.cc are included, so that the sampler of /proc/meminfo
+ * and /proc/swaps can be given the fixtures.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+static gchar *block_dir;
+#define SYSFS_BLOCK block_dir
+
+#include "panel-plugin/memswap.cc"
+#include "panel-plugin/zram.cc"
+
+static guint failures;
+
+#define CHECK(condition) \
+    G_STMT_START { \
+        if (!(condition)) \
+        { \
+            g_printerr ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } G_STMT_END
+
+#define KIB 1024
+
+static const gchar MEMINFO[] =
+    "MemTotal:       16000000 kB\n"
+    "MemFree:         4000000 kB\n"
+    "MemAvailable:    9000000 kB\n"
+    "SwapTotal:       8388604 kB\n"
+    "SwapFree:        8387580 kB\n"
+    "Zswap:              2048 kB\n"
+    "Zswapped:           8192 kB\n"
+    "Dirty:               300 kB\n";
+
+static const gchar MEMINFO_WITHOUT_ZSWAP[] =
+    "MemTotal:       16000000 kB\n"
+    "MemFree:         4000000 kB\n"
+    "SwapTotal:       8388604 kB\n"
+    "SwapFree:        8387580 kB\n"
+    "Dirty:               300 kB\n";
+
+/* The name of a disk-backed device, and names which are padded with spaces or not */
+static const gchar SWAPS[] =
+    "Filename\t\t\t\tType\t\tSize\t\tUsed\t\tPriority\n"
+    "/dev/zram0                              partition\t8388604\t\t1024\t\t100\n"
+    "/dev/nvme0n1p3                          partition\t16777212\t4096\t\t-2\n"
+    "/dev/zram12 partition\t1000\t10\t100\n";
+
+static void
+write_file (const gchar *path, const gchar *text)
+{
+    /* In place, as the file stays open in procfile.cc */
+    FILE *f = fopen (path, "w");
+    fputs (text, f);
+    fclose (f);
+}
+
+static gchar *
+add_device (const gchar *name, const gchar *mm_stat)
+{
+    gchar *dir = g_build_filename (block_dir, name, NULL);
+    g_mkdir (dir, 0700);
+    gchar *path = g_build_filename (dir, "mm_stat", NULL);
+    if (mm_stat)
+        write_file (path, mm_stat);
+    g_free (dir);
+    return path;
+}
+
+static void
+remove_device (const gchar *name)
+{
+    gchar *dir = g_build_filename (block_dir, name, NULL);
+    gchar *path = g_build_filename (dir, "mm_stat", NULL);
+    g_unlink (path);
+    g_rmdir (dir);
+    g_free (path);
+    g_free (dir);
+}
+
+static gint
+next_reading (SystemloadZramSampler *sampler, SystemloadMemSampler *mem_sampler, SystemloadCompressedMemory *compressed)
+{
+    systemload_procfile_begin_tick ();
+    return read_compressed_memory (sampler, mem_sampler, compressed);
+}
+
+static void
+test_swap_devices (const gchar *path)
+{
+    SystemloadMemSampler *mem_sampler = systemload_mem_sampler_new (NULL);
+    gulong total, used;
+
+    write_file (path, SWAPS);
+    mem_sampler->proc_swaps = systemload_procfile_open (path);
+    systemload_procfile_begin_tick ();
+    CHECK (read_swap_devices (mem_sampler, &total, &used) == 0);
+    CHECK (total == 8388604 + 1000 && used == 1024 + 10);
+
+    /* No swap space */
+    write_file (path, "Filename\t\t\t\tType\t\tSize\t\tUsed\t\tPriority\n");
+    systemload_procfile_begin_tick ();
+    CHECK (read_swap_devices (mem_sampler, &total, &used) == 0);
+    CHECK (total == 0 && used == 0);
+
+    systemload_mem_sampler_free (mem_sampler);
+}
+
+static void
+test_compressed_memory (const gchar *path)
+{
+    SystemloadMemSampler *mem_sampler = systemload_mem_sampler_new (NULL);
+    SystemloadZramSampler *sampler = systemload_zram_sampler_new ();
+    SystemloadCompressedMemory compressed;
+
+    write_file (path, MEMINFO);
+    mem_sampler->proc_meminfo = systemload_procfile_open (path);
+    g_free (add_device ("zram0", "  4096000  1024000  1200000        0  1300000      100        0        0        0\n"));
+    g_free (add_device ("zram1", "   512000   256000   300000        0   300000        0        0        0        0\n"));
+    g_free (add_device ("zram2", NULL));
+    g_free (add_device ("nvme0n1", NULL));
+
+    CHECK (next_reading (sampler, mem_sampler, &compressed) == 0);
+    CHECK (compressed.mem_total == (guint64) 16000000 * KIB);
+    CHECK (compressed.zswap && compressed.zswap_used == 2048 * KIB && compressed.zswap_stored == 8192 * KIB);
+    CHECK (compressed.n_zram == 2);
+    CHECK (compressed.zram_stored == 4096000 + 512000 && compressed.zram_used == 1200000 + 300000);
+
+    /* The files stay open, only a device which cannot be read has the directory listed again */
+    remove_device ("zram1");
+    g_free (add_device ("zram3", "     1000      500      700        0      700        0        0        0        0\n"));
+    CHECK (next_reading (sampler, mem_sampler, &compressed) == 0);
+    CHECK (compressed.n_zram == 2 && compressed.zram_stored == 4096000 + 512000);
+
+    gchar *zram0 = g_build_filename (block_dir, "zram0", "mm_stat", NULL);
+    write_file (zram0, "");
+    CHECK (next_reading (sampler, mem_sampler, &compressed) == 0);
+    CHECK (compressed.n_zram == 1 && compressed.zram_stored == 512000);
+    write_file (zram0, "  4096000  1024000  1200000        0  1300000      100        0        0        0\n");
+    g_free (zram0);
+    CHECK (next_reading (sampler, mem_sampler, &compressed) == 0);
+    CHECK (compressed.n_zram == 2 && compressed.zram_stored == 4096000 + 1000 && compressed.zram_used == 1200000 + 700);
+
+    write_file (path, MEMINFO_WITHOUT_ZSWAP);
+    CHECK (next_reading (sampler, mem_sampler, &compressed) == 0);
+    CHECK (compressed.mem_total == (guint64) 16000000 * KIB && !compressed.zswap && compressed.zswap_used == 0);
+
+    systemload_zram_sampler_free (sampler);
+    systemload_mem_sampler_free (mem_sampler);
+    remove_device ("zram0");
+    remove_device ("zram2");
+    remove_device ("zram3");
+    remove_device ("nvme0n1");
+}
+
+int
+main (int argc, char **argv)
+{
+    gchar *dir = g_dir_make_tmp ("systemload-zram-XXXXXX", NULL);
+    block_dir = g_build_filename (dir, "block", NULL);
+    g_mkdir (block_dir, 0700);
+    gchar *meminfo = g_build_filename (dir, "meminfo", NULL);
+    gchar *swaps = g_build_filename (dir, "swaps", NULL);
+
+    test_swap_devices (swaps);
+    test_compressed_memory (meminfo);
+
+    g_unlink (meminfo);
+    g_unlink (swaps);
+    g_rmdir (block_dir);
+    g_rmdir (dir);
+    g_free (meminfo);
+    g_free (swaps);
+    g_free (block_dir);
+    g_free (dir);
+
+    printf ("%s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}